@@ -0,0 +1,1675 @@
+/*
+ * This file is part of VLE, a framework for multi-modeling, simulation
+ * and analysis of complex dynamical systems.
+ * http://www.vle-project.org
+ *
+ * Copyright (c) 2003-2017 Gauthier Quesnel <gauthier.quesnel@inra.fr>
+ * Copyright (c) 2003-2017 ULCO http://www.univ-littoral.fr
+ * Copyright (c) 2007-2017 INRA http://www.inra.fr
+ *
+ * See the AUTHORS or Authors.txt file for copyright owners and
+ * contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <dirent.h>
+#include <fstream>
+#include <functional>
+#include <getopt.h>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <new>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <vector>
+#include <vle/devs/Dynamics.hpp>
+#include <vle/devs/DynamicsDbg.hpp>
+#include <vle/devs/Executive.hpp>
+#include <vle/manager/Manager.hpp>
+#include <vle/manager/Simulation.hpp>
+#include <vle/translator/GraphTranslator.hpp>
+#include <vle/utils/Context.hpp>
+#include <vle/utils/Exception.hpp>
+#include <vle/utils/Filesystem.hpp>
+#include <vle/value/Binary.hpp>
+#include <vle/value/Boolean.hpp>
+#include <vle/value/Double.hpp>
+#include <vle/value/Integer.hpp>
+#include <vle/value/Map.hpp>
+#include <vle/value/Matrix.hpp>
+#include <vle/value/Null.hpp>
+#include <vle/value/Set.hpp>
+#include <vle/value/String.hpp>
+#include <vle/value/Tuple.hpp>
+#include <vle/vle.hpp>
+#include <vle/vpz/Vpz.hpp>
+
+#ifdef VLE_HAVE_NLS
+#ifndef ENABLE_NLS
+#define ENABLE_NLS
+#endif
+#include <libintl.h>
+#include <locale.h>
+#define _(x) gettext(x)
+#define gettext_noop(x) x
+#define N_(x) gettext_noop(x)
+#else
+#define _(x) x
+#define N_(x) x
+#endif
+
+#ifndef VLE_BENCH_BUILD_TYPE
+#define VLE_BENCH_BUILD_TYPE ""
+#endif
+
+//
+// The global operator new of the process is replaced to count the
+// allocations of the library, the plug-ins and the benchmark itself.
+//
+
+static std::atomic<std::uint64_t> allocation_count{ 0 };
+
+void*
+operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+//
+// The models of the workloads are built into the executable. The
+// dynamics with an empty package are loaded from the global symbols of
+// the process.
+//
+
+#define DECLARE_BENCH_DYNAMICS(symbol_, model_)                               \
+    extern "C" {                                                              \
+    VLE_MODULE vle::devs::Dynamics* symbol_(                                  \
+      const vle::devs::DynamicsInit& init,                                    \
+      const vle::devs::InitEventList& events)                                 \
+    {                                                                         \
+        return new model_(init, events);                                      \
+    }                                                                         \
+    }
+
+#define DECLARE_BENCH_EXECUTIVE(symbol_, model_)                              \
+    extern "C" {                                                              \
+    VLE_MODULE vle::devs::Dynamics* symbol_(                                  \
+      const vle::devs::ExecutiveInit& init,                                   \
+      const vle::devs::InitEventList& events)                                 \
+    {                                                                         \
+        return new model_(init, events);                                      \
+    }                                                                         \
+    }
+
+namespace bench {
+
+/**
+ * Send a value::Double on the "out" port every "period" (1 by default).
+ */
+class Generator : public vle::devs::Dynamics
+{
+public:
+    Generator(const vle::devs::DynamicsInit& init,
+              const vle::devs::InitEventList& events)
+      : vle::devs::Dynamics(init, events)
+      , m_period(events.exist("period")
+                   ? vle::value::toDouble(events.get("period"))
+                   : 1.0)
+      , m_count(0)
+    {
+    }
+
+    vle::devs::Time init(vle::devs::Time /*time*/) override
+    {
+        m_count = 0;
+        return 0.0;
+    }
+
+    void output(vle::devs::Time /*time*/,
+                vle::devs::ExternalEventList& output) const override
+    {
+        output.emplace_back("out");
+        output.back().addDouble(m_count);
+    }
+
+    vle::devs::Time timeAdvance() const override
+    {
+        return m_period;
+    }
+
+    void internalTransition(vle::devs::Time /*time*/) override
+    {
+        ++m_count;
+    }
+
+    std::unique_ptr<vle::value::Value> observation(
+      const vle::devs::ObservationEvent& /*event*/) const override
+    {
+        return vle::value::Double::create(m_count);
+    }
+
+private:
+    double m_period;
+    double m_count;
+};
+
+/**
+ * Count the received events.
+ */
+class Counter : public vle::devs::Dynamics
+{
+public:
+    Counter(const vle::devs::DynamicsInit& init,
+            const vle::devs::InitEventList& events)
+      : vle::devs::Dynamics(init, events)
+      , m_count(0)
+    {
+    }
+
+    vle::devs::Time init(vle::devs::Time /*time*/) override
+    {
+        m_count = 0;
+        return vle::devs::infinity;
+    }
+
+    void externalTransition(const vle::devs::ExternalEventList& events,
+                            vle::devs::Time /*time*/) override
+    {
+        m_count += events.size();
+    }
+
+    std::unique_ptr<vle::value::Value> observation(
+      const vle::devs::ObservationEvent& /*event*/) const override
+    {
+        return vle::value::Double::create(m_count);
+    }
+
+private:
+    double m_count;
+};
+
+/**
+ * Every time unit, build a generator connected to the "sink" model and
+ * delete the oldest generator when more than "window" generators exist.
+ */
+class Churn : public vle::devs::Executive
+{
+public:
+    Churn(const vle::devs::ExecutiveInit& init,
+          const vle::devs::InitEventList& events)
+      : vle::devs::Executive(init, events)
+      , m_window(events.exist("window")
+                   ? vle::value::toInteger(events.get("window"))
+                   : 100)
+      , m_id(0)
+    {
+    }
+
+    vle::devs::Time init(vle::devs::Time /*time*/) override
+    {
+        return 0.0;
+    }
+
+    vle::devs::Time timeAdvance() const override
+    {
+        return 1.0;
+    }
+
+    void internalTransition(vle::devs::Time /*time*/) override
+    {
+        std::string name = "m" + std::to_string(m_id++);
+
+        createModel(name, {}, { "out" }, "generator");
+        addConnection(name, "out", "sink", "in");
+        m_names.emplace_back(name);
+
+        if (m_names.size() > static_cast<std::size_t>(m_window)) {
+            delModel(m_names.front());
+            m_names.pop_front();
+        }
+    }
+
+private:
+    std::deque<std::string> m_names;
+    int m_window;
+    long m_id;
+};
+
+/**
+ * Build at initialization a small world graph of "nodes" models of the
+ * class "node", each connected to its "k" nearest neighbours, with the
+ * vle::translator::graph_generator.
+ */
+class Graph : public vle::devs::Executive
+{
+public:
+    Graph(const vle::devs::ExecutiveInit& init,
+          const vle::devs::InitEventList& events)
+      : vle::devs::Executive(init, events)
+      , m_nodes(vle::value::toInteger(events.get("nodes")))
+      , m_k(vle::value::toInteger(events.get("k")))
+    {
+    }
+
+    vle::devs::Time init(vle::devs::Time /*time*/) override
+    {
+        vle::translator::graph_generator generator(
+          { [](const vle::translator::graph_generator::node_metrics& metrics,
+               std::string& name,
+               std::string& classname) {
+                name = "n" + std::to_string(metrics.id);
+                classname = "node";
+            },
+            vle::translator::graph_generator::connectivity::IN_OUT,
+            false });
+
+        std::mt19937 gen(123);
+        generator.make_smallworld(*this, gen, m_nodes, m_k, 0.05, false);
+
+        return vle::devs::infinity;
+    }
+
+private:
+    int m_nodes;
+    int m_k;
+};
+}
+
+DECLARE_BENCH_DYNAMICS(bench_generator, bench::Generator)
+DECLARE_BENCH_DYNAMICS(bench_counter, bench::Counter)
+DECLARE_BENCH_EXECUTIVE(exe_bench_churn, bench::Churn)
+DECLARE_BENCH_EXECUTIVE(exe_bench_graph, bench::Graph)
+
+namespace bench {
+
+//
+// Build the VPZ of the workloads.
+//
+
+static void
+write_atomic(std::ostream& os,
+             const std::string& name,
+             const std::string& dynamics,
+             bool input,
+             bool output,
+             const std::string& conditions = {},
+             const std::string& observables = {})
+{
+    os << "<model name=\"" << name << "\" type=\"atomic\" dynamics=\""
+       << dynamics << "\"";
+    if (not conditions.empty())
+        os << " conditions=\"" << conditions << "\"";
+    if (not observables.empty())
+        os << " observables=\"" << observables << "\"";
+    os << ">\n";
+    if (input)
+        os << "<in><port name=\"in\" /></in>\n";
+    if (output)
+        os << "<out><port name=\"out\" /></out>\n";
+    os << "</model>\n";
+}
+
+static void
+write_connection(std::ostream& os,
+                 const char* type,
+                 const std::string& origin,
+                 const std::string& origin_port,
+                 const std::string& destination,
+                 const std::string& destination_port)
+{
+    os << "<connection type=\"" << type << "\">\n"
+       << "<origin model=\"" << origin << "\" port=\"" << origin_port
+       << "\" />\n"
+       << "<destination model=\"" << destination << "\" port=\""
+       << destination_port << "\" />\n"
+       << "</connection>\n";
+}
+
+static std::string
+make_vpz(const std::string& name,
+         const std::string& submodels,
+         const std::string& connections,
+         double duration,
+         const std::string& conditions = {},
+         const std::string& views = {},
+         const std::string& classes = {},
+         const std::string& dynamics = {})
+{
+    std::ostringstream os;
+
+    os << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n"
+       << "<!DOCTYPE vle_project PUBLIC \"-//VLE TEAM//DTD Strict//EN\" "
+       << "\"http://www.vle-project.org/vle-2.0.dtd\">\n"
+       << "<vle_project version=\"2.0\" date=\"\" author=\"vle-bench\">\n"
+       << "<structures>\n"
+       << "<model name=\"top\" type=\"coupled\">\n"
+       << "<submodels>\n"
+       << submodels << "</submodels>\n"
+       << "<connections>\n"
+       << connections << "</connections>\n"
+       << "</model>\n"
+       << "</structures>\n"
+       << "<dynamics>\n"
+       << "<dynamic name=\"generator\" package=\"\" "
+       << "library=\"bench_generator\" />\n"
+       << "<dynamic name=\"counter\" package=\"\" "
+       << "library=\"bench_counter\" />\n"
+       << "<dynamic name=\"churn\" package=\"\" "
+       << "library=\"exe_bench_churn\" />\n"
+       << "<dynamic name=\"graph\" package=\"\" "
+       << "library=\"exe_bench_graph\" />\n"
+       << dynamics << "</dynamics>\n"
+       << "<classes>\n"
+       << classes << "</classes>\n"
+       << "<experiment name=\"" << name << "\" seed=\"123\">\n"
+       << "<conditions>\n"
+       << "<condition name=\"simulation_engine\">\n"
+       << "<port name=\"begin\"><double>0.0</double></port>\n"
+       << "<port name=\"duration\"><double>" << duration
+       << "</double></port>\n"
+       << "</condition>\n"
+       << conditions << "</conditions>\n"
+       << views << "</experiment>\n"
+       << "</vle_project>\n";
+
+    return os.str();
+}
+
+/* N unconnected generators. */
+static std::string
+make_generators(int models, double duration)
+{
+    std::ostringstream submodels;
+
+    for (int i = 0; i != models; ++i)
+        write_atomic(submodels, "g" + std::to_string(i), "generator", false,
+                     true);
+
+    return make_vpz("generators", submodels.str(), {}, duration);
+}
+
+static void
+write_hierarchy(std::ostream& os,
+                const std::string& name,
+                int depth,
+                int fanout)
+{
+    if (depth == 0) {
+        write_atomic(os, name, "counter", true, false);
+        return;
+    }
+
+    os << "<model name=\"" << name << "\" type=\"coupled\">\n"
+       << "<in><port name=\"in\" /></in>\n"
+       << "<submodels>\n";
+
+    for (int i = 0; i != fanout; ++i)
+        write_hierarchy(os, "c" + std::to_string(i), depth - 1, fanout);
+
+    os << "</submodels>\n"
+       << "<connections>\n";
+
+    for (int i = 0; i != fanout; ++i)
+        write_connection(
+          os, "input", name, "in", "c" + std::to_string(i), "in");
+
+    os << "</connections>\n"
+       << "</model>\n";
+}
+
+/* A generator connected to fanout^depth counters through coupled models. */
+static std::string
+make_hierarchy(int depth, int fanout, double duration)
+{
+    std::ostringstream submodels, connections;
+
+    write_atomic(submodels, "gen", "generator", false, true);
+    write_hierarchy(submodels, "tree", depth, fanout);
+    write_connection(connections, "internal", "gen", "out", "tree", "in");
+
+    return make_vpz(
+      "hierarchy", submodels.str(), connections.str(), duration);
+}
+
+/* An executive which builds and deletes generators. */
+static std::string
+make_churn(int window, double duration)
+{
+    std::ostringstream submodels;
+
+    write_atomic(submodels, "sink", "counter", true, false);
+    write_atomic(submodels, "executive", "churn", false, false, "churn");
+
+    std::string conditions = "<condition name=\"churn\">\n"
+                             "<port name=\"window\"><integer>" +
+                             std::to_string(window) +
+                             "</integer></port>\n"
+                             "</condition>\n";
+
+    return make_vpz("churn", submodels.str(), {}, duration, conditions);
+}
+
+/* An executive which builds a small world graph of generators. */
+static std::string
+make_graph(int nodes, int k, double duration)
+{
+    std::ostringstream submodels, classes;
+
+    write_atomic(submodels, "executive", "graph", false, false, "graph");
+
+    classes << "<class name=\"node\">\n";
+    write_atomic(classes, "node", "generator", true, true);
+    classes << "</class>\n";
+
+    std::string conditions = "<condition name=\"graph\">\n"
+                             "<port name=\"nodes\"><integer>" +
+                             std::to_string(nodes) +
+                             "</integer></port>\n"
+                             "<port name=\"k\"><integer>" +
+                             std::to_string(k) +
+                             "</integer></port>\n"
+                             "</condition>\n";
+
+    return make_vpz(
+      "graph", submodels.str(), {}, duration, conditions, {}, classes.str());
+}
+
+/* N generators observed by a timed view of the vle.output plug-in. */
+static std::string
+make_observed(const std::string& plugin,
+              const std::string& location,
+              int models,
+              double duration)
+{
+    std::ostringstream submodels, views;
+
+    for (int i = 0; i != models; ++i)
+        write_atomic(submodels,
+                     "g" + std::to_string(i),
+                     "generator",
+                     false,
+                     true,
+                     {},
+                     "obs");
+
+    views << "<views>\n"
+          << "<outputs>\n"
+          << "<output name=\"o\" location=\"" << location
+          << "\" format=\"local\" package=\"vle.output\" plugin=\"" << plugin
+          << "\" />\n"
+          << "</outputs>\n"
+          << "<observables>\n"
+          << "<observable name=\"obs\">\n"
+          << "<port name=\"value\"><attachedview name=\"view\" /></port>\n"
+          << "</observable>\n"
+          << "</observables>\n"
+          << "<view name=\"view\" output=\"o\" type=\"timed\" "
+          << "timestep=\"1.0\" />\n"
+          << "</views>\n";
+
+    return make_vpz(
+      plugin, submodels.str(), {}, duration, {}, views.str());
+}
+
+/* A generator and a condition with @e combinations periods. */
+static std::string
+make_plan(int combinations, double duration)
+{
+    std::ostringstream submodels, conditions;
+
+    write_atomic(submodels, "gen", "generator", false, true, "plan");
+
+    conditions << "<condition name=\"plan\">\n<port name=\"period\">\n";
+    for (int i = 0; i != combinations; ++i)
+        conditions << "<double>" << 1 + (i % 10) * 0.1 << "</double>\n";
+    conditions << "</port>\n</condition>\n";
+
+    return make_vpz(
+      "plan", submodels.str(), {}, duration, conditions.str());
+}
+
+static const char* qss_dynamics =
+  "<dynamic name=\"qss_generator\" package=\"vle.adaptative-qss\" "
+  "library=\"Generator\" />\n"
+  "<dynamic name=\"qss_integrator\" package=\"vle.adaptative-qss\" "
+  "library=\"Integrator\" />\n"
+  "<dynamic name=\"qss_quantifier\" package=\"vle.adaptative-qss\" "
+  "library=\"AdaptativeQuantifier\" />\n"
+  "<dynamic name=\"qss_adder\" package=\"vle.adaptative-qss\" "
+  "library=\"Adder\" />\n"
+  "<dynamic name=\"qss_system\" package=\"vle.adaptative-qss\" "
+  "library=\"QssSystem\" />\n";
+
+/*
+ * The chain of integrators of the vle.adaptative-qss package:
+ * dx1/dt = 1 - x1 and dxi/dt = x(i-1) - xi, with a Generator, and an
+ * Integrator, an AdaptativeQuantifier and an Adder per variable.
+ */
+static std::string
+make_qss_network(int variables, double duration)
+{
+    std::ostringstream submodels, connections;
+
+    submodels << "<model name=\"G\" type=\"atomic\" "
+              << "dynamics=\"qss_generator\">\n"
+              << "<out><port name=\"out\" /></out>\n"
+              << "</model>\n";
+
+    for (int i = 1; i <= variables; ++i) {
+        auto id = std::to_string(i);
+
+        submodels << "<model name=\"I" << id << "\" type=\"atomic\" "
+                  << "dynamics=\"qss_integrator\" conditions=\"integrator\">\n"
+                  << "<in><port name=\"X_dot\" /><port name=\"Quanta\" />"
+                  << "</in>\n"
+                  << "<out><port name=\"I_out\" /></out>\n"
+                  << "</model>\n"
+                  << "<model name=\"Q" << id << "\" type=\"atomic\" "
+                  << "dynamics=\"qss_quantifier\" conditions=\"quantum\">\n"
+                  << "<in><port name=\"in\" /></in>\n"
+                  << "<out><port name=\"out\" /></out>\n"
+                  << "</model>\n"
+                  << "<model name=\"A" << id << "\" type=\"atomic\" "
+                  << "dynamics=\"qss_adder\" conditions=\"adder\">\n"
+                  << "<in><port name=\"prev\" /><port name=\"self\" /></in>\n"
+                  << "<out><port name=\"out\" /></out>\n"
+                  << "</model>\n";
+
+        write_connection(
+          connections, "internal", "I" + id, "I_out", "Q" + id, "in");
+        write_connection(
+          connections, "internal", "Q" + id, "out", "I" + id, "Quanta");
+        write_connection(connections,
+                         "internal",
+                         i == 1 ? "G" : "I" + std::to_string(i - 1),
+                         i == 1 ? "out" : "I_out",
+                         "A" + id,
+                         "prev");
+        write_connection(
+          connections, "internal", "I" + id, "I_out", "A" + id, "self");
+        write_connection(
+          connections, "internal", "A" + id, "out", "I" + id, "X_dot");
+    }
+
+    std::string conditions =
+      "<condition name=\"integrator\">\n"
+      "<port name=\"X_0\"><double>0.0</double></port>\n"
+      "</condition>\n"
+      "<condition name=\"quantum\">\n"
+      "<port name=\"quantum\"><double>0.001</double></port>\n"
+      "<port name=\"allow_offsets\"><boolean>false</boolean></port>\n"
+      "</condition>\n"
+      "<condition name=\"adder\">\n"
+      "<port name=\"weights\"><map>\n"
+      "<key name=\"prev\"><double>1.0</double></key>\n"
+      "<key name=\"self\"><double>-1.0</double></key>\n"
+      "</map></port>\n"
+      "</condition>\n";
+
+    return make_vpz("qss-chain-network",
+                    submodels.str(),
+                    connections.str(),
+                    duration,
+                    conditions,
+                    {},
+                    {},
+                    qss_dynamics);
+}
+
+/*
+ * The same chain of integrators in one QssSystem model, the Generator
+ * sets the constant of x1 through the input port x1.
+ */
+static std::string
+make_qss_system(int variables, double duration)
+{
+    std::ostringstream submodels, connections, conditions;
+
+    submodels << "<model name=\"G\" type=\"atomic\" "
+              << "dynamics=\"qss_generator\">\n"
+              << "<out><port name=\"out\" /></out>\n"
+              << "</model>\n"
+              << "<model name=\"system\" type=\"atomic\" "
+              << "dynamics=\"qss_system\" conditions=\"system\">\n"
+              << "<in><port name=\"x1\" /></in>\n"
+              << "</model>\n";
+
+    write_connection(connections, "internal", "G", "out", "system", "x1");
+
+    conditions << "<condition name=\"system\">\n"
+               << "<port name=\"variables\"><set>\n";
+    for (int i = 1; i <= variables; ++i)
+        conditions << "<string>x" << i << "</string>\n";
+    conditions << "</set></port>\n"
+               << "<port name=\"quantum\"><double>0.001</double></port>\n"
+               << "<port name=\"allow_offsets\"><boolean>false</boolean>"
+               << "</port>\n"
+               << "<port name=\"weights\"><map>\n";
+    for (int i = 1; i <= variables; ++i) {
+        conditions << "<key name=\"x" << i << "\"><map>\n";
+        if (i > 1)
+            conditions << "<key name=\"x" << i - 1
+                       << "\"><double>1.0</double></key>\n";
+        conditions << "<key name=\"x" << i
+                   << "\"><double>-1.0</double></key>\n"
+                   << "</map></key>\n";
+    }
+    conditions << "</map></port>\n"
+               << "</condition>\n";
+
+    return make_vpz("qss-chain-system",
+                    submodels.str(),
+                    connections.str(),
+                    duration,
+                    conditions.str(),
+                    {},
+                    {},
+                    qss_dynamics);
+}
+
+static std::unique_ptr<vle::value::Map>
+make_value_tree(int keys)
+{
+    auto map = std::make_unique<vle::value::Map>();
+
+    for (int i = 0; i != keys; ++i) {
+        auto& elem = map->addMap("k" + std::to_string(i));
+        elem.addDouble("double", i);
+        elem.addString("string", "value " + std::to_string(i));
+        elem.addTuple("tuple", 16, i);
+
+        auto& set = elem.addSet("set");
+        for (int j = 0; j != 4; ++j)
+            set.addInt(i + j);
+    }
+
+    return map;
+}
+
+//
+// Measures.
+//
+
+struct Counts
+{
+    double events = 0; ///< Transitions or operations of one run.
+    double bags = 0;   ///< Bags of one run (simulations only).
+};
+
+struct Workload
+{
+    std::string name;
+    std::function<Counts()> prepare; ///< Not measured.
+    std::function<void()> run;       ///< Measured.
+};
+
+struct Measure
+{
+    std::string name;
+    Counts counts;
+    double seconds = 0;
+    std::uint64_t allocations = 0;
+    long peak_rss_kb = 0;
+};
+
+/* Reset the peak resident set size of the process (Linux >= 4.0). */
+static void
+reset_peak_rss()
+{
+    std::ofstream ofs("/proc/self/clear_refs");
+    if (ofs)
+        ofs << "5";
+}
+
+static long
+read_peak_rss()
+{
+    std::ifstream ifs("/proc/self/status");
+    std::string line;
+
+    while (std::getline(ifs, line))
+        if (line.compare(0, 6, "VmHWM:") == 0)
+            return std::strtol(line.c_str() + 6, nullptr, 10);
+
+    struct rusage usage;
+    if (::getrusage(RUSAGE_SELF, &usage) == 0)
+        return usage.ru_maxrss;
+
+    return 0;
+}
+
+static Measure
+measure(const Workload& workload, int repeat)
+{
+    Measure result;
+    result.name = workload.name;
+    result.counts = workload.prepare();
+    result.seconds = std::numeric_limits<double>::infinity();
+
+    for (int i = 0; i != repeat; ++i) {
+        reset_peak_rss();
+
+        auto allocations = allocation_count.load();
+        auto start = std::chrono::steady_clock::now();
+
+        workload.run();
+
+        auto end = std::chrono::steady_clock::now();
+
+        if (i == 0)
+            result.allocations = allocation_count.load() - allocations;
+
+        result.seconds = std::min(
+          result.seconds, std::chrono::duration<double>(end - start).count());
+        result.peak_rss_kb = std::max(result.peak_rss_kb, read_peak_rss());
+    }
+
+    return result;
+}
+
+static void
+check(const vle::manager::Error& error)
+{
+    if (error.code)
+        throw vle::utils::InternalError(error.message);
+}
+
+/*
+ * Run the simulation once with the profiler to count the transitions and
+ * the bags, then build the measured function.
+ */
+static Workload
+simulation_workload(vle::utils::ContextPtr ctx,
+                    const std::string& name,
+                    const std::string& xml)
+{
+    auto vpz = std::make_shared<vle::vpz::Vpz>();
+    vpz->parseMemory(xml);
+
+    Workload workload;
+    workload.name = name;
+
+    workload.prepare = [ctx, vpz]() {
+        vle::manager::Simulation sim(ctx,
+                                     vle::manager::LOG_NONE,
+                                     vle::manager::SIMULATION_PROFILE,
+                                     std::chrono::milliseconds(0),
+                                     nullptr);
+        vle::manager::Error error;
+        sim.run(std::make_unique<vle::vpz::Vpz>(*vpz), &error);
+        check(error);
+
+        Counts counts;
+        auto profile = sim.profile();
+        if (profile) {
+            counts.bags = profile->getMap("kernel").getDouble("bags");
+
+            for (const auto& model : profile->getMap("models")) {
+                const auto& map = model.second->toMap();
+                counts.events += map.getDouble("internal-count") +
+                                 map.getDouble("external-count") +
+                                 map.getDouble("confluent-count");
+            }
+        }
+
+        return counts;
+    };
+
+    workload.run = [ctx, vpz]() {
+        vle::manager::Simulation sim(ctx,
+                                     vle::manager::LOG_NONE,
+                                     vle::manager::SIMULATION_NONE,
+                                     std::chrono::milliseconds(0),
+                                     nullptr);
+        vle::manager::Error error;
+        sim.run(std::make_unique<vle::vpz::Vpz>(*vpz), &error);
+        check(error);
+    };
+
+    return workload;
+}
+
+static Workload
+vpz_workload(const std::string& xml, int iterations)
+{
+    Workload workload;
+    workload.name = "vpz-parse-write";
+
+    workload.prepare = [iterations]() {
+        Counts counts;
+        counts.events = iterations;
+        return counts;
+    };
+
+    workload.run = [xml, iterations]() {
+        for (int i = 0; i != iterations; ++i) {
+            vle::vpz::Vpz vpz;
+            vpz.parseMemory(xml);
+
+            std::ostringstream os;
+            vpz.write(os);
+        }
+    };
+
+    return workload;
+}
+
+static Workload
+value_workload(int keys, int iterations)
+{
+    std::shared_ptr<vle::value::Map> tree = make_value_tree(keys);
+
+    Workload workload;
+    workload.name = "value-clone-serialise";
+
+    /* A clone, a binary round trip and an XML write per iteration. */
+    workload.prepare = [iterations]() {
+        Counts counts;
+        counts.events = iterations * 3.0;
+        return counts;
+    };
+
+    workload.run = [tree, iterations]() {
+        for (int i = 0; i != iterations; ++i) {
+            auto clone = tree->clone();
+            auto copy = vle::value::fromBinary(vle::value::toBinary(*clone));
+
+            std::ostringstream os;
+            copy->writeXml(os);
+        }
+    };
+
+    return workload;
+}
+
+/* The small maps sent in the events: three keys built and read back. */
+static Workload
+small_map_workload(int iterations)
+{
+    Workload workload;
+    workload.name = "value-small-map";
+
+    workload.prepare = [iterations]() {
+        Counts counts;
+        counts.events = iterations;
+        return counts;
+    };
+
+    workload.run = [iterations]() {
+        double sum = 0.0;
+
+        for (int i = 0; i != iterations; ++i) {
+            vle::value::Map map;
+            map.addDouble("d_val", i);
+            map.addDouble("up", i + 1.0);
+            map.addDouble("down", i - 1.0);
+            sum += map.getDouble("d_val") + map.getDouble("up") -
+                   map.getDouble("down");
+        }
+
+        if (sum < 0.0)
+            throw vle::utils::InternalError("value-small-map: bad sum");
+    };
+
+    return workload;
+}
+
+/* A large tuple and a set of strings: the binary and the XML round
+ * trips of the same value. */
+static std::shared_ptr<vle::value::Map>
+make_serialise_tree()
+{
+    auto map = std::make_shared<vle::value::Map>();
+    auto& tuple = map->addTuple("tuple", 100000, 0.0);
+    for (std::size_t i = 0; i != tuple.size(); ++i)
+        tuple.value()[i] = i * 0.001;
+
+    auto& set = map->addSet("set");
+    for (int i = 0; i != 1000; ++i)
+        set.addString(std::to_string(i));
+
+    return map;
+}
+
+static Workload
+serialise_workload(bool binary, int iterations)
+{
+    std::shared_ptr<vle::value::Map> tree = make_serialise_tree();
+
+    Workload workload;
+    workload.name = binary ? "value-binary" : "value-xml";
+
+    workload.prepare = [iterations]() {
+        Counts counts;
+        counts.events = iterations;
+        return counts;
+    };
+
+    workload.run = [tree, binary, iterations]() {
+        for (int i = 0; i != iterations; ++i) {
+            std::shared_ptr<vle::value::Value> read;
+            if (binary)
+                read = vle::value::fromBinary(vle::value::toBinary(*tree));
+            else
+                read = vle::vpz::Vpz::parseValue(tree->writeToXml());
+
+            if (not read->isMap())
+                throw vle::utils::InternalError("serialise: bad value");
+        }
+    };
+
+    return workload;
+}
+
+static Workload
+manager_workload(vle::utils::ContextPtr ctx,
+                 const std::string& xml,
+                 int combinations,
+                 int threads)
+{
+    auto vpz = std::make_shared<vle::vpz::Vpz>();
+    vpz->parseMemory(xml);
+
+    Workload workload;
+    workload.name = "manager-plan";
+
+    workload.prepare = [combinations]() {
+        Counts counts;
+        counts.events = combinations;
+        return counts;
+    };
+
+    workload.run = [ctx, vpz, threads]() {
+        vle::manager::Manager manager(ctx,
+                                      vle::manager::LOG_NONE,
+                                      vle::manager::SIMULATION_NO_RETURN,
+                                      nullptr);
+        vle::manager::Error error;
+        manager.run(
+          std::make_unique<vle::vpz::Vpz>(*vpz), threads, 0, 1, &error);
+        check(error);
+    };
+
+    return workload;
+}
+
+//
+// JSON report.
+//
+
+static void
+write_json_string(std::ostream& os, const std::string& str)
+{
+    os << '"';
+    for (auto c : str) {
+        if (c == '"' or c == '\\')
+            os << '\\' << c;
+        else if (static_cast<unsigned char>(c) >= 0x20)
+            os << c;
+    }
+    os << '"';
+}
+
+static void
+write_json(std::ostream& os, const vle::value::Value& value, int indent)
+{
+    switch (value.getType()) {
+    case vle::value::Value::BOOLEAN:
+        os << (value.toBoolean().value() ? "true" : "false");
+        break;
+    case vle::value::Value::INTEGER:
+        os << value.toInteger().value();
+        break;
+    case vle::value::Value::DOUBLE:
+        os << value.toDouble().value();
+        break;
+    case vle::value::Value::STRING:
+        write_json_string(os, value.toString().value());
+        break;
+    case vle::value::Value::MAP: {
+        const auto& map = value.toMap();
+        std::string pad(indent + 2, ' ');
+        bool first = true;
+
+        os << '{';
+        for (const auto& elem : map) {
+            os << (first ? "\n" : ",\n") << pad;
+            write_json_string(os, elem.first);
+            os << ": ";
+            write_json(os, *elem.second, indent + 2);
+            first = false;
+        }
+        os << '\n' << std::string(indent, ' ') << '}';
+    } break;
+    default:
+        os << "null";
+        break;
+    }
+}
+
+/*
+ * Read the subset of JSON written by write_json: objects, strings,
+ * numbers, booleans and null.
+ */
+class JsonReader
+{
+public:
+    explicit JsonReader(const std::string& buffer)
+      : m_buffer(buffer)
+      , m_pos(0)
+    {
+    }
+
+    std::unique_ptr<vle::value::Value> read()
+    {
+        auto value = readValue();
+        skip();
+
+        if (m_pos != m_buffer.size())
+            error();
+
+        return value;
+    }
+
+private:
+    const std::string& m_buffer;
+    std::size_t m_pos;
+
+    [[noreturn]] void error() const
+    {
+        throw vle::utils::ArgError("JSON: parse error at offset %zu", m_pos);
+    }
+
+    void skip()
+    {
+        while (m_pos < m_buffer.size() and
+               std::isspace(static_cast<unsigned char>(m_buffer[m_pos])))
+            ++m_pos;
+    }
+
+    bool accept(char c)
+    {
+        skip();
+
+        if (m_pos < m_buffer.size() and m_buffer[m_pos] == c) {
+            ++m_pos;
+            return true;
+        }
+
+        return false;
+    }
+
+    void expect(char c)
+    {
+        if (not accept(c))
+            error();
+    }
+
+    bool acceptWord(const char* word)
+    {
+        auto length = std::strlen(word);
+
+        if (m_buffer.compare(m_pos, length, word) == 0) {
+            m_pos += length;
+            return true;
+        }
+
+        return false;
+    }
+
+    std::string readString()
+    {
+        expect('"');
+        std::string result;
+
+        while (m_pos < m_buffer.size() and m_buffer[m_pos] != '"') {
+            if (m_buffer[m_pos] == '\\')
+                ++m_pos;
+
+            if (m_pos < m_buffer.size())
+                result += m_buffer[m_pos++];
+        }
+
+        expect('"');
+        return result;
+    }
+
+    std::unique_ptr<vle::value::Value> readValue()
+    {
+        skip();
+
+        if (m_pos >= m_buffer.size())
+            error();
+
+        if (m_buffer[m_pos] == '{') {
+            ++m_pos;
+            auto map = std::make_unique<vle::value::Map>();
+
+            if (accept('}'))
+                return std::move(map);
+
+            do {
+                skip();
+                auto key = readString();
+                expect(':');
+                map->add(key, readValue());
+            } while (accept(','));
+
+            expect('}');
+            return std::move(map);
+        }
+
+        if (m_buffer[m_pos] == '"')
+            return vle::value::String::create(readString());
+
+        if (acceptWord("true"))
+            return vle::value::Boolean::create(true);
+
+        if (acceptWord("false"))
+            return vle::value::Boolean::create(false);
+
+        if (acceptWord("null"))
+            return vle::value::Null::create();
+
+        const char* begin = m_buffer.c_str() + m_pos;
+        char* end = nullptr;
+        double number = std::strtod(begin, &end);
+
+        if (end == begin)
+            error();
+
+        m_pos += end - begin;
+        return vle::value::Double::create(number);
+    }
+};
+
+/*
+ * A fixed CPU workload independent of VLE: its rate measures the speed of
+ * the host and of the build, compare() divides the ratios of the
+ * workloads by the ratio of the calibrations.
+ */
+static double
+calibrate(int repeat)
+{
+    const int iterations = 64;
+    double seconds = std::numeric_limits<double>::infinity();
+    std::vector<std::uint64_t> data(4096);
+
+    for (int i = 0; i != repeat; ++i) {
+        std::mt19937_64 generator(5489u);
+        auto start = std::chrono::steady_clock::now();
+
+        for (int j = 0; j != iterations; ++j) {
+            for (auto& elem : data)
+                elem = generator();
+
+            std::sort(data.begin(), data.end());
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        seconds =
+          std::min(seconds, std::chrono::duration<double>(end - start).count());
+    }
+
+    return iterations / seconds;
+}
+
+static std::string
+host_name()
+{
+    char name[256] = { 0 };
+
+    if (::gethostname(name, sizeof(name) - 1))
+        return "unknown";
+
+    return name;
+}
+
+static std::unique_ptr<vle::value::Map>
+make_report(const std::vector<Measure>& measures,
+            bool quick,
+            int repeat,
+            double calibration)
+{
+    auto report = std::make_unique<vle::value::Map>();
+    std::string build_type = VLE_BENCH_BUILD_TYPE;
+
+    report->addString("vle-bench", vle::string_version());
+    report->addString("scale", quick ? "quick" : "full");
+    report->addInt("repeat", repeat);
+    report->addString("build-type", build_type.empty() ? "None" : build_type);
+    report->addString("host", host_name());
+    report->addDouble("calibration-per-second", calibration);
+
+    auto& workloads = report->addMap("workloads");
+
+    for (const auto& elem : measures) {
+        auto& map = workloads.addMap(elem.name);
+        auto events = std::max(elem.counts.events, 1.0);
+
+        map.addDouble("seconds", elem.seconds);
+        map.addDouble("events", elem.counts.events);
+        map.addDouble("events-per-second", elem.counts.events / elem.seconds);
+        map.addDouble("bags", elem.counts.bags);
+        map.addDouble("bags-per-second", elem.counts.bags / elem.seconds);
+        map.addDouble("allocations", elem.allocations);
+        map.addDouble("allocations-per-event", elem.allocations / events);
+        map.addDouble("peak-rss-kb", elem.peak_rss_kb);
+    }
+
+    return report;
+}
+
+/*
+ * Warn if a string attribute of the report differs from the baseline.
+ */
+static void
+check_attribute(const vle::value::Map& report,
+                const vle::value::Map& baseline,
+                const std::string& name)
+{
+    auto base_it = baseline.find(name);
+    auto it = report.find(name);
+    std::string base_value, value;
+
+    if (base_it != baseline.end() and base_it->second->isString())
+        base_value = base_it->second->toString().value();
+
+    if (it != report.end() and it->second->isString())
+        value = it->second->toString().value();
+
+    if (base_value != value)
+        fprintf(stderr,
+                _("warning: baseline %s is `%s', current %s is `%s'\n"),
+                name.c_str(),
+                base_value.c_str(),
+                name.c_str(),
+                value.c_str());
+}
+
+/*
+ * Print the ratio of each workload with the baseline and return false if
+ * the events per second decrease or the allocations per event increase
+ * by more than @e tolerance. If both reports have a calibration, the
+ * ratios of the events per second are divided by the ratio of the
+ * calibrations to compare reports of different hosts or builds.
+ */
+static bool
+compare(const vle::value::Map& report,
+        const vle::value::Map& baseline,
+        double tolerance)
+{
+    bool success = true;
+
+    check_attribute(report, baseline, "scale");
+    check_attribute(report, baseline, "build-type");
+    check_attribute(report, baseline, "host");
+
+    double speed = 1.0;
+    auto base_calibration = baseline.find("calibration-per-second");
+    if (base_calibration != baseline.end() and
+        base_calibration->second->isDouble() and
+        base_calibration->second->toDouble().value() > 0) {
+        speed = report.getDouble("calibration-per-second") /
+                base_calibration->second->toDouble().value();
+        printf(_("calibration ratio %.3f, the ratios are normalised\n"),
+               speed);
+    } else {
+        fprintf(stderr,
+                _("warning: baseline without calibration, the ratios are "
+                  "not normalised\n"));
+    }
+
+    printf("%-24s %14s %14s %8s %12s %12s\n",
+           _("workload"),
+           _("baseline ev/s"),
+           _("current ev/s"),
+           _("ratio"),
+           _("base alloc/e"),
+           _("cur alloc/e"));
+
+    const auto& base_workloads = baseline.getMap("workloads");
+
+    for (const auto& elem : report.getMap("workloads")) {
+        auto it = base_workloads.find(elem.first);
+        if (it == base_workloads.end()) {
+            printf("%-24s %14s\n", elem.first.c_str(), _("(new)"));
+            continue;
+        }
+
+        const auto& current = elem.second->toMap();
+        const auto& base = it->second->toMap();
+
+        double base_rate = base.getDouble("events-per-second");
+        double rate = current.getDouble("events-per-second");
+        double base_alloc = base.getDouble("allocations-per-event");
+        double alloc = current.getDouble("allocations-per-event");
+        double ratio = base_rate > 0 ? rate / (base_rate * speed) : 0;
+
+        bool slower = ratio < 1.0 - tolerance;
+        bool allocates = alloc > base_alloc * (1.0 + tolerance) + 0.5;
+
+        printf("%-24s %14.4g %14.4g %8.3f %12.2f %12.2f%s\n",
+               elem.first.c_str(),
+               base_rate,
+               rate,
+               ratio,
+               base_alloc,
+               alloc,
+               slower or allocates ? _("  REGRESSION") : "");
+
+        if (slower or allocates)
+            success = false;
+    }
+
+    return success;
+}
+
+static void
+remove_directory(const vle::utils::Path& path)
+{
+    if (DIR* dir = ::opendir(path.string().c_str())) {
+        while (struct dirent* entry = ::readdir(dir))
+            if (std::strcmp(entry->d_name, ".") and
+                std::strcmp(entry->d_name, ".."))
+                (path / entry->d_name).remove();
+
+        ::closedir(dir);
+    }
+
+    path.remove();
+}
+
+static void
+show_help()
+{
+    printf(_("vle-bench [options...]\n\n"
+             "Run the synthetic workloads of the VLE kernel and report the\n"
+             "events per second, bags per second, allocations per event and\n"
+             "peak RSS of each workload as JSON.\n\n"
+             "help,h           Produce help message\n"
+             "quick,q          Use the small size of the workloads\n"
+             "repeat,r N       Run each workload N times, keep the fastest "
+             "[default 3]\n"
+             "filter,f NAME    Run only the workloads whose name contains "
+             "NAME\n"
+             "output,o FILE    Write the JSON report into FILE instead of "
+             "the\n"
+             "                 standard output\n"
+             "baseline,b FILE  Compare with a previous JSON report, exit "
+             "with\n"
+             "                 failure if a workload regresses\n"
+             "tolerance,t PCT  Accepted regression in percent [default "
+             "10]\n"
+             "report-only,R    Print the comparison with the baseline "
+             "but\n"
+             "                 never exit with failure\n"
+             "threads,j N      Threads of the manager workload [default 1]\n"
+             "\n"
+             "The storage and file workloads need the vle.output package,\n"
+             "the qss workloads need the vle.adaptative-qss package.\n"));
+}
+}
+
+int
+main(int argc, char** argv)
+{
+    bool quick = false;
+    int repeat = 3;
+    int threads = 1;
+    double tolerance = 10.0;
+    bool report_only = false;
+    std::string filter, output_file, baseline_file;
+
+    const char* const short_opts = "hqr:f:o:b:t:Rj:";
+    const struct option long_opts[] = { { "help", 0, nullptr, 'h' },
+                                        { "quick", 0, nullptr, 'q' },
+                                        { "repeat", 1, nullptr, 'r' },
+                                        { "filter", 1, nullptr, 'f' },
+                                        { "output", 1, nullptr, 'o' },
+                                        { "baseline", 1, nullptr, 'b' },
+                                        { "tolerance", 1, nullptr, 't' },
+                                        { "report-only", 0, nullptr, 'R' },
+                                        { "threads", 1, nullptr, 'j' },
+                                        { 0, 0, nullptr, 0 } };
+
+    for (;;) {
+        int opt_index;
+        const auto opt =
+          getopt_long(argc, argv, short_opts, long_opts, &opt_index);
+        if (opt == -1)
+            break;
+
+        switch (opt) {
+        case 'h':
+            bench::show_help();
+            return EXIT_SUCCESS;
+        case 'q':
+            quick = true;
+            break;
+        case 'r':
+            repeat = std::max(1, std::atoi(::optarg));
+            break;
+        case 'f':
+            filter = ::optarg;
+            break;
+        case 'o':
+            output_file = ::optarg;
+            break;
+        case 'b':
+            baseline_file = ::optarg;
+            break;
+        case 't':
+            tolerance = std::max(0.0, std::atof(::optarg));
+            break;
+        case 'R':
+            report_only = true;
+            break;
+        case 'j':
+            threads = std::max(1, std::atoi(::optarg));
+            break;
+        default:
+            bench::show_help();
+            return EXIT_FAILURE;
+        }
+    }
+
+    vle::Init app;
+    auto ctx = vle::utils::make_context();
+    ctx->set_log_priority(3);
+
+    auto tmp = vle::utils::Path::unique_path(
+      (vle::utils::Path::temp_directory_path() / "vle-bench-%%%%-%%%%")
+        .string());
+    tmp.create_directory();
+
+    //
+    // The full size and the quick size of each workload.
+    //
+    auto size = [quick](int full, int small) { return quick ? small : full; };
+
+    std::vector<std::function<bench::Workload()>> builders = {
+        [&]() {
+            return bench::simulation_workload(
+              ctx,
+              "generators",
+              bench::make_generators(size(10000, 1000), 100));
+        },
+        [&]() {
+            return bench::simulation_workload(
+              ctx,
+              "hierarchy",
+              bench::make_hierarchy(size(5, 4), 4, size(1000, 100)));
+        },
+        [&]() {
+            return bench::simulation_workload(
+              ctx,
+              "executive-churn",
+              bench::make_churn(100, size(10000, 1000)));
+        },
+        [&]() {
+            return bench::simulation_workload(
+              ctx,
+              "graph-smallworld",
+              bench::make_graph(size(100000, 10000), 10, 10));
+        },
+        [&]() {
+            return bench::simulation_workload(
+              ctx,
+              "observation-storage",
+              bench::make_observed("storage", {}, size(1000, 100), 100));
+        },
+        [&]() {
+            return bench::simulation_workload(
+              ctx,
+              "observation-file",
+              bench::make_observed("file", tmp.string(), size(100, 20), 100));
+        },
+        [&]() {
+            return bench::simulation_workload(
+              ctx,
+              "qss-chain-network",
+              bench::make_qss_network(size(50, 10), 100));
+        },
+        [&]() {
+            return bench::simulation_workload(
+              ctx,
+              "qss-chain-system",
+              bench::make_qss_system(size(50, 10), 100));
+        },
+        [&]() {
+            return bench::vpz_workload(
+              bench::make_generators(size(10000, 1000), 100), 5);
+        },
+        [&]() { return bench::value_workload(size(1000, 200), 20); },
+        [&]() { return bench::small_map_workload(size(1000000, 200000)); },
+        [&]() { return bench::serialise_workload(true, size(100, 20)); },
+        [&]() { return bench::serialise_workload(false, size(10, 2)); },
+        [&]() {
+            return bench::manager_workload(
+              ctx,
+              bench::make_plan(size(10000, 1000), 10),
+              size(10000, 1000),
+              threads);
+        },
+    };
+
+    std::vector<bench::Measure> measures;
+
+    for (auto& builder : builders) {
+        try {
+            auto workload = builder();
+
+            if (not filter.empty() and
+                workload.name.find(filter) == std::string::npos)
+                continue;
+
+            fprintf(stderr, "%-24s ", workload.name.c_str());
+            fflush(stderr);
+
+            measures.emplace_back(bench::measure(workload, repeat));
+
+            const auto& m = measures.back();
+            fprintf(stderr,
+                    _("%10.4g events/s %10.4g bags/s %8.2f allocs/event "
+                      "%8ld kB\n"),
+                    m.counts.events / m.seconds,
+                    m.counts.bags / m.seconds,
+                    m.allocations / std::max(m.counts.events, 1.0),
+                    m.peak_rss_kb);
+        } catch (const std::exception& e) {
+            fprintf(stderr, _("skipped: %s\n"), e.what());
+        }
+    }
+
+    try {
+        bench::remove_directory(tmp);
+    } catch (const std::exception& /*e*/) {
+    }
+
+    auto report =
+      bench::make_report(measures, quick, repeat, bench::calibrate(repeat));
+
+    if (output_file.empty()) {
+        std::cout << std::setprecision(10);
+        bench::write_json(std::cout, *report, 0);
+        std::cout << '\n';
+    } else {
+        std::ofstream ofs(output_file);
+        if (not ofs) {
+            fprintf(stderr, _("Fail to write %s\n"), output_file.c_str());
+            return EXIT_FAILURE;
+        }
+        ofs << std::setprecision(10);
+        bench::write_json(ofs, *report, 0);
+        ofs << '\n';
+    }
+
+    if (baseline_file.empty())
+        return EXIT_SUCCESS;
+
+    try {
+        std::ifstream ifs(baseline_file);
+        if (not ifs)
+            throw vle::utils::FileError("Fail to open %s",
+                                        baseline_file.c_str());
+
+        std::stringstream ss;
+        ss << ifs.rdbuf();
+        std::string buffer = ss.str();
+
+        auto baseline = bench::JsonReader(buffer).read();
+        if (not baseline->isMap())
+            throw vle::utils::ArgError("baseline is not a JSON object");
+
+        if (bench::compare(*report, baseline->toMap(), tolerance / 100.0) or
+            report_only)
+            return EXIT_SUCCESS;
+
+        return EXIT_FAILURE;
+    } catch (const std::exception& e) {
+        fprintf(stderr, _("baseline: %s\n"), e.what());
+        return report_only ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+}
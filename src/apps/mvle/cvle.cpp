@@ -250,12 +250,11 @@ struct Access
     vle::value::Value* value(VpzPtr vpz) const
     {
         auto& cnd = vpz->project().experiment().conditions().get(condition);
-        auto& set = cnd.getSetValues(port);
+        vle::value::Value* current = &cnd.valueForWrite(port);
 
         if (params.empty())
-            return set[0].get();
+            return current;
 
-        vle::value::Value* current = set[0].get();
         for (std::size_t i = 0, e = params.size(); i != e; ++i) {
             if (current->isSet()) {
                 errno = 0;
@@ -490,11 +489,7 @@ struct ConditionsBackup
                 vle::vpz::Condition& toup_cond = toup_conds.get(cond.first);
                 for (auto port : cond.second) {
 
-                    vle::vpz::ConditionValues::iterator toup_port =
-                      toup_cond.conditionvalues().find(port.first);
-                    if (toup_port != toup_cond.conditionvalues().end()) {
-                        toup_cond.conditionvalues().erase(toup_port);
-                    }
+                    toup_cond.del(port.first);
                     if (port.second.size() == 0) {
                         throw vle::utils::InternalError(_("No value"));
                     }
@@ -25,8 +25,11 @@
  */
 
 #include <iostream>
+#include <vle/devs/Distributed.hpp>
 #include <vle/manager/ExperimentGenerator.hpp>
 #include <vle/manager/Manager.hpp>
+#include <vle/manager/Simulation.hpp>
+#include <vle/utils/Exception.hpp>
 #include <vle/utils/Package.hpp>
 #include <vle/utils/Tools.hpp>
 #include <vle/value/Matrix.hpp>
@@ -63,7 +66,7 @@ mvle_show_help()
 {
     printf(_("Use:\n"
              "  mvle [-h,--help] [-v,--version] [-s|--show] [-P,--package"
-             " package_name] vpz_files...\n"
+             " package_name] [-d,--distributed] vpz_files...\n"
              "\n"
              "Help options:\n"
              "  -h, --help        Show help option\n"
@@ -71,6 +74,8 @@ mvle_show_help()
              "Application options:\n"
              "  -s --show         Show the plan\n"
              "  -P --package      Start VLE in package mode\n"
+             "  -d --distributed  Distribute one simulation over all the\n"
+             "                    processes\n"
              "  -v --version      Show the version\n"));
 }
 
@@ -144,11 +149,98 @@ mvle_mpi_init(int* argc, char*** argv, uint32_t* rank, uint32_t* world)
     return result;
 }
 
+/**
+ * A devs::DistributedChannel over the processes of MPI_COMM_WORLD.
+ */
+class mvle_mpi_channel : public vle::devs::DistributedChannel
+{
+public:
+    mvle_mpi_channel(uint32_t rank, uint32_t world)
+      : m_rank(static_cast<int>(rank))
+      , m_world(static_cast<int>(world))
+    {
+    }
+
+    virtual int rank() const override
+    {
+        return m_rank;
+    }
+
+    virtual int size() const override
+    {
+        return m_world;
+    }
+
+    virtual std::vector<std::string> exchange(
+      std::vector<std::string> buffers) override
+    {
+        std::vector<int> sendcounts(m_world), senddispls(m_world);
+        std::vector<int> recvcounts(m_world), recvdispls(m_world);
+        std::string send;
+
+        for (int i = 0; i != m_world; ++i) {
+            senddispls[i] = static_cast<int>(send.size());
+            if (i != m_rank) {
+                sendcounts[i] = static_cast<int>(buffers[i].size());
+                send += buffers[i];
+            }
+        }
+
+        check(MPI_Alltoall(sendcounts.data(),
+                           1,
+                           MPI_INT,
+                           recvcounts.data(),
+                           1,
+                           MPI_INT,
+                           MPI_COMM_WORLD));
+
+        int total = 0;
+        for (int i = 0; i != m_world; ++i) {
+            recvdispls[i] = total;
+            total += recvcounts[i];
+        }
+
+        std::string recv(total, '\0');
+        check(MPI_Alltoallv(&send[0],
+                            sendcounts.data(),
+                            senddispls.data(),
+                            MPI_CHAR,
+                            &recv[0],
+                            recvcounts.data(),
+                            recvdispls.data(),
+                            MPI_CHAR,
+                            MPI_COMM_WORLD));
+
+        std::vector<std::string> result(m_world);
+        for (int i = 0; i != m_world; ++i) {
+            if (i == m_rank)
+                result[i] = std::move(buffers[i]);
+            else
+                result[i].assign(recv, recvdispls[i], recvcounts[i]);
+        }
+
+        return result;
+    }
+
+private:
+    int m_rank;
+    int m_world;
+
+    static void check(int error)
+    {
+        if (error != MPI_SUCCESS) {
+            mvle_mpi_error(error);
+            throw vle::utils::InternalError(_("MPI exchange fails"));
+        }
+    }
+};
+
 bool
 mvle_parse_arg(int argc,
                char** argv,
                int* vpz,
                bool* show,
+               bool* distributed,
                vle::utils::Package& pack)
 {
     int i = 1;
@@ -169,6 +261,9 @@ mvle_parse_arg(int argc,
         } else if (std::strcmp(argv[i], "-s") == 0 or
                    std::strcmp(argv[i], "--show") == 0) {
             *show = true;
+        } else if (std::strcmp(argv[i], "-d") == 0 or
+                   std::strcmp(argv[i], "--distributed") == 0) {
+            *distributed = true;
         } else {
             *vpz = i;
         }
@@ -224,19 +319,56 @@ main(int argc, char** argv)
     uint32_t rank = 0;
     uint32_t world = 0;
     bool show = false;
+    bool distributed = false;
     bool result;
 
     auto ctx = vle::utils::make_context();
     if ((result = mvle_mpi_init(&argc, &argv, &rank, &world))) {
         int vpz = 0;
         vle::utils::Package pack(ctx);
-        if ((result = mvle_parse_arg(argc, argv, &vpz, &show, pack))) {
+        if ((result = mvle_parse_arg(
+               argc, argv, &vpz, &show, &distributed, pack))) {
             if (show) {
                 while (vpz < argc) {
                     mvle_show(
                       pack.getExpFile(argv[vpz], vle::utils::PKG_BINARY));
                     vpz++;
                 }
+            } else if (distributed) {
+                try {
+                    vle::manager::Simulation sim(
+                      ctx,
+                      vle::manager::LOG_NONE,
+                      vle::manager::SIMULATION_NO_RETURN,
+                      std::chrono::milliseconds::zero(),
+                      &std::cout);
+
+                    sim.setDistributed(
+                      std::make_shared<mvle_mpi_channel>(rank, world));
+
+                    while (vpz < argc) {
+                        auto v = std::make_unique<vle::vpz::Vpz>(
+                          pack.getExpFile(argv[vpz], vle::utils::PKG_BINARY));
+
+                        vle::manager::Error error;
+                        sim.run(std::move(v), &error);
+
+                        if (error.code) {
+                            fprintf(stderr,
+                                    "MPI node %d/%d: experimental frames "
+                                    "`%s' throws error %s",
+                                    rank,
+                                    world,
+                                    argv[vpz],
+                                    error.message.c_str());
+                            MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+                        }
+
+                        vpz++;
+                    }
+                } catch (const std::exception& e) {
+                    fprintf(stderr, "manager problem: %s", e.what());
+                }
             } else {
                 try {
                     vle::manager::Manager man(
@@ -25,9 +25,11 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <boost/format.hpp>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -36,16 +38,30 @@
 #include <iomanip>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <mutex>
 #include <numeric>
+#include <set>
+#include <thread>
+#include <vle/manager/ExperimentGenerator.hpp>
 #include <vle/manager/Manager.hpp>
 #include <vle/manager/Simulation.hpp>
 #include <vle/utils/Context.hpp>
 #include <vle/utils/Exception.hpp>
 #include <vle/utils/Filesystem.hpp>
+#include <vle/utils/Memory.hpp>
 #include <vle/utils/Package.hpp>
 #include <vle/utils/RemoteManager.hpp>
 #include <vle/utils/Tools.hpp>
+#include <vle/utils/Trace.hpp>
+#include <vle/value/Boolean.hpp>
+#include <vle/value/Double.hpp>
+#include <vle/value/Integer.hpp>
+#include <vle/value/Map.hpp>
 #include <vle/value/Matrix.hpp>
+#include <vle/value/Set.hpp>
+#include <vle/value/String.hpp>
+#include <vle/value/Tuple.hpp>
 #include <vle/vle.hpp>
 
 #ifdef VLE_HAVE_NLS
@@ -203,8 +219,30 @@ show_help() noexcept
         "Need a file name parameter.\n"
         "timeout       limit the simulation duration with a timeout in "
         "miliseconds.\n"
+        "profile       record the number of calls, the time spent and the\n"
+        "              allocations in the kernel and in the atomic models\n"
+        "              and the memory of the value, event, model, vpz and\n"
+        "              output subsystems. Need a file name\n"
+        "              parameter: a CSV report if the name ends with .csv,\n"
+        "              a JSON report otherwise. Not available in manager\n"
+        "              mode and with a timeout.\n"
+        "trace         write a Chrome trace-event timeline of the run\n"
+        "              (chrome://tracing, ui.perfetto.dev). Need a file\n"
+        "              name parameter and a VLE built with WITH_TRACE.\n"
+        "checkpoint    write a checkpoint of the running simulation into\n"
+        "              the file parameter, replaced at each checkpoint.\n"
+        "              All the atomic models must implement the\n"
+        "              checkpoint and restore functions. Not available in\n"
+        "              manager mode and with a timeout.\n"
+        "checkpoint-interval  seconds of wall-clock time between two\n"
+        "              checkpoints [default 600, 0: after each bag].\n"
+        "resume        continue the simulation stored in the checkpoint\n"
+        "              file parameter before the vpz files.\n"
         "\n"
         "processor,j Select number of processor in manager mode [>= 1]\n"
+        "            shared by the combinations of all the vpz files.\n"
+        "            With several vpz files or processors, the logs go\n"
+        "            to the vle_manager_<experiment>.log files.\n"
         "manager,m  Use the manager mode to run experimental frames\n"
         "verbose,V   Verbose mode 0 - 7. [default 3]\n"
         "                0 system is unusable\n"
@@ -343,6 +381,111 @@ convert_log_mode(vle::utils::ContextPtr ctx)
     }
 }
 
+/**
+ * An experimental frame of the manager mode. The combinations of all the
+ * experiments of the command line share the pool of threads of
+ * run_manager(). Each experiment has its own name, used by the outputs of
+ * its combinations (`name-index'), and its own log file.
+ */
+struct Experiment
+{
+    Experiment(std::string file_,
+               std::unique_ptr<vle::vpz::Vpz> vpz_,
+               std::string name_)
+      : file(std::move(file_))
+      , name(std::move(name_))
+      , vpz(std::move(vpz_))
+      , expgen(*vpz, 0, 1)
+    {
+    }
+
+    ~Experiment()
+    {
+        if (log)
+            fclose(log);
+    }
+
+    std::string file;
+    std::string name;
+    std::unique_ptr<vle::vpz::Vpz> vpz;
+    vle::manager::ExperimentGenerator expgen;
+    std::mutex mutex;          ///< Protect the log file and the error.
+    FILE* log = nullptr;       ///< The `vle_manager_name.log' file.
+    vle::manager::Error error; ///< The first error of the combinations.
+};
+
+struct vle_log_experiment : vle::utils::Context::LogFunctor
+{
+    Experiment& experiment;
+
+    vle_log_experiment(Experiment& experiment_)
+      : experiment(experiment_)
+    {
+    }
+
+    virtual void write(const vle::utils::Context& /*ctx*/,
+                       int priority,
+                       const char* file,
+                       int line,
+                       const char* fn,
+                       const char* format,
+                       va_list args) noexcept override
+    {
+        std::lock_guard<std::mutex> lock(experiment.mutex);
+
+        if (not experiment.log) {
+            auto filename = "vle_manager_" + experiment.name + ".log";
+            experiment.log = fopen(filename.c_str(), "w");
+        }
+
+        if (experiment.log) {
+            if (priority == 7)
+                fprintf(experiment.log, "[dbg] %s:%d %s: ", file, line, fn);
+            else if (priority == 6)
+                fprintf(experiment.log, "%s: ", fn);
+            else
+                fprintf(experiment.log, "[Error] %s: ", fn);
+
+            vfprintf(experiment.log, format, args);
+        }
+    }
+};
+
+static void
+run_combination(vle::utils::ContextPtr ctx,
+                std::chrono::milliseconds timeout,
+                Experiment& experiment,
+                uint32_t index)
+{
+    vle::manager::Simulation sim(ctx,
+                                 convert_log_mode(ctx),
+                                 vle::manager::SIMULATION_NONE |
+                                   vle::manager::SIMULATION_NO_RETURN,
+                                 timeout,
+                                 nullptr);
+    vle::manager::Error error;
+
+    try {
+        auto file = std::make_unique<vle::vpz::Vpz>(*experiment.vpz);
+        file->project().setInstance(index);
+        file->project().experiment().setName(experiment.name + '-' +
+                                             std::to_string(index));
+        experiment.expgen.get(index,
+                              &file->project().experiment().conditions());
+
+        sim.run(std::move(file), &error);
+    } catch (const std::exception& e) {
+        error.code = -1;
+        error.message = e.what();
+    }
+
+    if (error.code) {
+        std::lock_guard<std::mutex> lock(experiment.mutex);
+        if (not experiment.error.code)
+            experiment.error = std::move(error);
+    }
+}
+
 static int
 run_manager(vle::utils::ContextPtr ctx,
             std::chrono::milliseconds timeout,
@@ -351,55 +494,364 @@ run_manager(vle::utils::ContextPtr ctx,
             int processor,
             std::shared_ptr<vle::utils::Package> pkg)
 {
-    vle::manager::Manager man(ctx,
-                              convert_log_mode(ctx),
-                              vle::manager::SIMULATION_NONE |
-                                vle::manager::SIMULATION_NO_RETURN,
-                              timeout,
-                              &std::cout);
+    std::vector<std::unique_ptr<Experiment>> experiments;
+    std::set<std::string> names;
     int success = EXIT_SUCCESS;
 
-    for (; (it != end) and (success == EXIT_SUCCESS); ++it) {
+    for (; it != end; ++it) {
         std::string vpzAbsolutePath = search_vpz(*it, pkg);
         if (vpzAbsolutePath.empty()) {
             success = EXIT_FAILURE;
-        } else {
-            vle::manager::Error error;
-            std::unique_ptr<vle::value::Matrix> res =
-              man.run(std::make_unique<vle::vpz::Vpz>(vpzAbsolutePath),
-                      processor,
-                      0,
-                      1,
-                      &error);
-
-            if (error.code) {
-                fprintf(stderr,
-                        _("Experimental frames `%s' throws error %s"),
-                        it->c_str(),
-                        error.message.c_str());
-                success = EXIT_FAILURE;
-            }
+            continue;
+        }
+
+        auto vpz = std::make_unique<vle::vpz::Vpz>(vpzAbsolutePath);
+        auto name = vpz->project().experiment().name();
+        for (int i = 1; not names.insert(name).second; ++i)
+            name = vpz->project().experiment().name() + '_' +
+                   std::to_string(i);
+
+        experiments.emplace_back(
+          std::make_unique<Experiment>(*it, std::move(vpz), std::move(name)));
+    }
+
+    std::vector<std::pair<Experiment*, uint32_t>> jobs;
+    for (auto& experiment : experiments)
+        for (auto i = experiment->expgen.min(); i < experiment->expgen.max();
+             ++i)
+            jobs.emplace_back(experiment.get(), i);
+
+    // The combinations of all the experiments are distributed to the
+    // threads one by one. With one thread and one experiment, the logs
+    // stay in the context of the command line.
+    const bool separate = experiments.size() > 1 or processor > 1;
+    const auto threads = std::max<std::size_t>(
+      1, std::min(static_cast<std::size_t>(processor), jobs.size()));
+    std::atomic<std::size_t> next(0);
+
+    auto worker = [&jobs, &next, timeout, separate](
+                    vle::utils::ContextPtr context) {
+        for (auto job = next++; job < jobs.size(); job = next++) {
+            if (separate)
+                context->set_log_function(
+                  std::make_unique<vle_log_experiment>(*jobs[job].first));
+
+            run_combination(
+              context, timeout, *jobs[job].first, jobs[job].second);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (std::size_t i = 1; i < threads; ++i)
+        pool.emplace_back(worker, ctx->clone());
+
+    worker(separate ? ctx->clone() : ctx);
+
+    for (auto& thread : pool)
+        thread.join();
+
+    for (const auto& experiment : experiments) {
+        if (experiment->error.code) {
+            fprintf(stderr,
+                    _("Experimental frames `%s' throws error %s\n"),
+                    experiment->file.c_str(),
+                    experiment->error.message.c_str());
+            success = EXIT_FAILURE;
         }
     }
 
     return success;
 }
 
+static void
+write_json_number(std::ostream& os, double value)
+{
+    if (std::isfinite(value) and std::trunc(value) == value and
+        std::abs(value) < 1e15)
+        os << static_cast<long long>(value);
+    else if (std::isfinite(value))
+        os << value;
+    else
+        os << "null";
+}
+
+static void
+write_json_string(std::ostream& os, const std::string& str)
+{
+    os << '"';
+    for (auto c : str) {
+        if (c == '"' or c == '\\')
+            os << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+               << static_cast<int>(c) << std::dec << std::setfill(' ');
+        else
+            os << c;
+    }
+    os << '"';
+}
+
+/*
+ * Write the value::Map of the profiler as a JSON document. Only the types
+ * used by the profiler are converted, the others are written as null.
+ */
+static void
+write_json(std::ostream& os, const vle::value::Value& value)
+{
+    switch (value.getType()) {
+    case vle::value::Value::BOOLEAN:
+        os << (value.toBoolean().value() ? "true" : "false");
+        break;
+    case vle::value::Value::INTEGER:
+        os << value.toInteger().value();
+        break;
+    case vle::value::Value::DOUBLE:
+        write_json_number(os, value.toDouble().value());
+        break;
+    case vle::value::Value::STRING:
+        write_json_string(os, value.toString().value());
+        break;
+    case vle::value::Value::TUPLE: {
+        os << '[';
+        const auto& tuple = value.toTuple().value();
+        for (std::size_t i = 0, e = tuple.size(); i != e; ++i) {
+            if (i)
+                os << ',';
+            write_json_number(os, tuple[i]);
+        }
+        os << ']';
+    } break;
+    case vle::value::Value::SET: {
+        os << '[';
+        bool first = true;
+        for (const auto& elem : value.toSet()) {
+            if (not first)
+                os << ',';
+            first = false;
+            if (elem)
+                write_json(os, *elem);
+            else
+                os << "null";
+        }
+        os << ']';
+    } break;
+    case vle::value::Value::MAP: {
+        os << '{';
+        bool first = true;
+        for (const auto& elem : value.toMap()) {
+            if (not first)
+                os << ',';
+            first = false;
+            write_json_string(os, elem.first);
+            os << ':';
+            if (elem.second)
+                write_json(os, *elem.second);
+            else
+                os << "null";
+        }
+        os << '}';
+    } break;
+    default:
+        os << "null";
+        break;
+    }
+}
+
+static void
+write_csv_string(std::ostream& os, const std::string& str)
+{
+    if (str.find_first_of(",\"\n") == std::string::npos) {
+        os << str;
+    } else {
+        os << '"';
+        for (auto c : str) {
+            if (c == '"')
+                os << '"';
+            os << c;
+        }
+        os << '"';
+    }
+}
+
+static void
+write_csv_row(std::ostream& os,
+              const std::string& experiment,
+              const std::string& scope,
+              const std::string& name,
+              double value)
+{
+    write_csv_string(os, experiment);
+    os << ',';
+    write_csv_string(os, scope);
+    os << ',';
+    write_csv_string(os, name);
+    os << ',';
+    write_json_number(os, value);
+    os << '\n';
+}
+
+/*
+ * Write the value::Map of the profiler as a CSV table with one counter
+ * per line: experiment, scope ("kernel" or the complete name of the
+ * atomic model), counter and value.
+ */
+static void
+write_csv(std::ostream& os, const vle::value::Map& profiles)
+{
+    os << "experiment,scope,counter,value\n";
+
+    for (const auto& experiment : profiles) {
+        const auto& profile = experiment.second->toMap();
+
+        for (const auto& elem : profile.getMap("kernel")) {
+            if (elem.second->isTuple()) {
+                const auto& tuple = elem.second->toTuple().value();
+                for (std::size_t i = 0, e = tuple.size(); i != e; ++i)
+                    write_csv_row(os,
+                                  experiment.first,
+                                  "kernel",
+                                  elem.first + '[' + std::to_string(i) + ']',
+                                  tuple[i]);
+            } else {
+                write_csv_row(os,
+                              experiment.first,
+                              "kernel",
+                              elem.first,
+                              vle::value::toDouble(elem.second));
+            }
+        }
+
+        for (const auto& model : profile.getMap("models"))
+            for (const auto& elem : model.second->toMap())
+                write_csv_row(os,
+                              experiment.first,
+                              model.first,
+                              elem.first,
+                              vle::value::toDouble(elem.second));
+
+        auto memory = profile.find("memory");
+        if (memory != profile.end())
+            for (const auto& tag : memory->second->toMap())
+                for (const auto& elem : tag.second->toMap())
+                    write_csv_row(os,
+                                  experiment.first,
+                                  "memory:" + tag.first,
+                                  elem.first,
+                                  vle::value::toDouble(elem.second));
+    }
+}
+
+static void
+write_profile(const std::string& profile_file,
+              const vle::value::Map& profiles)
+{
+    std::ofstream ofs(profile_file);
+
+    if (not ofs) {
+        fprintf(
+          stderr, _("Fail to write profile file %s\n"), profile_file.c_str());
+        return;
+    }
+
+    ofs << std::setprecision(std::numeric_limits<double>::digits10);
+
+    auto size = profile_file.size();
+    if (size > 4 and profile_file.compare(size - 4, 4, ".csv") == 0) {
+        write_csv(ofs, profiles);
+    } else {
+        write_json(ofs, profiles);
+        ofs << '\n';
+    }
+}
+
+/**
+ * Options of the checkpoints of the simulations (see
+ * vle::manager::Simulation::setCheckpoint()).
+ */
+struct Checkpoint
+{
+    std::string file;   ///< File to write, empty to disable checkpoints.
+    std::string resume; ///< Checkpoint file to resume, if not empty.
+    std::chrono::seconds interval{ 600 };
+
+    bool empty() const noexcept
+    {
+        return file.empty() and resume.empty();
+    }
+};
+
+static int
+write_result(const std::string& name,
+             const std::string& output_file,
+             std::unique_ptr<vle::value::Map> res,
+             const vle::manager::Error& error)
+{
+    if (error.code) {
+        fprintf(stderr,
+                _("Simulator `%s' throws error %s\n"),
+                name.c_str(),
+                error.message.c_str());
+        return EXIT_FAILURE;
+    }
+
+    if (res and not output_file.empty()) {
+        std::ofstream ofs(output_file);
+
+        if (not ofs) {
+            fprintf(stderr,
+                    _("Simulation`%s' file to write output"
+                      " file %s\n"),
+                    name.c_str(),
+                    output_file.c_str());
+        } else {
+            ofs << std::showpoint << std::fixed
+                << std::setprecision(std::numeric_limits<double>::digits10);
+            res->writeXml(ofs);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
 static int
 run_simulation(vle::utils::ContextPtr ctx,
                std::chrono::milliseconds timeout,
                const std::string& output_file,
+               const std::string& profile_file,
+               const Checkpoint& checkpoint,
                CmdArgs::const_iterator it,
                CmdArgs::const_iterator end,
                std::shared_ptr<vle::utils::Package> pkg)
 {
+    if (not profile_file.empty() and
+        timeout != std::chrono::milliseconds::zero())
+        fprintf(stderr,
+                _("Profile is not available for simulations with a "
+                  "timeout\n"));
+
     vle::manager::Simulation sim(ctx,
                                  convert_log_mode(ctx),
-                                 vle::manager::SIMULATION_NONE,
+                                 profile_file.empty()
+                                   ? vle::manager::SIMULATION_NONE
+                                   : vle::manager::SIMULATION_PROFILE,
                                  timeout,
                                  &std::cout);
+    sim.setCheckpoint(checkpoint.file, checkpoint.interval);
+
+    vle::value::Map profiles;
     int success = EXIT_SUCCESS;
 
+    if (not checkpoint.resume.empty()) {
+        vle::manager::Error error;
+        auto res = sim.resume(checkpoint.resume, &error);
+
+        success =
+          write_result(checkpoint.resume, output_file, std::move(res), error);
+
+        if (auto profile = sim.profile())
+            profiles.add(checkpoint.resume, std::move(profile));
+    }
+
     for (; (it != end) and (success == EXIT_SUCCESS); ++it) {
         std::string vpzAbsolutePath = search_vpz(*it, pkg);
         if (vpzAbsolutePath.empty()) {
@@ -409,33 +861,16 @@ run_simulation(vle::utils::ContextPtr ctx,
             auto res = sim.run(
               std::make_unique<vle::vpz::Vpz>(vpzAbsolutePath), &error);
 
-            if (error.code) {
-                fprintf(stderr,
-                        _("Simulator `%s' throws error %s\n"),
-                        it->c_str(),
-                        error.message.c_str());
-                success = EXIT_FAILURE;
-            } else {
-                if (res and not output_file.empty()) {
-                    std::ofstream ofs(output_file);
-
-                    if (not ofs) {
-                        fprintf(stderr,
-                                _("Simulation`%s' file to write output"
-                                  " file %s\n"),
-                                it->c_str(),
-                                output_file.c_str());
-                    } else {
-                        ofs << std::showpoint << std::fixed
-                            << std::setprecision(
-                                 std::numeric_limits<double>::digits10);
-                        res->writeXml(ofs);
-                    }
-                }
-            }
+            success = write_result(*it, output_file, std::move(res), error);
+
+            if (auto profile = sim.profile())
+                profiles.add(vpzAbsolutePath, std::move(profile));
         }
     }
 
+    if (not profile_file.empty())
+        write_profile(profile_file, profiles);
+
     return success;
 }
 
@@ -460,6 +895,8 @@ init_package(vle::utils::Package& pkg, const CmdArgs& args)
 static int
 manage_package_mode(vle::utils::ContextPtr ctx,
                     const std::string& output_file,
+                    const std::string& profile_file,
+                    const Checkpoint& checkpoint,
                     std::chrono::milliseconds timeout,
                     bool manager_mode,
                     int processor,
@@ -536,10 +973,22 @@ manage_package_mode(vle::utils::ContextPtr ctx,
     if (stop)
         ret = EXIT_FAILURE;
     else if (it != end) {
-        if (manager_mode)
+        if (manager_mode) {
+            if (not checkpoint.empty())
+                fprintf(stderr,
+                        _("Checkpoints are not available in manager "
+                          "mode\n"));
             ret = run_manager(ctx, timeout, it, end, processor, pkg);
-        else
-            ret = run_simulation(ctx, timeout, output_file, it, end, pkg);
+        } else {
+            ret = run_simulation(ctx,
+                                 timeout,
+                                 output_file,
+                                 profile_file,
+                                 checkpoint,
+                                 it,
+                                 end,
+                                 pkg);
+        }
     }
 
     return ret;
@@ -706,12 +1155,14 @@ manage_remote_mode(vle::utils::ContextPtr ctx, CmdArgs args)
 static int
 manage_nothing_mode(vle::utils::ContextPtr ctx,
                     const std::string& output_file,
+                    const std::string& profile_file,
+                    const Checkpoint& checkpoint,
                     std::chrono::milliseconds timeout,
                     bool manager_mode,
                     int processor,
                     CmdArgs args)
 {
-    if (args.empty()) {
+    if (args.empty() and checkpoint.resume.empty()) {
         fprintf(stderr, _("missing vpz file to simulate\n"));
         return EXIT_FAILURE;
     }
@@ -722,10 +1173,21 @@ manage_nothing_mode(vle::utils::ContextPtr ctx,
     auto end = args.end();
     int ret = EXIT_SUCCESS;
 
-    if (manager_mode)
+    if (manager_mode) {
+        if (not checkpoint.empty())
+            fprintf(stderr,
+                    _("Checkpoints are not available in manager mode\n"));
         ret = run_manager(ctx, timeout, it, end, processor, pkg);
-    else
-        ret = run_simulation(ctx, timeout, output_file, it, end, pkg);
+    } else {
+        ret = run_simulation(ctx,
+                             timeout,
+                             output_file,
+                             profile_file,
+                             checkpoint,
+                             it,
+                             end,
+                             pkg);
+    }
 
     return ret;
 }
@@ -805,6 +1267,9 @@ int
 main(int argc, char** argv)
 {
     std::string output_file;
+    std::string profile_file;
+    std::string trace_file;
+    Checkpoint checkpoint;
     std::chrono::milliseconds timeout{ std::chrono::milliseconds::zero() };
     unsigned int mode = CLI_MODE_NOTHING;
     int verbose_level = 0;
@@ -825,6 +1290,14 @@ main(int argc, char** argv)
                                         { "log-stderr", 0, &log_stdout, 2 },
                                         { "write-output", 1, nullptr, 0 },
                                         { "timeout", 1, nullptr, 0 },
+                                        { "profile", 1, nullptr, 0 },
+                                        { "trace", 1, nullptr, 0 },
+                                        { "checkpoint", 1, nullptr, 0 },
+                                        { "checkpoint-interval",
+                                          1,
+                                          nullptr,
+                                          0 },
+                                        { "resume", 1, nullptr, 0 },
                                         { "verbose", 1, nullptr, 'V' },
                                         { "processor", 1, nullptr, 'j' },
                                         { "manager", 0, nullptr, 'm' },
@@ -843,6 +1316,29 @@ main(int argc, char** argv)
         case 0:
             if (not strcmp(long_opts[opt_index].name, "write-output")) {
                 output_file = ::optarg;
+            } else if (not strcmp(long_opts[opt_index].name, "profile")) {
+                profile_file = ::optarg;
+            } else if (not strcmp(long_opts[opt_index].name, "trace")) {
+                trace_file = ::optarg;
+            } else if (not strcmp(long_opts[opt_index].name,
+                                  "checkpoint")) {
+                checkpoint.file = ::optarg;
+            } else if (not strcmp(long_opts[opt_index].name, "resume")) {
+                checkpoint.resume = ::optarg;
+            } else if (not strcmp(long_opts[opt_index].name,
+                                  "checkpoint-interval")) {
+                try {
+                    long int t = std::stol(::optarg);
+                    if (t < 0)
+                        throw std::exception();
+                    checkpoint.interval = std::chrono::seconds(t);
+                } catch (const std::exception& /* e */) {
+                    fprintf(stderr,
+                            _("Bad checkpoint interval: %s. Assume %ld"
+                              " seconds\n"),
+                            ::optarg,
+                            static_cast<long>(checkpoint.interval.count()));
+                }
             } else if (not strcmp(long_opts[opt_index].name, "timeout")) {
                 try {
                     long int t = std::stol(::optarg);
@@ -949,10 +1445,29 @@ main(int argc, char** argv)
 
     CmdArgs commands(argv + ::optind, argv + argc);
 
+    if (not trace_file.empty()) {
+#ifndef VLE_TRACE
+        fprintf(stderr,
+                _("VLE is built without trace points (WITH_TRACE), the"
+                  " trace file will be empty\n"));
+#endif
+        vle::utils::Trace::start();
+        vle::utils::Trace::thread("vle");
+    }
+
+    //
+    // The memory accounting starts before the parsing of the vpz files to
+    // count the allocations and the deallocations of their models.
+    //
+    if (not profile_file.empty())
+        vle::utils::Memory::enable();
+
     switch (mode) {
     case CLI_MODE_PACKAGE:
         ret = manage_package_mode(ctx,
                                   output_file,
+                                  profile_file,
+                                  checkpoint,
                                   timeout,
                                   manager,
                                   processor_number,
@@ -967,6 +1482,8 @@ main(int argc, char** argv)
     case CLI_MODE_NOTHING:
         ret = manage_nothing_mode(ctx,
                                   output_file,
+                                  profile_file,
+                                  checkpoint,
                                   timeout,
                                   manager,
                                   processor_number,
@@ -979,5 +1496,16 @@ main(int argc, char** argv)
         break;
     };
 
+    if (not trace_file.empty()) {
+        vle::utils::Trace::stop();
+
+        std::ofstream ofs(trace_file);
+        if (ofs)
+            vle::utils::Trace::write(ofs);
+        else
+            fprintf(
+              stderr, _("Fail to write trace file %s\n"), trace_file.c_str());
+    }
+
     return ret;
 }
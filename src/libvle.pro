@@ -27,7 +27,9 @@ HEADERS = vle/manager/ExperimentGenerator.hpp \
   vle/translator/GraphTranslator.hpp \
   vle/utils/PackageTable.hpp \
   vle/utils/Filesystem.hpp \
+  vle/utils/Memory.hpp \
   vle/utils/Tools.hpp \
+  vle/utils/Trace.hpp \
   vle/utils/Exception.hpp \
   vle/utils/Template.hpp \
   vle/utils/DownloadManager.hpp \
@@ -36,6 +38,7 @@ HEADERS = vle/manager/ExperimentGenerator.hpp \
   vle/utils/Context.hpp \
   vle/utils/Array.hpp \
   vle/utils/Spawn.hpp \
+  vle/utils/Symbol.hpp \
   vle/utils/Algo.hpp \
   vle/utils/unit-test.hpp \
   vle/utils/Deprecated.hpp \
@@ -66,7 +69,11 @@ HEADERS = vle/manager/ExperimentGenerator.hpp \
   vle/devs/Coordinator.hpp \
   vle/devs/Simulator.hpp \
   vle/devs/RootCoordinator.hpp \
+  vle/devs/Profile.hpp \
+  vle/devs/Partition.hpp \
+  vle/devs/Distributed.hpp \
   vle/value/Map.hpp \
+  vle/value/Binary.hpp \
   vle/value/Boolean.hpp \
   vle/value/Table.hpp \
   vle/value/User.hpp \
@@ -74,6 +81,7 @@ HEADERS = vle/manager/ExperimentGenerator.hpp \
   vle/value/String.hpp \
   vle/value/Double.hpp \
   vle/value/Null.hpp \
+  vle/value/Pool.hpp \
   vle/value/Set.hpp \
   vle/value/Tuple.hpp \
   vle/value/Integer.hpp \
@@ -116,6 +124,7 @@ SOURCES = vle/manager/ExperimentGenerator.cpp \
   vle/translator/MatrixTranslator.cpp \
   vle/vle.cpp \
   vle/utils/Filesystem.cpp \
+  vle/utils/Memory.cpp \
   vle/utils/DateTime.cpp \
   vle/utils/ContextSettings.cpp \
   vle/utils/Package.cpp \
@@ -128,7 +137,9 @@ SOURCES = vle/manager/ExperimentGenerator.cpp \
   vle/utils/Rand.cpp \
   vle/utils/Exception.cpp \
   vle/utils/Tools.cpp \
+  vle/utils/Trace.cpp \
   vle/utils/RemoteManager.cpp \
+  vle/utils/Symbol.cpp \
   vle/utils/details/PackageManager.cpp \
   vle/utils/details/PackageParser.cpp \
   vle/devs/RootCoordinator.cpp \
@@ -147,7 +158,10 @@ SOURCES = vle/manager/ExperimentGenerator.cpp \
   vle/devs/Executive.cpp \
   vle/devs/DynamicsDbg.cpp \
   vle/devs/Coordinator.cpp \
+  vle/devs/Distributed.cpp \
   vle/value/Null.cpp \
+  vle/value/Pool.cpp \
+  vle/value/Binary.cpp \
   vle/value/Map.cpp \
   vle/value/Boolean.cpp \
   vle/value/Table.cpp \
@@ -214,7 +228,7 @@ header_files.path = $$INCLUDEDIR/vle
 header_files.files = vle/vle.hpp vle/DllDefines.hpp
 
 header_files_devs.path = $$INCLUDEDIR/vle/devs
-header_files_devs.files = vle/devs/Dynamics.hpp vle/devs/DynamicsWrapper.hpp vle/devs/Executive.hpp vle/devs/ExternalEvent.hpp vle/devs/ExternalEventList.hpp vle/devs/InitEventList.hpp vle/devs/ObservationEvent.hpp vle/devs/Time.hpp
+header_files_devs.files = vle/devs/Distributed.hpp vle/devs/Dynamics.hpp vle/devs/DynamicsWrapper.hpp vle/devs/Executive.hpp vle/devs/ExternalEvent.hpp vle/devs/ExternalEventList.hpp vle/devs/InitEventList.hpp vle/devs/ObservationEvent.hpp vle/devs/Time.hpp
 
 header_files_manager.path = $$INCLUDEDIR/vle/manager
 header_files_manager.files = vle/manager/ExperimentGenerator.hpp vle/manager/Manager.hpp vle/manager/Simulation.hpp vle/manager/Types.hpp
@@ -226,10 +240,10 @@ header_files_translator.path = $$INCLUDEDIR/vle/translator
 header_files_translator.files = vle/translator/GraphTranslator.hpp vle/translator/MatrixTranslator.hpp
 
 header_files_utils.path = $$INCLUDEDIR/vle/utils
-header_files_utils.files = vle/utils/Algo.hpp vle/utils/Array.hpp vle/utils/Context.hpp vle/utils/DateTime.hpp vle/utils/Deprecated.hpp vle/utils/DownloadManager.hpp vle/utils/Exception.hpp vle/utils/Filesystem.hpp vle/utils/Package.hpp vle/utils/PackageTable.hpp vle/utils/Parser.hpp vle/utils/Rand.hpp vle/utils/RemoteManager.hpp vle/utils/Spawn.hpp vle/utils/Template.hpp vle/utils/Tools.hpp vle/utils/Types.hpp vle/utils/unit-test.hpp
+header_files_utils.files = vle/utils/Algo.hpp vle/utils/Array.hpp vle/utils/Context.hpp vle/utils/DateTime.hpp vle/utils/Deprecated.hpp vle/utils/DownloadManager.hpp vle/utils/Exception.hpp vle/utils/Filesystem.hpp vle/utils/Memory.hpp vle/utils/Package.hpp vle/utils/PackageTable.hpp vle/utils/Parser.hpp vle/utils/Rand.hpp vle/utils/RemoteManager.hpp vle/utils/Spawn.hpp vle/utils/Symbol.hpp vle/utils/Template.hpp vle/utils/Tools.hpp vle/utils/Trace.hpp vle/utils/Types.hpp vle/utils/unit-test.hpp
 
 header_files_value.path = $$INCLUDEDIR/vle/value
-header_files_value.files = vle/value/Boolean.hpp vle/value/Double.hpp vle/value/Integer.hpp vle/value/Map.hpp vle/value/Matrix.hpp vle/value/Null.hpp vle/value/Set.hpp vle/value/String.hpp vle/value/Table.hpp vle/value/Tuple.hpp vle/value/User.hpp vle/value/Value.hpp vle/value/XML.hpp
+header_files_value.files = vle/value/Binary.hpp vle/value/Boolean.hpp vle/value/Double.hpp vle/value/Integer.hpp vle/value/Map.hpp vle/value/Matrix.hpp vle/value/Null.hpp vle/value/Pool.hpp vle/value/Set.hpp vle/value/String.hpp vle/value/Table.hpp vle/value/Tuple.hpp vle/value/User.hpp vle/value/Value.hpp vle/value/XML.hpp
 
 header_files_vpz.path = $$INCLUDEDIR/vle/vpz
 header_files_vpz.files = vle/vpz/Base.hpp vle/vpz/Classes.hpp vle/vpz/Class.hpp vle/vpz/Condition.hpp vle/vpz/Conditions.hpp vle/vpz/Dynamic.hpp vle/vpz/Dynamics.hpp vle/vpz/Experiment.hpp vle/vpz/Model.hpp vle/vpz/Observable.hpp vle/vpz/Observables.hpp vle/vpz/Output.hpp vle/vpz/Outputs.hpp vle/vpz/Port.hpp vle/vpz/Project.hpp vle/vpz/Structures.hpp vle/vpz/View.hpp vle/vpz/Views.hpp vle/vpz/Vpz.hpp vle/vpz/AtomicModel.hpp vle/vpz/CoupledModel.hpp vle/vpz/BaseModel.hpp vle/vpz/ModelPortList.hpp
@@ -14,6 +14,7 @@
  * permissions and limitations under the License.
  */
 
+#include "QssEvent.hpp"
 #include <cmath>
 #include <deque>
 #include <vector>
@@ -34,6 +35,8 @@ public:
     AdaptativeQuantifier(const vd::DynamicsInit& init,
                          const vd::InitEventList& events)
       : vd::Dynamics(init, events)
+      , m_has_output_port(false)
+      , m_typed_events(qss::use_typed_events(events))
     {
         const auto& my_list = getModel().getOutputPortList();
 
@@ -123,7 +126,7 @@ public:
 
         auto it = events.begin();
         while (it != events.end()) {
-            val = it->getMap().getDouble("d_val");
+            val = qss::get_value(*it);
             if (INIT == m_state) {
                 init_step_number_and_offset(val);
                 update_thresholds();
@@ -263,12 +266,12 @@ public:
     virtual void output(vd::Time /*time*/,
                         vd::ExternalEventList& output) const override
     {
-        if (m_has_output_port) {
-            output.emplace_back(m_output_port_label);
-            auto& m = output.back().addMap();
-            m.addDouble("up", m_upthreshold);
-            m.addDouble("down", m_downthreshold);
-        }
+        if (m_has_output_port)
+            qss::add_quanta(output,
+                            m_output_port_label,
+                            m_upthreshold,
+                            m_downthreshold,
+                            m_typed_events);
     }
 
     virtual vd::Time timeAdvance() const override
@@ -328,6 +331,7 @@ private:
 
     std::string m_output_port_label;
     bool m_has_output_port;
+    bool m_typed_events;
 
     void update_thresholds()
     {
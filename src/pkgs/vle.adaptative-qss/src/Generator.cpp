@@ -14,6 +14,7 @@
  * permissions and limitations under the License.
  */
 
+#include "QssEvent.hpp"
 #include <vle/devs/Dynamics.hpp>
 #include <vle/utils/Tools.hpp>
 #include <vle/value/Map.hpp>
@@ -28,6 +29,7 @@ class Generator : public vd::Dynamics
 public:
     Generator(const vd::DynamicsInit& init, const vd::InitEventList& events)
       : vd::Dynamics(init, events)
+      , m_typed_events(qss::use_typed_events(events))
     {
         vg::ConnectionList my_list;
 
@@ -106,8 +108,8 @@ public:
         if (m_has_output_port) {
             const double out_val = m_val + m_trend * time;
 
-            output.emplace_back(m_output_port_label);
-            output.back().addMap().addDouble("d_val", out_val);
+            qss::add_value(
+              output, m_output_port_label, out_val, m_typed_events);
         }
     }
 
@@ -140,6 +142,7 @@ private:
 
     std::string m_output_port_label;
     bool m_has_output_port;
+    bool m_typed_events;
 };
 
 DECLARE_DYNAMICS(Generator)
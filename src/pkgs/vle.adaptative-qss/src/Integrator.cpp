@@ -14,6 +14,7 @@
  * permissions and limitations under the License.
  */
 
+#include "QssEvent.hpp"
 #include <deque>
 #include <vle/devs/Dynamics.hpp>
 #include <vle/value/Map.hpp>
@@ -29,6 +30,8 @@ class Integrator : public vd::Dynamics
 public:
     Integrator(const vd::DynamicsInit& init, const vd::InitEventList& events)
       : vd::Dynamics(init, events)
+      , m_has_output_port(false)
+      , m_typed_events(qss::use_typed_events(events))
     {
         double x_0_val;
         if (events.exist("X_0")) {
@@ -89,23 +92,18 @@ public:
     virtual void externalTransition(const vd::ExternalEventList& events,
                                     vd::Time time) override
     {
-        double up_val, down_val;
         double x_dot_val;
 
         auto it = events.begin();
         while (it != events.end()) {
-            if (m_quanta_port_label == (*it).getPortName()) {
-                up_val = (*it).getMap().getDouble("up");
-                m_upthreshold = up_val;
-                down_val = (*it).getMap().getDouble("down");
-                m_downthreshold = down_val;
+            if ((*it).getPort() == m_quanta_port_label) {
+                qss::get_quanta(*it, m_upthreshold, m_downthreshold);
                 if (WAIT_FOR_QUANTA == m_state)
                     m_state = RUNNING;
                 if (WAIT_FOR_BOTH == m_state)
                     m_state = WAIT_FOR_X_DOT;
-            }
-            if (m_x_dot_port_label == (*it).getPortName()) {
-                x_dot_val = (*it).getMap().getDouble("d_val");
+            } else if ((*it).getPort() == m_x_dot_port_label) {
+                x_dot_val = qss::get_value(*it);
                 record_t record;
                 record.date = time;
                 record.x_dot = x_dot_val;
@@ -161,13 +159,13 @@ public:
             switch (m_state) {
             case RUNNING:
                 outval = m_expected_value;
-                output.emplace_back(m_output_port_label);
-                output.back().addMap().addDouble("d_val", outval);
+                qss::add_value(
+                  output, m_output_port_label, outval, m_typed_events);
                 break;
             case INIT:
                 outval = m_current_value;
-                output.emplace_back(m_output_port_label);
-                output.back().addMap().addDouble("d_val", outval);
+                qss::add_value(
+                  output, m_output_port_label, outval, m_typed_events);
                 break;
             default:
                 throw vu::ModellingError(
@@ -257,10 +255,11 @@ private:
     } State;
     State m_state;
 
-    std::string m_x_dot_port_label;
-    std::string m_quanta_port_label;
+    vle::utils::Symbol m_x_dot_port_label;
+    vle::utils::Symbol m_quanta_port_label;
     std::string m_output_port_label;
     bool m_has_output_port;
+    bool m_typed_events;
 
     vd::Time m_last_output_date;
 
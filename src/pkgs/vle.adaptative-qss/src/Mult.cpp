@@ -14,6 +14,7 @@
  * permissions and limitations under the License.
  */
 
+#include "QssEvent.hpp"
 #include <vle/devs/Dynamics.hpp>
 #include <vle/value/Map.hpp>
 #include <vle/vpz/BaseModel.hpp>
@@ -28,6 +29,7 @@ public:
     Mult(const vd::DynamicsInit& init, const vd::InitEventList& events)
       : vd::Dynamics(init, events)
       , m_weights_label("powers")
+      , m_typed_events(qss::use_typed_events(events))
     {
         vg::ConnectionList my_list;
 
@@ -46,37 +48,43 @@ public:
                   "only port: %s\n",
                   m_output_port_label.c_str());
 
-        connected_input_port_list.resize(0);
-
         my_list = getModel().getInputPortList();
         for (auto& elem : my_list) {
             if (0 == elem.second.size()) {
                 Trace(
                   context(), 3, "%s without connection\n", elem.first.c_str());
             } else {
-                connected_input_port_list.push_back((elem).first);
+                connected_input_ports.add((elem).first);
             }
         }
 
+        connected_input_ports.build();
+
+        input_coeffs.resize(connected_input_ports.size(), 1.0);
+        input_values.resize(connected_input_ports.size(), 0.0);
+        input_received.resize(connected_input_ports.size(), false);
+        m_received_count = 0;
+
         if (events.exist(m_weights_label)) {
             const vle::value::Map& mapping = events.getMap(m_weights_label);
-            const vle::value::MapValue& lst = mapping.value();
-            for (const auto& elem : lst) {
-                std::string name = elem.first;
-                double weight = vle::value::toDouble(elem.second);
+            std::vector<bool> found(connected_input_ports.size(), false);
 
-                input_coeffs[name] = weight;
+            for (const auto& elem : mapping.value()) {
+                auto id = connected_input_ports.find(elem.first);
+                if (id != connected_input_ports.size()) {
+                    input_coeffs[id] = vle::value::toDouble(elem.second);
+                    found[id] = true;
+                }
             }
 
-            for (auto& elem : connected_input_port_list) {
-                if (0 == input_coeffs.count(elem)) {
+            for (std::size_t id = 0; id != found.size(); ++id) {
+                if (not found[id]) {
                     Trace(context(),
                           6,
                           "Warning: no power found for input port %s"
                           " of model %s\nAssuming 1 value!",
-                          elem.c_str(),
+                          connected_input_ports.name(id).c_str(),
                           getModelName().c_str());
-                    input_coeffs[elem] = 1;
                 }
             }
 
@@ -87,10 +95,6 @@ public:
                   "Using default value (output is the product of connected "
                   "inputs)\n",
                   getModelName().c_str());
-
-            for (auto& elem : connected_input_port_list) {
-                input_coeffs[elem] = 1;
-            }
         }
     }
 
@@ -113,10 +117,9 @@ public:
         case WAIT:
             break;
         case RESPONSE:
-            if (m_has_output_port) {
-                output.emplace_back(m_output_port_label);
-                output.back().addMap().addDouble("d_val", m_output_value);
-            }
+            if (m_has_output_port)
+                qss::add_value(
+                  output, m_output_port_label, m_output_value, m_typed_events);
         }
     }
 
@@ -145,19 +148,24 @@ public:
     {
         vd::ExternalEventList::const_iterator it;
         for (it = lst.begin(); it != lst.end(); ++it) {
-            if (1 < (*it).getMap().value().size()) {
+            if ((*it).attributes()->isMap() and
+                1 < (*it).getMap().value().size()) {
                 Trace(context(),
                       3,
                       "Warning : getting multiple attributes on port %s\n",
                       it->getPortName().c_str());
             }
 
-            input_values[(*it).getPortName()] =
-              (*it).getMap().getDouble((*it).getMap().begin()->first);
+            auto id = connected_input_ports.get(*it, getModelName());
+            input_values[id] = qss::get_value(*it);
+            if (not input_received[id]) {
+                input_received[id] = true;
+                ++m_received_count;
+            }
 
             switch (m_state) {
             case INIT:
-                if (input_values.size() != connected_input_port_list.size())
+                if (m_received_count != connected_input_ports.size())
                     break;
                 else {
                     m_output_value = compute_output_val();
@@ -197,15 +205,17 @@ private:
     typedef enum { INIT, WAIT, RESPONSE } State;
     State m_state;
 
-    typedef std::vector<std::string> t_port_vector;
-    t_port_vector connected_input_port_list;
+    qss::PortIndex connected_input_ports;
 
     std::string m_weights_label;
     std::string m_output_port_label;
     bool m_has_output_port;
+    bool m_typed_events;
 
-    std::map<std::string, double> input_coeffs;
-    std::map<std::string, double> input_values;
+    std::vector<double> input_coeffs;
+    std::vector<double> input_values;
+    std::vector<bool> input_received;
+    std::size_t m_received_count;
 
     double m_output_value;
     double m_last_output;
@@ -214,16 +224,20 @@ private:
     {
         Trace(context(), 6, "Input values :");
 
-        for (auto& elem : input_values)
-            Trace(context(), 6, "%s => %f\n", elem.first.c_str(), elem.second);
+        for (std::size_t id = 0; id != input_values.size(); ++id)
+            Trace(context(),
+                  6,
+                  "%s => %f\n",
+                  connected_input_ports.name(id).c_str(),
+                  input_values[id]);
     }
 
-    double compute_output_val()
+    double compute_output_val() const
     {
         double acc = 1;
 
-        for (auto& elem : connected_input_port_list)
-            acc *= std::pow(input_values[elem], input_coeffs[elem]);
+        for (std::size_t id = 0; id != input_values.size(); ++id)
+            acc *= std::pow(input_values[id], input_coeffs[id]);
 
         return acc;
     }
@@ -14,6 +14,7 @@
  * permissions and limitations under the License.
  */
 
+#include "QssEvent.hpp"
 #include <algorithm>
 #include <cassert>
 #include <chrono>
@@ -271,7 +272,9 @@ public:
         for (const auto& elem : events) {
             auto idx = get_index(m_labels, elem.getPortName());
 
-            if (elem.attributes()->isDouble())
+            if (const auto* qss = qss::to_qss_event(elem))
+                m_data.emplace_back(idx, t, qss->d_val);
+            else if (elem.attributes()->isDouble())
                 m_data.emplace_back(idx, t, elem.getDouble().value());
             else if (elem.attributes()->isInteger())
                 m_data.emplace_back(idx, t, elem.getInteger().value());
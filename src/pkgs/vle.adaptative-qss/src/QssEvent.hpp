@@ -0,0 +1,332 @@
+/*
+ * Copyright 2016-2017 INRA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.  You may
+ * obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.  See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef VLE_ADAPTATIVE_QSS_QSSEVENT_HPP
+#define VLE_ADAPTATIVE_QSS_QSSEVENT_HPP
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include <vle/devs/Dynamics.hpp>
+#include <vle/devs/ExternalEventList.hpp>
+#include <vle/utils/Exception.hpp>
+#include <vle/utils/Symbol.hpp>
+#include <vle/value/Double.hpp>
+#include <vle/value/Map.hpp>
+#include <vle/value/User.hpp>
+
+namespace qss {
+
+/**
+ * QssEvent is the fixed-layout payload exchanged between the models of
+ * this package. A value event carries the "d_val" of an Integrator, an
+ * Adder, a Mult or a Generator, a quanta event carries the "up" and
+ * "down" thresholds of an AdaptativeQuantifier. Reading it costs a type
+ * check instead of the string lookups of a value::Map.
+ *
+ * Written into a file or a string, a QssEvent looks like the value::Map
+ * it replaces.
+ */
+class QssEvent : public vle::value::User
+{
+public:
+    /** Identifier returned by id(), "QSSEVENT" in ASCII. */
+    static constexpr size_t identifier = 0x5153534556454e54;
+
+    enum Kind { VALUE, QUANTA };
+
+    explicit QssEvent(double value)
+      : kind(VALUE)
+      , d_val(value)
+      , up(value)
+      , down(value)
+    {
+    }
+
+    QssEvent(double upthreshold, double downthreshold)
+      : kind(QUANTA)
+      , d_val(upthreshold)
+      , up(upthreshold)
+      , down(downthreshold)
+    {
+    }
+
+    QssEvent(const QssEvent& other) = default;
+
+    ~QssEvent() override = default;
+
+    size_t id() const override
+    {
+        return identifier;
+    }
+
+    std::unique_ptr<vle::value::Value> clone() const override
+    {
+        return std::unique_ptr<vle::value::Value>(new QssEvent(*this));
+    }
+
+    void writeFile(std::ostream& out) const override
+    {
+        toMap()->writeFile(out);
+    }
+
+    void writeString(std::ostream& out) const override
+    {
+        toMap()->writeString(out);
+    }
+
+    void writeXml(std::ostream& out) const override
+    {
+        toMap()->writeXml(out);
+    }
+
+    /**
+     * Build the value::Map sent by the previous versions of the package.
+     */
+    std::unique_ptr<vle::value::Map> toMap() const
+    {
+        auto ret = std::unique_ptr<vle::value::Map>(new vle::value::Map());
+
+        if (kind == VALUE) {
+            ret->addDouble("d_val", d_val);
+        } else {
+            ret->addDouble("up", up);
+            ret->addDouble("down", down);
+        }
+
+        return ret;
+    }
+
+    Kind kind;
+    double d_val;
+    double up;
+    double down;
+};
+
+/**
+ * Return the QssEvent attached to the event or nullptr if the event
+ * carries another value. The identifier is tested instead of a
+ * dynamic_cast because each model is built into its own hidden-visibility
+ * plug-in.
+ */
+inline const QssEvent*
+to_qss_event(const vle::devs::ExternalEvent& event) noexcept
+{
+    const auto& attributes = event.attributes();
+
+    if (attributes and attributes->isUser() and
+        attributes->toUser().id() == QssEvent::identifier)
+        return static_cast<const QssEvent*>(attributes.get());
+
+    return nullptr;
+}
+
+/**
+ * Read the scalar value of an event: the d_val of a QssEvent, a
+ * value::Double or the "d_val" (otherwise the first) key of a value::Map.
+ */
+inline double
+get_value(const vle::devs::ExternalEvent& event)
+{
+    if (const auto* qss = to_qss_event(event))
+        return qss->d_val;
+
+    if (event.attributes()->isDouble())
+        return event.getDouble().value();
+
+    const auto& map = event.getMap();
+    auto it = map.find("d_val");
+    if (it == map.end())
+        it = map.begin();
+
+    if (it == map.end())
+        throw vle::utils::ModellingError("Empty map received on port %s",
+                                         event.getPortName().c_str());
+
+    return vle::value::toDouble(it->second);
+}
+
+/**
+ * Read the thresholds of a quanta event: a QssEvent or a value::Map with
+ * "up" and "down" keys.
+ */
+inline void
+get_quanta(const vle::devs::ExternalEvent& event, double& up, double& down)
+{
+    if (const auto* qss = to_qss_event(event)) {
+        up = qss->up;
+        down = qss->down;
+    } else {
+        up = event.getMap().getDouble("up");
+        down = event.getMap().getDouble("down");
+    }
+}
+
+/**
+ * Push a value event on the port. If @e typed is false the value::Map
+ * {"d_val": value} is sent instead of a QssEvent.
+ */
+inline void
+add_value(vle::devs::ExternalEventList& output,
+          const std::string& port,
+          double value,
+          bool typed)
+{
+    output.emplace_back(port);
+
+    if (typed)
+        output.back().attributes() = std::make_shared<QssEvent>(value);
+    else
+        output.back().addMap().addDouble("d_val", value);
+}
+
+/**
+ * Push a quanta event on the port. If @e typed is false the value::Map
+ * {"up": up, "down": down} is sent instead of a QssEvent.
+ */
+inline void
+add_quanta(vle::devs::ExternalEventList& output,
+           const std::string& port,
+           double up,
+           double down,
+           bool typed)
+{
+    output.emplace_back(port);
+
+    if (typed) {
+        output.back().attributes() = std::make_shared<QssEvent>(up, down);
+    } else {
+        auto& m = output.back().addMap();
+        m.addDouble("up", up);
+        m.addDouble("down", down);
+    }
+}
+
+/**
+ * Read the "typed_events" condition shared by the models of the package.
+ * Typed events are used by default, the value::Map payloads of the
+ * previous versions are sent when the condition is false.
+ */
+inline bool
+use_typed_events(const vle::devs::InitEventList& events)
+{
+    if (events.exist("typed_events"))
+        return vle::value::toBoolean(events.get("typed_events"));
+
+    return true;
+}
+
+/**
+ * Resolves input port names into indices once, in the constructor of a
+ * model, so that transitions work on vectors indexed by port id instead
+ * of std::map<std::string, double>. The ports of the events are found by
+ * the identifier of their interned name, without string comparison.
+ */
+class PortIndex
+{
+public:
+    /**
+     * Add a port, build() must be called once all the ports are added.
+     */
+    void add(const std::string& port)
+    {
+        m_names.emplace_back(port);
+    }
+
+    /**
+     * Sort the ports and index the identifiers of their interned names.
+     */
+    void build()
+    {
+        std::sort(m_names.begin(), m_names.end());
+
+        m_symbols.clear();
+        for (std::size_t id = 0; id != m_names.size(); ++id)
+            m_symbols.emplace_back(vle::utils::Symbol(m_names[id]).id(), id);
+
+        std::sort(m_symbols.begin(), m_symbols.end());
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_names.size();
+    }
+
+    const std::string& name(std::size_t id) const noexcept
+    {
+        return m_names[id];
+    }
+
+    /**
+     * Return the id of the port or size() if the port is unknown.
+     */
+    std::size_t find(const std::string& port) const noexcept
+    {
+        auto it = std::lower_bound(m_names.begin(), m_names.end(), port);
+
+        if (it != m_names.end() and *it == port)
+            return std::distance(m_names.begin(), it);
+
+        return m_names.size();
+    }
+
+    /**
+     * Return the id of the port of an event or size() if the port is
+     * unknown.
+     */
+    std::size_t find(const vle::utils::Symbol& port) const noexcept
+    {
+        auto it = std::lower_bound(
+          m_symbols.begin(),
+          m_symbols.end(),
+          port.id(),
+          [](const std::pair<vle::utils::Symbol::id_type, std::size_t>& elem,
+             vle::utils::Symbol::id_type id) { return elem.first < id; });
+
+        if (it != m_symbols.end() and it->first == port.id())
+            return it->second;
+
+        return m_names.size();
+    }
+
+    /**
+     * Return the id of the port of an event or throw a ModellingError if
+     * the port is not indexed (an unknown or unconnected port).
+     */
+    std::size_t get(const vle::devs::ExternalEvent& event,
+                    const std::string& model) const
+    {
+        auto id = find(event.getPort());
+
+        if (id == m_names.size())
+            throw vle::utils::ModellingError(
+              "%s: event on the unconnected input port %s",
+              model.c_str(),
+              event.getPortName().c_str());
+
+        return id;
+    }
+
+private:
+    std::vector<std::string> m_names;
+    std::vector<std::pair<vle::utils::Symbol::id_type, std::size_t>>
+      m_symbols;
+};
+
+} // namespace qss
+
+#endif
@@ -0,0 +1,482 @@
+/*
+ * Copyright 2016-2017 INRA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.  You may
+ * obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied.  See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "QssEvent.hpp"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+#include <vle/devs/Dynamics.hpp>
+#include <vle/utils/Exception.hpp>
+#include <vle/value/Map.hpp>
+#include <vle/value/Set.hpp>
+#include <vle/value/Tuple.hpp>
+
+namespace vd = vle::devs;
+namespace vv = vle::value;
+namespace vu = vle::utils;
+
+/**
+ * QssSystem integrates N state variables of the affine system
+ * dX/dt = A.Q + C inside a single atomic model with the QSS1 method. It
+ * replaces the Integrator/AdaptativeQuantifier/Adder network (without
+ * adaptative offsets). The network spreads its configuration over one
+ * condition per atomic model; a single model can not read it as is, so
+ * the QssSystem conditions keep the same names but gather the values of
+ * all the variables:
+ *
+ * - variables: a set of string, the names of the state variables (the
+ *   Integrator models of the network).
+ * - X_0: a map (variable name, initial value), 0 if missing. The X_0
+ *   double of each Integrator.
+ * - quantum: a double for all variables or a map (variable name,
+ *   quantum), 0.1 if missing. The quantum of each AdaptativeQuantifier.
+ * - allow_offsets: a boolean, must be false if provided (the adaptative
+ *   offsets of AdaptativeQuantifier are not supported).
+ * - zero_init_offset: a boolean, see AdaptativeQuantifier.
+ * - weights: a map (variable name, map (input variable name, weight))
+ *   to build the row of A for each derivative. The weights map of the
+ *   Adder connected to the X_dot port of each Integrator, keyed by
+ *   variable instead of input port.
+ * - constants: a map (variable name, value) to build C, the Constant
+ *   models connected to these Adder.
+ * - typed_events: a boolean, false to send value::Map instead of
+ *   qss::QssEvent (see QssEvent.hpp).
+ *
+ * An input port must be named like a variable: an event on this port
+ * replaces the constant of the variable, like a Constant or a Generator
+ * connected with the weight 1 to the Adder of the variable.
+ *
+ * States are stored as structure of arrays and the quantisation and the
+ * derivative updates are loops over contiguous buffers of double. For
+ * each output port named like a variable, a "d_val" event is sent each
+ * time the quantized value changes. Observation on a port named
+ * like a variable returns its current value, any other port returns a
+ * tuple of all current values.
+ */
+class QssSystem : public vd::Dynamics
+{
+public:
+    QssSystem(const vd::DynamicsInit& init, const vd::InitEventList& events)
+      : vd::Dynamics(init, events)
+      , m_typed_events(qss::use_typed_events(events))
+    {
+        const auto& variables = events.getSet("variables");
+        m_size = variables.size();
+
+        if (m_size == 0)
+            throw vu::ModellingError("QssSystem %s without variables",
+                                     getModelName().c_str());
+
+        m_names.reserve(m_size);
+        for (std::size_t i = 0; i != m_size; ++i) {
+            m_names.emplace_back(variables.getString(i));
+            if (not m_index.emplace(m_names.back(), i).second)
+                throw vu::ModellingError("QssSystem %s: variable %s defined "
+                                         "twice",
+                                         getModelName().c_str(),
+                                         m_names.back().c_str());
+        }
+
+        m_x.assign(m_size, 0.0);
+        m_q.assign(m_size, 0.0);
+        m_dx.assign(m_size, 0.0);
+        m_c.assign(m_size, 0.0);
+        m_up.assign(m_size, 0.0);
+        m_down.assign(m_size, 0.0);
+        m_quantum.assign(m_size, 0.1);
+        m_tn.assign(m_size, vd::infinity);
+        m_has_output.assign(m_size, 0);
+
+        if (events.exist("X_0"))
+            read_per_variable(events.getMap("X_0"), m_x, "X_0");
+
+        if (events.exist("quantum")) {
+            const auto& quantum = events.get("quantum");
+            if (quantum->isMap())
+                read_per_variable(quantum->toMap(), m_quantum, "quantum");
+            else
+                std::fill(
+                  m_quantum.begin(), m_quantum.end(), vv::toDouble(quantum));
+        }
+
+        for (std::size_t i = 0; i != m_size; ++i)
+            if (0 >= m_quantum[i])
+                throw vu::ModellingError("Bad quantum value for %s "
+                                         "(provided value : %f, should be "
+                                         "strictly positive)",
+                                         m_names[i].c_str(),
+                                         m_quantum[i]);
+
+        if (events.exist("allow_offsets") and
+            events.getBoolean("allow_offsets"))
+            throw vu::ModellingError("QssSystem %s: adaptative offsets are "
+                                     "not supported",
+                                     getModelName().c_str());
+
+        m_zero_init_offset = false;
+        if (events.exist("zero_init_offset"))
+            m_zero_init_offset = events.getBoolean("zero_init_offset");
+
+        if (events.exist("constants"))
+            read_per_variable(events.getMap("constants"), m_c, "constants");
+
+        build_weights(events);
+
+        for (const auto& elem : getModel().getInputPortList()) {
+            if (m_index.find(elem.first) == m_index.end())
+                throw vu::ModellingError("QssSystem %s: input port %s is "
+                                         "not a variable",
+                                         getModelName().c_str(),
+                                         elem.first.c_str());
+
+            m_inputs.add(elem.first);
+        }
+
+        m_inputs.build();
+        for (std::size_t id = 0; id != m_inputs.size(); ++id)
+            m_input_variables.emplace_back(m_index[m_inputs.name(id)]);
+
+        for (const auto& elem : getModel().getOutputPortList()) {
+            auto it = m_index.find(elem.first);
+            if (it != m_index.end())
+                m_has_output[it->second] = 1;
+        }
+    }
+
+    virtual ~QssSystem()
+    {
+    }
+
+    virtual vd::Time init(vd::Time time) override
+    {
+        m_last_time = time;
+
+        for (std::size_t i = 0; i != m_size; ++i) {
+            double step = std::floor(m_x[i] / m_quantum[i]);
+            double offset =
+              m_zero_init_offset ? 0.0 : m_x[i] - step * m_quantum[i];
+
+            m_q[i] = m_x[i];
+            m_up[i] = offset + m_quantum[i] * (step + 1);
+            m_down[i] = offset + m_quantum[i] * (step - 1);
+        }
+
+        m_state = INIT;
+        return 0;
+    }
+
+    virtual void output(vd::Time /*time*/,
+                        vd::ExternalEventList& output) const override
+    {
+        if (m_state == INIT) {
+            for (std::size_t i = 0; i != m_size; ++i)
+                if (m_has_output[i])
+                    emit(output, i, m_q[i]);
+        } else {
+            for (auto i : m_imminent)
+                if (m_has_output[i])
+                    emit(output, i, threshold(i));
+        }
+    }
+
+    virtual vd::Time timeAdvance() const override
+    {
+        return m_next_time - m_last_time;
+    }
+
+    virtual void internalTransition(vd::Time time) override
+    {
+        advance(time);
+
+        if (m_state == INIT) {
+            m_state = RUNNING;
+            update_derivatives(true);
+        } else {
+            for (auto i : m_imminent) {
+                double value = threshold(i);
+
+                m_x[i] = value;
+                m_q[i] = value;
+                m_up[i] = value + m_quantum[i];
+                m_down[i] = value - m_quantum[i];
+            }
+            update_derivatives(false);
+        }
+
+        update_next_times(time);
+    }
+
+    virtual void externalTransition(const vd::ExternalEventList& events,
+                                    vd::Time time) override
+    {
+        advance(time);
+
+        m_rows.clear();
+        for (const auto& event : events) {
+            auto r = m_input_variables[m_inputs.get(event, getModelName())];
+
+            m_c[r] = qss::get_value(event);
+            if (not m_dirty[r]) {
+                m_dirty[r] = 1;
+                m_rows.emplace_back(r);
+            }
+        }
+
+        if (m_state == INIT) {
+            // The internal transition of the initialization computes all
+            // the derivatives at the same date.
+            for (auto r : m_rows)
+                m_dirty[r] = 0;
+            m_next_time = time;
+            return;
+        }
+
+        compute_derivatives();
+        update_next_times(time);
+    }
+
+    std::unique_ptr<vv::Value> observation(
+      const vd::ObservationEvent& event) const override
+    {
+        auto it = m_index.find(event.getPortName());
+        vd::Time time = event.getTime();
+
+        if (it != m_index.end())
+            return vv::Double::create(current_value(it->second, time));
+
+        auto t = std::unique_ptr<vv::Tuple>(new vv::Tuple(m_size));
+        for (std::size_t i = 0; i != m_size; ++i)
+            t->value()[i] = current_value(i, time);
+
+        return t;
+    }
+
+private:
+    typedef enum { INIT, RUNNING } State;
+    State m_state;
+
+    std::size_t m_size;
+    std::vector<std::string> m_names;
+    bool m_typed_events;
+    std::unordered_map<std::string, std::size_t> m_index;
+
+    std::vector<double> m_x;       // value at m_last_time.
+    std::vector<double> m_q;       // quantized value.
+    std::vector<double> m_dx;      // derivative computed from m_q.
+    std::vector<double> m_c;       // constant part of the derivative.
+    std::vector<double> m_up;      // upper threshold.
+    std::vector<double> m_down;    // lower threshold.
+    std::vector<double> m_quantum; // quantum size.
+    std::vector<vd::Time> m_tn;    // absolute date of the next crossing.
+    std::vector<unsigned char> m_has_output;
+
+    // The input ports and the variable of each input port.
+    qss::PortIndex m_inputs;
+    std::vector<std::size_t> m_input_variables;
+
+    // Compressed sparse rows of A and compressed sparse columns to find
+    // the derivatives that depend on a changed quantized value.
+    std::vector<std::size_t> m_row_ptr;
+    std::vector<std::size_t> m_col_index;
+    std::vector<double> m_weights;
+    std::vector<std::size_t> m_col_ptr;
+    std::vector<std::size_t> m_row_index;
+
+    std::vector<std::size_t> m_imminent;
+    std::vector<std::size_t> m_rows;
+    std::vector<unsigned char> m_dirty;
+
+    vd::Time m_last_time;
+    vd::Time m_next_time;
+    bool m_zero_init_offset;
+
+    void read_per_variable(const vv::Map& map,
+                           std::vector<double>& out,
+                           const char* condition) const
+    {
+        for (const auto& elem : map) {
+            auto it = m_index.find(elem.first);
+            if (it == m_index.end())
+                throw vu::ModellingError("QssSystem %s: unknown variable %s "
+                                         "in %s",
+                                         getModelName().c_str(),
+                                         elem.first.c_str(),
+                                         condition);
+
+            out[it->second] = vv::toDouble(elem.second);
+        }
+    }
+
+    void build_weights(const vd::InitEventList& events)
+    {
+        std::vector<std::vector<std::pair<std::size_t, double>>> rows(m_size);
+
+        if (events.exist("weights")) {
+            for (const auto& elem : events.getMap("weights")) {
+                auto row = m_index.find(elem.first);
+                if (row == m_index.end())
+                    throw vu::ModellingError("QssSystem %s: unknown variable "
+                                             "%s in weights",
+                                             getModelName().c_str(),
+                                             elem.first.c_str());
+
+                for (const auto& input : elem.second->toMap()) {
+                    auto col = m_index.find(input.first);
+                    if (col == m_index.end())
+                        throw vu::ModellingError("QssSystem %s: unknown "
+                                                 "variable %s in weights",
+                                                 getModelName().c_str(),
+                                                 input.first.c_str());
+
+                    rows[row->second].emplace_back(
+                      col->second, vv::toDouble(input.second));
+                }
+            }
+        }
+
+        m_row_ptr.assign(1, 0);
+        std::vector<std::size_t> col_count(m_size, 0);
+
+        for (auto& row : rows) {
+            std::sort(row.begin(), row.end());
+            for (const auto& elem : row) {
+                m_col_index.emplace_back(elem.first);
+                m_weights.emplace_back(elem.second);
+                ++col_count[elem.first];
+            }
+            m_row_ptr.emplace_back(m_col_index.size());
+        }
+
+        m_col_ptr.assign(m_size + 1, 0);
+        for (std::size_t i = 0; i != m_size; ++i)
+            m_col_ptr[i + 1] = m_col_ptr[i] + col_count[i];
+
+        m_row_index.resize(m_col_index.size());
+        std::vector<std::size_t> fill(m_col_ptr.begin(), m_col_ptr.end() - 1);
+        for (std::size_t r = 0; r != m_size; ++r)
+            for (std::size_t k = m_row_ptr[r]; k != m_row_ptr[r + 1]; ++k)
+                m_row_index[fill[m_col_index[k]]++] = r;
+
+        m_dirty.assign(m_size, 0);
+    }
+
+    void emit(vd::ExternalEventList& output,
+              std::size_t i,
+              double value) const
+    {
+        qss::add_value(output, m_names[i], value, m_typed_events);
+    }
+
+    /**
+     * Returns the threshold reached by the variable \e i at its next time.
+     */
+    double threshold(std::size_t i) const
+    {
+        return m_dx[i] > 0 ? m_up[i] : m_down[i];
+    }
+
+    double current_value(std::size_t i, vd::Time time) const
+    {
+        return m_x[i] + m_dx[i] * (time - m_last_time);
+    }
+
+    /**
+     * Moves all the state variables to \e time. This loop has no
+     * dependency between iterations and is vectorized by the compiler.
+     */
+    void advance(vd::Time time)
+    {
+        const double elapsed = time - m_last_time;
+        double* x = m_x.data();
+        const double* dx = m_dx.data();
+
+        for (std::size_t i = 0; i < m_size; ++i)
+            x[i] += dx[i] * elapsed;
+
+        m_last_time = time;
+    }
+
+    /**
+     * Recomputes all the derivatives if \e all is true, otherwise only
+     * the derivatives that depend on the imminent variables.
+     */
+    void update_derivatives(bool all)
+    {
+        m_rows.clear();
+
+        if (all) {
+            for (std::size_t i = 0; i != m_size; ++i)
+                m_rows.emplace_back(i);
+        } else {
+            for (auto i : m_imminent) {
+                for (auto k = m_col_ptr[i]; k != m_col_ptr[i + 1]; ++k) {
+                    auto r = m_row_index[k];
+                    if (not m_dirty[r]) {
+                        m_dirty[r] = 1;
+                        m_rows.emplace_back(r);
+                    }
+                }
+            }
+        }
+
+        compute_derivatives();
+    }
+
+    /**
+     * Recomputes the derivatives of the rows stored into \e m_rows.
+     */
+    void compute_derivatives()
+    {
+        for (auto r : m_rows) {
+            double sum = m_c[r];
+            for (auto k = m_row_ptr[r]; k != m_row_ptr[r + 1]; ++k)
+                sum += m_weights[k] * m_q[m_col_index[k]];
+
+            m_dx[r] = sum;
+            m_dirty[r] = 0;
+        }
+    }
+
+    /**
+     * Computes for each variable the date of the next threshold crossing
+     * and stores into \e m_imminent the variables that cross first.
+     */
+    void update_next_times(vd::Time time)
+    {
+        const double* x = m_x.data();
+        const double* dx = m_dx.data();
+        const double* up = m_up.data();
+        const double* down = m_down.data();
+        vd::Time* tn = m_tn.data();
+
+        for (std::size_t i = 0; i < m_size; ++i) {
+            double distance = dx[i] > 0 ? up[i] - x[i] : down[i] - x[i];
+            double sigma = dx[i] != 0 ? distance / dx[i] : vd::infinity;
+            tn[i] = time + std::max(sigma, 0.0);
+        }
+
+        m_next_time = *std::min_element(m_tn.begin(), m_tn.end());
+
+        m_imminent.clear();
+        if (not vd::isInfinity(m_next_time))
+            for (std::size_t i = 0; i != m_size; ++i)
+                if (tn[i] == m_next_time)
+                    m_imminent.emplace_back(i);
+    }
+};
+
+DECLARE_DYNAMICS(QssSystem)
@@ -30,6 +30,7 @@
 #include <vle/oov/Plugin.hpp>
 #include <vle/utils/DateTime.hpp>
 #include <vle/utils/Exception.hpp>
+#include <vle/utils/Trace.hpp>
 #include <vle/value/Double.hpp>
 #include <vle/value/Map.hpp>
 #include <vle/value/Set.hpp>
@@ -175,6 +176,8 @@ public:
                          const double& time,
                          std::unique_ptr<value::Value> value) override
     {
+        vle_trace_scope("vle.output", "console value");
+
         std::string name(buildname(parent, simulator, port));
         Columns::iterator it;
 
@@ -215,6 +218,8 @@ public:
 
     std::unique_ptr<value::Matrix> finish(const double& time) override
     {
+        vle_trace_scope("vle.output", "console finish");
+
         finalFlush(time);
 
         if (mHeader) {
@@ -30,10 +30,14 @@
 #include <boost/format.hpp>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <vle/utils/DateTime.hpp>
 #include <vle/utils/Exception.hpp>
 #include <vle/utils/Filesystem.hpp>
+#include <vle/utils/Trace.hpp>
+#include <vle/value/Boolean.hpp>
 #include <vle/value/Double.hpp>
+#include <vle/value/Integer.hpp>
 #include <vle/value/Map.hpp>
 #include <vle/value/String.hpp>
 
@@ -209,6 +213,8 @@ File::onValue(const std::string& simulator,
               const double& time,
               std::unique_ptr<value::Value> value)
 {
+    vle_trace_scope("vle.output", "file value");
+
     std::string name(buildname(parent, simulator, port));
     Columns::iterator it;
 
@@ -248,6 +254,8 @@ File::onValue(const std::string& simulator,
 std::unique_ptr<value::Matrix>
 File::finish(const double& time)
 {
+    vle_trace_scope("vle.output", "file finish");
+
     // build the final file
     finalFlush(time);
     std::vector<std::string> array(m_columns.size());
@@ -270,9 +278,72 @@ File::finish(const double& time)
     return {};
 }
 
+std::unique_ptr<value::Value>
+File::checkpoint()
+{
+    m_file.flush();
+
+    std::ifstream tmpfile(m_filenametmp.c_str(), std::ios::binary);
+    std::ostringstream content;
+    content << tmpfile.rdbuf();
+
+    auto state = std::make_unique<value::Map>();
+    state->addString("file", content.str());
+    state->add("buffer", m_buffer.clone());
+    state->addDouble("time", m_time);
+    state->addBoolean("start", m_isstart);
+    state->addBoolean("first-event", m_havefirstevent);
+
+    auto& columns = state->addMap("columns");
+    for (const auto& elem : m_columns)
+        columns.addInt(elem.first, elem.second);
+
+    auto& watcher = state->addMap("new-bag");
+    for (const auto& elem : m_newbagwatcher)
+        watcher.addDouble(elem.first, elem.second);
+
+    auto& valid = state->addSet("valid");
+    for (bool elem : m_valid)
+        valid.addBoolean(elem);
+
+    return state;
+}
+
+void
+File::restore(const value::Value& state)
+{
+    const auto& map = state.toMap();
+
+    m_file.close();
+    m_file.open(m_filenametmp.c_str(), std::ios::trunc);
+    m_file << map.getString("file");
+
+    m_buffer.clear();
+    for (const auto& elem : map.getSet("buffer"))
+        m_buffer.add(elem ? elem->clone() : std::unique_ptr<value::Value>());
+
+    m_time = map.getDouble("time");
+    m_isstart = map.getBoolean("start");
+    m_havefirstevent = map.getBoolean("first-event");
+
+    m_columns.clear();
+    for (const auto& elem : map.getMap("columns"))
+        m_columns[elem.first] = value::toInteger(elem.second);
+
+    m_newbagwatcher.clear();
+    for (const auto& elem : map.getMap("new-bag"))
+        m_newbagwatcher[elem.first] = value::toDouble(elem.second);
+
+    m_valid.clear();
+    for (const auto& elem : map.getSet("valid"))
+        m_valid.push_back(value::toBoolean(elem));
+}
+
 void
 File::flush()
 {
+    vle_trace_scope("vle.output", "file flush");
+
     if (m_valid.empty() or
         std::find(m_valid.begin(), m_valid.end(), true) != m_valid.end()) {
         m_file << m_time;
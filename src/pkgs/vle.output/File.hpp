@@ -109,6 +109,15 @@ public:
 
     virtual std::unique_ptr<value::Matrix> finish(const double& time) override;
 
+    /**
+     * @brief The checkpoint stores the content of the temporary file and
+     * the buffer of the current line. restore() rewrites the temporary
+     * file emptied by onParameter().
+     */
+    virtual std::unique_ptr<value::Value> checkpoint() override;
+
+    virtual void restore(const value::Value& state) override;
+
     class FileType
     {
     public:
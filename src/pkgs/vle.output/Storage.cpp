@@ -31,7 +31,9 @@
 #include <vector>
 #include <vle/devs/Time.hpp>
 #include <vle/oov/Plugin.hpp>
+#include <vle/utils/Trace.hpp>
 #include <vle/value/Double.hpp>
+#include <vle/value/Integer.hpp>
 #include <vle/value/Map.hpp>
 #include <vle/value/Matrix.hpp>
 #include <vle/value/String.hpp>
@@ -165,6 +167,8 @@ public:
         Index idx = m_matrix->columns();
 
         m_colAccess.insert(std::make_pair(key, m_matrix->columns()));
+        m_keys.push_back(key);
+        m_columns.push_back(idx);
 
         m_matrix->addColumn();
 
@@ -191,6 +195,8 @@ public:
                          const double& time,
                          std::unique_ptr<value::Value> value) override
     {
+        vle_trace_scope("vle.output", "storage value");
+
         nextTime(time);
 
         if (not simulator.empty()) {
@@ -201,15 +207,86 @@ public:
         }
     }
 
+    virtual bool batch() const override
+    {
+        return true;
+    }
+
+    virtual void onValues(
+      const double& time,
+      const std::string& /*view*/,
+      const std::vector<std::size_t>& observables,
+      std::vector<std::unique_ptr<value::Value>>& values) override
+    {
+        vle_trace_scope("vle.output", "storage values");
+
+        nextTime(time);
+
+        const auto row = m_matrix->rows() - 1;
+        for (std::size_t i = 0, e = observables.size(); i != e; ++i)
+            m_matrix->set(
+              m_columns[observables[i]], row, std::move(values[i]));
+    }
+
+    virtual void onDoubles(const double& time,
+                           const std::string& /*view*/,
+                           const std::vector<std::size_t>& observables,
+                           const std::vector<double>& values) override
+    {
+        vle_trace_scope("vle.output", "storage doubles");
+
+        nextTime(time);
+
+        const auto row = m_matrix->rows() - 1;
+        for (std::size_t i = 0, e = observables.size(); i != e; ++i)
+            m_matrix->set(m_columns[observables[i]],
+                          row,
+                          value::Double::create(values[i]));
+    }
+
     virtual std::unique_ptr<value::Matrix> finish(
       const double& /*time*/) override
     {
+        vle_trace_scope("vle.output", "storage finish");
+
         return std::move(m_matrix);
     }
 
+    virtual std::unique_ptr<value::Value> checkpoint() override
+    {
+        auto state = std::make_unique<value::Map>();
+
+        state->add("matrix", matrix());
+        state->addDouble("time", m_time);
+
+        auto& columns = state->addMap("columns");
+        for (const auto& elem : m_colAccess)
+            columns.addInt(elem.first, static_cast<int32_t>(elem.second));
+
+        return state;
+    }
+
+    virtual void restore(const value::Value& state) override
+    {
+        const auto& map = state.toMap();
+
+        m_matrix.reset(new value::Matrix(map.getMatrix("matrix")));
+        m_time = map.getDouble("time");
+
+        m_colAccess.clear();
+        for (const auto& elem : map.getMap("columns"))
+            m_colAccess.emplace(
+              elem.first, static_cast<Index>(value::toInteger(elem.second)));
+
+        for (std::size_t i = 0, e = m_keys.size(); i != e; ++i)
+            m_columns[i] = m_colAccess[m_keys[i]];
+    }
+
 private:
     std::unique_ptr<value::Matrix> m_matrix;
     MapPairIndex m_colAccess;
+    std::vector<std::string> m_keys;  /**< The key of each observable. */
+    std::vector<Index> m_columns;     /**< The column of each observable. */
     double m_time;
     StorageHeaderType m_headertype;
 
@@ -25,8 +25,12 @@
  */
 
 #include "Thread.hpp"
+#include <algorithm>
 #include <boost/bind.hpp>
 #include <functional>
+#include <iterator>
+#include <limits>
+#include <tuple>
 #include <vle/devs/Coordinator.hpp>
 #include <vle/devs/Dynamics.hpp>
 #include <vle/devs/ExternalEvent.hpp>
@@ -35,8 +39,18 @@
 #include <vle/devs/Simulator.hpp>
 #include <vle/utils/ContextPrivate.hpp>
 #include <vle/utils/Exception.hpp>
+#include <vle/utils/Memory.hpp>
 #include <vle/utils/Tools.hpp>
+#include <vle/utils/Trace.hpp>
 #include <vle/utils/i18n.hpp>
+#include <vle/value/Binary.hpp>
+#include <vle/value/Boolean.hpp>
+#include <vle/value/Double.hpp>
+#include <vle/value/Map.hpp>
+#include <vle/value/Null.hpp>
+#include <vle/value/Set.hpp>
+#include <vle/value/String.hpp>
+#include <vle/value/Tuple.hpp>
 #include <vle/vpz/AtomicModel.hpp>
 #include <vle/vpz/BaseModel.hpp>
 #include <vle/vpz/CoupledModel.hpp>
@@ -46,218 +60,1383 @@ using std::map;
 using std::string;
 using std::pair;
 
-namespace {
+namespace vle {
+namespace devs {
+
+Coordinator::Coordinator(utils::ContextPtr context,
+                         const vpz::Dynamics& dyn,
+                         const vpz::Classes& cls,
+                         const vpz::Experiment& experiment)
+  : m_context(context)
+  , m_timebase(experiment.tick())
+  , m_currentTime(0.0)
+  , m_simulators_thread_pool(m_context)
+  , m_next_index(0)
+  , m_modelFactory(context, m_eventViewList, dyn, cls, experiment)
+  , m_restore(nullptr)
+  , m_isStarted(false)
+  , m_optimistic(false)
+{
+    m_eventTable.setTimeBase(m_timebase);
+    m_timed_observation_scheduler.setTimeBase(m_timebase);
+}
+
+void
+Coordinator::init(const vpz::Model& mdls, Time current, Time duration)
+{
+    vle_trace_scope("kernel", "init");
+
+    m_currentTime = current;
+    m_durationTime = duration;
+    buildViews();
+
+    if (m_channel)
+        buildDistribution(mdls);
+
+    addModels(mdls);
+    m_isStarted = true;
+
+    if (m_channel) {
+        for (const auto& elem : m_simulators)
+            if (elem->dynamics()->isExecutive())
+                throw utils::NotYetImplemented(
+                  _("Simulation kernel: the executive '%s' is not available "
+                    "in a distributed simulation"),
+                  elem->getStructure()->getCompleteName().c_str());
+
+        exchangeRecords();
+    } else {
+        buildPartitions(mdls);
+    }
+
+    m_eventTable.init(current);
+}
+
+/**
+ * Sort the simulators of the bag according to their position in the
+ * checkpoint.
+ */
+static void
+reorder(std::vector<Simulator*>& simulators,
+        const std::map<std::string, std::size_t>& positions)
+{
+    std::vector<std::pair<std::size_t, Simulator*>> order;
+    order.reserve(simulators.size());
+
+    for (auto* elem : simulators) {
+        auto it = positions.find(elem->getStructure()->getCompleteName());
+        order.emplace_back(
+          it == positions.end() ? positions.size() : it->second, elem);
+    }
+
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [](const std::pair<std::size_t, Simulator*>& lhs,
+                        const std::pair<std::size_t, Simulator*>& rhs) {
+                         return lhs.first < rhs.first;
+                     });
+
+    for (std::size_t i = 0, e = order.size(); i != e; ++i)
+        simulators[i] = order[i].second;
+}
+
+void
+Coordinator::restore(const vpz::Model& mdls,
+                     const value::Map& state,
+                     Time duration)
+{
+    vle_trace_scope("kernel", "restore");
+
+    if (m_channel)
+        throw utils::NotYetImplemented(
+          _("Restore: not available with a distributed simulation"));
+
+    m_currentTime = state.getDouble("time");
+    m_durationTime = duration;
+    buildViews();
+
+    m_restore = &state.getMap("models");
+    try {
+        addModels(mdls);
+    } catch (...) {
+        m_restore = nullptr;
+        throw;
+    }
+    m_restore = nullptr;
+    m_isStarted = true;
+
+    //
+    // addModels() pushes the simulators in the order of the models, the
+    // simulators get their index and their insertion sequence of the
+    // checkpoint.
+    //
+    const auto& models = state.getMap("models");
+    for (const auto& elem : m_simulators) {
+        auto it = models.find(elem->getStructure()->getCompleteName());
+        const auto& model = it->second->toMap();
+
+        if (model.exist("index")) {
+            auto index = static_cast<std::uint64_t>(model.getDouble("index"));
+            elem->setIndex(index);
+            m_next_index = std::max(m_next_index, index + 1);
+        }
+
+        if (elem->haveHandle() and model.exist("inserted"))
+            m_eventTable.addInternal(
+              elem.get(),
+              elem->getTn(),
+              m_timebase.toKey(model.getDouble("inserted")));
+    }
+
+    //
+    // buildViews() schedules the timed views at the current time, the
+    // checkpoint gives the next date of observation.
+    //
+    m_timed_observation_scheduler.clear();
+
+    for (const auto& elem : state.getMap("views")) {
+        const auto& view = elem.second->toMap();
+        auto timed = m_timedViewList.find(elem.first);
+        View* ptr = nullptr;
+
+        if (timed != m_timedViewList.end()) {
+            ptr = &timed->second;
+            if (view.exist("next"))
+                m_timed_observation_scheduler.add(ptr,
+                                                  view.getDouble("next"),
+                                                  view.getDouble("timestep"));
+        } else {
+            auto event = m_eventViewList.find(elem.first);
+            if (event == m_eventViewList.end())
+                throw utils::InternalError(
+                  _("Checkpoint: unknown view '%s'"), elem.first.c_str());
+
+            ptr = &event->second;
+        }
+
+        if (view.exist("plugin"))
+            ptr->restore(*view.get("plugin"));
+    }
+
+    m_eventTable.init(m_currentTime);
+
+    std::map<std::string, std::size_t> positions;
+    const auto& bag = state.getSet("bag");
+    for (std::size_t i = 0, e = bag.size(); i != e; ++i)
+        positions.emplace(bag.getString(i), i);
+
+    reorder(m_eventTable.getCurrentBag().dynamics, positions);
+    reorder(m_eventTable.getCurrentBag().executives, positions);
+}
+
+void
+Coordinator::updateConditions(const vpz::Conditions& conditions,
+                              const std::set<std::string>& names)
+{
+    vle_trace_scope("kernel", "update conditions");
+
+    for (const auto& name : names)
+        m_modelFactory.conditions().get(name) = conditions.get(name);
+
+    for (const auto& elem : m_simulators) {
+        const auto& cnds = elem->getStructure()->conditions();
+
+        if (std::none_of(cnds.cbegin(),
+                         cnds.cend(),
+                         [&names](const std::string& cnd) {
+                             return names.count(cnd) > 0;
+                         }))
+            continue;
+
+        elem->dynamics()->updateConditions(
+          ModelFactory::buildInitEventList(m_modelFactory.conditions(), cnds),
+          m_currentTime);
+    }
+}
+
+std::unique_ptr<value::Map>
+Coordinator::checkpoint()
+{
+    vle_trace_scope("kernel", "checkpoint");
+
+    if (not m_partitions.empty())
+        throw utils::NotYetImplemented(
+          _("Checkpoint: not available with partitions"));
+
+    if (m_channel)
+        throw utils::NotYetImplemented(
+          _("Checkpoint: not available with a distributed simulation"));
+
+    auto result = std::make_unique<value::Map>();
+    result->addDouble("time", m_currentTime);
+
+    auto& bag = result->addSet("bag");
+    for (const auto* elem : m_eventTable.getCurrentBag().dynamics)
+        bag.addString(elem->getStructure()->getCompleteName());
+    for (const auto* elem : m_eventTable.getCurrentBag().executives)
+        bag.addString(elem->getStructure()->getCompleteName());
+
+    auto& models = result->addMap("models");
+    for (const auto& elem : m_simulators) {
+        auto& model = models.addMap(elem->getStructure()->getCompleteName());
+        auto state = elem->checkpoint();
+
+        model.addDouble("tn", elem->getTn());
+        model.addDouble("index", static_cast<double>(elem->index()));
+        if (elem->haveHandle())
+            model.addDouble("inserted", m_timebase.toTime(elem->inserted()));
+        model.add("state", state ? std::move(state) : value::Null::create());
+    }
+
+    auto& views = result->addMap("views");
+    for (auto& elem : m_eventViewList) {
+        auto& view = views.addMap(elem.first);
+        auto plugin = elem.second.checkpoint();
+        if (plugin)
+            view.add("plugin", std::move(plugin));
+    }
+
+    for (auto& elem : m_timedViewList) {
+        auto& view = views.addMap(elem.first);
+        auto plugin = elem.second.checkpoint();
+        if (plugin)
+            view.add("plugin", std::move(plugin));
+    }
+
+    for (const auto& elem : m_timed_observation_scheduler.observations()) {
+        for (const auto* timed : elem.mViews) {
+            auto& view = views.getMap(timed->name());
+            view.addDouble("next", elem.mTime);
+            view.addDouble("timestep", elem.mTimestep);
+        }
+    }
+
+    return result;
+}
+
+/*
+ * Send the observations of the @e simulators of a bag to the views in the
+ * order of the indexes of the Simulators. The order of a bag depends on
+ * the order of the external events, the order of the indexes is the same
+ * in the sequential simulation and in the partitions.
+ */
+static void
+runObservations(const std::vector<Simulator*>& simulators,
+                std::vector<Simulator*>& observed,
+                Time time)
+{
+    observed.clear();
+    for (auto* elem : simulators)
+        if (not elem->getObservations().empty())
+            observed.emplace_back(elem);
+
+    std::sort(observed.begin(),
+              observed.end(),
+              [](const Simulator* lhs, const Simulator* rhs) {
+                  return lhs->index() < rhs->index();
+              });
+
+    for (auto* elem : observed) {
+        auto& observations = elem->getObservations();
+        for (auto& obs : observations)
+            obs.view->run(elem->dynamics().get(),
+                          time,
+                          obs.portname,
+                          std::move(obs.value));
+
+        observations.clear();
+    }
+}
+
+void
+Coordinator::run()
+{
+    if (not m_partitions.empty()) {
+        runPartitions();
+        return;
+    }
+
+    if (m_channel) {
+        runDistributed();
+        return;
+    }
+
+    vle_trace_scope("kernel", "bag");
+
+    Bag& bag = m_eventTable.getCurrentBag();
+    if (not bag.dynamics.empty() or not bag.executives.empty())
+        m_currentTime = m_eventTable.getCurrentTime();
+    else
+        vDbg(m_context, "Coordinator::run bag is empty...\n");
+
+    vDbg(m_context, _("-------- BAG [%f] --------\n"), m_currentTime);
+
+    //
+    // Call output functions for all executives and dynamics models then
+    // dispatches external events for all executives and dynamics.
+    //
+
+    const std::size_t nb_dynamics = bag.dynamics.size();
+    const std::size_t nb_executive = bag.executives.size();
+    KernelProfile* profile = m_profile.get();
+
+    if (profile)
+        profile->addBag(nb_dynamics, nb_executive);
+
+    if (nb_dynamics > 0) {
+        {
+            KernelProfileTimer timer(profile, KernelProfile::OUTPUT);
+            vle_trace_scope("kernel", "output");
+            for (std::size_t i = 0; i != nb_dynamics; ++i)
+                bag.dynamics[i]->output(m_currentTime);
+        }
+
+        KernelProfileTimer timer(profile, KernelProfile::DISPATCH);
+        vle_trace_scope("kernel", "dispatch");
+        dispatchExternalEvent(bag.dynamics, nb_dynamics);
+    }
+
+    //
+    // The external events of the dynamics can add executives to the bag:
+    // the fast path is used only if the bag remains without executive.
+    //
+    if (bag.executives.empty() and m_eventViewList.empty() and not profile) {
+        runDynamics(bag);
+        return;
+    }
+
+    if (nb_executive > 0) {
+        {
+            KernelProfileTimer timer(profile, KernelProfile::OUTPUT);
+            vle_trace_scope("kernel", "output");
+            for (std::size_t i = 0; i != nb_executive; ++i)
+                bag.executives[i]->output(m_currentTime);
+        }
+
+        KernelProfileTimer timer(profile, KernelProfile::DISPATCH);
+        vle_trace_scope("kernel", "dispatch");
+        dispatchExternalEvent(bag.executives, nb_executive);
+    }
+
+    //
+    // First we sort executives models according to the depth of the executive
+    // model into the structure of the models.
+    //
+    if (not bag.executives.empty()) {
+        std::sort(bag.executives.begin(),
+                  bag.executives.end(),
+                  [](const Simulator* lhs, const Simulator* rhs) {
+                      return lhs->getStructure()->getDepth() >
+                             rhs->getStructure()->getDepth();
+                  });
+    }
+
+    //
+    // Compute internal, confluent or external transition for dynamics models.
+    // If parallelization is available, use it otherwise, compute transition
+    // linearly.
+    //
+    {
+        KernelProfileTimer timer(profile, KernelProfile::TRANSITION);
+        transitions(bag.dynamics);
+    }
+
+    {
+        KernelProfileTimer timer(profile, KernelProfile::SCHEDULE);
+        schedule(bag.dynamics);
+    }
+
+    //
+    // The executives change the structure of the models: their
+    // transitions are computed after the dynamics, one at a time.
+    //
+    {
+        KernelProfileTimer timer(profile, KernelProfile::TRANSITION);
+        vle_trace_scope("kernel", "transition");
+
+        for (auto* elem : bag.executives)
+            elem->transition(m_currentTime);
+    }
+
+    {
+        KernelProfileTimer timer(profile, KernelProfile::SCHEDULE);
+        schedule(bag.executives);
+    }
+
+    //
+    // Finally, we go through simulators and executive to get all observation
+    // and dispatch to output plug-in.
+    //
+    {
+        KernelProfileTimer timer(profile, KernelProfile::OBSERVATION);
+        vle_trace_scope("kernel", "observation");
+
+        runObservations(bag.dynamics, m_observed, m_currentTime);
+
+        for (auto& elem : bag.executives) {
+            auto& observations = elem->getObservations();
+            for (auto& obs : observations)
+                obs.view->run(elem->dynamics().get(),
+                              m_currentTime,
+                              obs.portname,
+                              std::move(obs.value));
+
+            observations.clear();
+        }
+
+        processTimedObservations(m_eventTable.getNextTime());
+    }
+
+    //
+    // Finally, we destroy model and simulator if one executive delete a model
+    //
+    if (not m_delete_model.empty()) {
+        KernelProfileTimer timer(profile, KernelProfile::DELETION);
+        vle_trace_scope("kernel", "deletion");
+        dynamic_deletion();
+    }
+
+    m_eventTable.makeNextBag();
+    m_currentTime = m_eventTable.getCurrentTime();
+}
+
+void
+Coordinator::runDynamics(Bag& bag)
+{
+    //
+    // Without executive, the structure of the models and the connections
+    // do not change during the bag: no sort of the executives and no
+    // deletion of models. Without event view, the simulators have no
+    // observation.
+    //
+
+    transitions(bag.dynamics);
+    schedule(bag.dynamics);
+
+    processTimedObservations(m_eventTable.getNextTime());
+
+    m_eventTable.makeNextBag();
+    m_currentTime = m_eventTable.getCurrentTime();
+}
+
+void
+Coordinator::transitions(std::vector<Simulator*>& simulators)
+{
+    vle_trace_scope("kernel", "transition");
+
+    if (m_simulators_thread_pool.parallelize())
+        m_simulators_thread_pool.for_each(simulators, m_currentTime);
+    else
+        for (auto* elem : simulators)
+            elem->transition(m_currentTime);
+}
+
+void
+Coordinator::schedule(const std::vector<Simulator*>& simulators)
+{
+    vle_trace_scope("kernel", "schedule");
+
+    for (auto* elem : simulators) {
+        auto tn = elem->getTn();
+        if (not isInfinity(tn))
+            addInternal(elem, tn);
+    }
+}
+
+void
+Coordinator::run_until(Time date)
+{
+    while (not isInfinity(m_currentTime) and m_currentTime <= date)
+        run();
+}
+
+bool
+Coordinator::isLocalModel(const vpz::AtomicModel* model) const
+{
+    if (not m_channel)
+        return true;
+
+    auto it = m_model_index.find(model);
+
+    return it != m_model_index.end() and
+           m_rank_of[it->second] == m_channel->rank();
+}
+
+void
+Coordinator::buildDistribution(const vpz::Model& mdls)
+{
+    vpz::BaseModel* top = mdls.node();
+    if (not top)
+        return;
+
+    const int size = m_channel->size();
+    int child = 0;
+
+    auto add = [this, size, &child](vpz::BaseModel* mdl) {
+        vpz::AtomicModelVector atomics;
+
+        if (mdl->isAtomic())
+            atomics.push_back(static_cast<vpz::AtomicModel*>(mdl));
+        else
+            vpz::BaseModel::getAtomicModelList(mdl, atomics);
+
+        for (auto* atom : atomics) {
+            m_model_index.emplace(atom, m_models.size());
+            m_models.push_back(atom);
+            m_rank_of.push_back(child % size);
+        }
+
+        ++child;
+    };
+
+    if (top->isAtomic())
+        add(top);
+    else
+        for (const auto& elem :
+             static_cast<vpz::CoupledModel*>(top)->getModelList())
+            add(elem.second);
+
+    vInfo(m_context,
+          _("Simulation kernel: process %d of %d\n"),
+          m_channel->rank(),
+          size);
+}
+
+void
+Coordinator::runDistributed()
+{
+    vle_trace_scope("kernel", "bag");
+
+    Bag& bag = m_eventTable.getCurrentBag();
+    const auto size = static_cast<std::size_t>(m_channel->size());
+    const auto rank = static_cast<std::size_t>(m_channel->rank());
+    const std::size_t nb_dynamics = bag.dynamics.size();
+    KernelProfile* profile = m_profile.get();
+
+    if (profile)
+        profile->addBag(nb_dynamics, 0);
+
+    {
+        KernelProfileTimer timer(profile, KernelProfile::OUTPUT);
+        vle_trace_scope("kernel", "output");
+        for (std::size_t i = 0; i != nb_dynamics; ++i)
+            bag.dynamics[i]->output(m_currentTime);
+    }
+
+    //
+    // The external events to the models of the other processes are stored
+    // into a value::Set by process: the index of the target model, its
+    // port and the value of the event if any.
+    //
+    std::vector<std::string> buffers(size);
+
+    {
+        KernelProfileTimer timer(profile, KernelProfile::DISPATCH);
+        vle_trace_scope("kernel", "dispatch");
+
+        std::vector<value::Set> events(size);
+
+        for (std::size_t i = 0; i != nb_dynamics; ++i) {
+            auto* simulator = bag.dynamics[i];
+
+            for (auto& elem : simulator->result()) {
+                auto key = std::make_pair(static_cast<const Simulator*>(
+                                            simulator),
+                                          elem.getPort());
+                auto it = m_distributed_targets.find(key);
+
+                if (it == m_distributed_targets.end()) {
+                    it = m_distributed_targets
+                           .emplace(std::move(key), vpz::ModelPortList())
+                           .first;
+                    simulator->getStructure()->getAtomicModelsTarget(
+                      elem.getPortName(), it->second);
+                }
+
+                for (const auto& target : it->second) {
+                    auto* atom = static_cast<vpz::AtomicModel*>(target.first);
+
+                    if (atom->get_simulator()) {
+                        m_eventTable.addExternal(atom->get_simulator(),
+                                                 elem.attributes(),
+                                                 target.second);
+                        continue;
+                    }
+
+                    auto index = m_model_index.at(atom);
+                    auto& set = events[m_rank_of[index]];
+
+                    set.addInt(static_cast<int32_t>(index));
+                    set.addString(target.second);
+                    set.addBoolean(elem.attributes() != nullptr);
+                    if (elem.attributes())
+                        set.add(elem.attributes()->clone());
+                }
+
+                if (profile)
+                    ++profile->dispatch_events;
+            }
+
+            simulator->clear_result();
+        }
+
+        for (std::size_t i = 0; i != size; ++i)
+            if (i != rank)
+                buffers[i] = value::toBinary(events[i]);
+
+        buffers = m_channel->exchange(std::move(buffers));
+
+        for (std::size_t i = 0; i != size; ++i) {
+            if (i == rank)
+                continue;
+
+            auto received = value::fromBinary(buffers[i]);
+            auto& set = received->toSet();
+
+            for (std::size_t j = 0, e = set.size(); j < e;) {
+                auto* atom = m_models[set.getInt(j)];
+                const auto& port = set.getString(j + 1);
+                std::shared_ptr<value::Value> value;
+
+                if (set.getBoolean(j + 2)) {
+                    value = set.give(j + 3);
+                    j += 4;
+                } else {
+                    j += 3;
+                }
+
+                m_eventTable.addExternal(atom->get_simulator(), value, port);
+            }
+        }
+    }
+
+    {
+        KernelProfileTimer timer(profile, KernelProfile::TRANSITION);
+        transitions(bag.dynamics);
+    }
+
+    {
+        KernelProfileTimer timer(profile, KernelProfile::SCHEDULE);
+        schedule(bag.dynamics);
+    }
+
+    KernelProfileTimer timer(profile, KernelProfile::OBSERVATION);
+    vle_trace_scope("kernel", "observation");
+
+    runObservations(bag.dynamics, m_observed, m_currentTime);
+
+    //
+    // The next bag is the lower date of the next bags of the processes.
+    //
+    std::vector<std::string> dates(
+      size, value::toBinary(value::Double(m_eventTable.getNextTime())));
+
+    dates = m_channel->exchange(std::move(dates));
+
+    auto next = infinity;
+    for (const auto& elem : dates)
+        next = std::min(next, value::fromBinary(elem)->toDouble().value());
+
+    processTimedObservations(next);
+    exchangeRecords();
+
+    m_eventTable.init(next);
+    m_currentTime = next;
+}
+
+void
+Coordinator::exchangeRecords()
+{
+    vle_trace_scope("kernel", "records");
+
+    const auto size = static_cast<std::size_t>(m_channel->size());
+    const auto rank = static_cast<std::size_t>(m_channel->rank());
+    std::vector<std::string> buffers(size);
+
+    if (rank != 0) {
+        value::Set set;
+
+        for (auto& elem : m_records) {
+            set.addInt(elem.type);
+            set.addString(elem.simulator);
+            set.addString(elem.parent);
+            set.addString(elem.port);
+            set.addString(elem.view);
+            set.addDouble(elem.time);
+            set.addBoolean(elem.value != nullptr);
+            if (elem.value)
+                set.add(std::move(elem.value));
+        }
+
+        m_records.clear();
+        buffers[0] = value::toBinary(set);
+    }
+
+    buffers = m_channel->exchange(std::move(buffers));
+
+    if (rank != 0)
+        return;
+
+    for (std::size_t i = 1; i != size; ++i) {
+        auto received = value::fromBinary(buffers[i]);
+        auto& set = received->toSet();
+
+        for (std::size_t j = 0, e = set.size(); j < e;) {
+            m_records.emplace_back();
+            auto& record = m_records.back();
+
+            record.type = static_cast<ViewRecord::Type>(set.getInt(j));
+            record.simulator = std::move(set.getString(j + 1));
+            record.parent = std::move(set.getString(j + 2));
+            record.port = std::move(set.getString(j + 3));
+            record.view = std::move(set.getString(j + 4));
+            record.time = set.getDouble(j + 5);
+
+            if (set.getBoolean(j + 6)) {
+                record.value = set.give(j + 7);
+                j += 8;
+            } else {
+                j += 7;
+            }
+        }
+    }
+
+    //
+    // A timed view without observable on a process sends an empty value,
+    // it is removed if another process sends values at the same date.
+    //
+    std::set<std::pair<std::string, Time>> observed;
+    for (const auto& elem : m_records)
+        if (elem.type == ViewRecord::VALUE and not elem.simulator.empty())
+            observed.emplace(elem.view, elem.time);
+
+    m_records.erase(
+      std::remove_if(m_records.begin(),
+                     m_records.end(),
+                     [&observed](const ViewRecord& elem) {
+                         return elem.type == ViewRecord::VALUE and
+                                elem.simulator.empty() and
+                                not observed.emplace(elem.view, elem.time)
+                                      .second;
+                     }),
+      m_records.end());
+
+    std::stable_sort(m_records.begin(),
+                     m_records.end(),
+                     [](const ViewRecord& lhs, const ViewRecord& rhs) {
+                         return lhs.time < rhs.time or
+                                (lhs.time == rhs.time and
+                                 lhs.type < rhs.type);
+                     });
+
+    for (auto& elem : m_records) {
+        auto it = m_timedViewList.find(elem.view);
+        if (it == m_timedViewList.end())
+            it = m_eventViewList.find(elem.view);
+
+        it->second.replay(elem);
+    }
+
+    m_records.clear();
+}
+
+void
+Coordinator::buildPartitions(const vpz::Model& mdls)
+{
+    bool partition = false;
+    m_context->get_setting("vle.simulation.partition", &partition);
+
+    vpz::BaseModel* top = mdls.node();
+    if (not partition or not top or not top->isCoupled())
+        return;
+
+    const auto& children = static_cast<vpz::CoupledModel*>(top)->getModelList();
+    if (children.size() < 2)
+        return;
+
+    for (const auto& elem : m_simulators) {
+        if (elem->dynamics()->isExecutive()) {
+            vInfo(m_context,
+                  _("Simulation kernel: no partition with the executive "
+                    "'%s'\n"),
+                  elem->getStructure()->getCompleteName().c_str());
+            return;
+        }
+    }
+
+    m_context->get_setting("vle.simulation.optimistic", &m_optimistic);
+    for (const auto& elem : m_simulators) {
+        if (not m_optimistic)
+            break;
+
+        try {
+            elem->checkpoint();
+        } catch (const utils::NotYetImplemented&) {
+            vInfo(m_context,
+                  _("Simulation kernel: no optimistic simulation, '%s' does "
+                    "not implement checkpoint\n"),
+                  elem->getStructure()->getCompleteName().c_str());
+            m_optimistic = false;
+        }
+    }
+
+    for (const auto& child : children) {
+        vpz::AtomicModelVector atomics;
+
+        if (child.second->isAtomic())
+            atomics.push_back(static_cast<vpz::AtomicModel*>(child.second));
+        else
+            vpz::BaseModel::getAtomicModelList(child.second, atomics);
+
+        for (auto* atom : atomics)
+            m_partition_of.emplace(atom->get_simulator(), m_partitions.size());
+
+        m_partitions.emplace_back(std::make_unique<Partition>());
+        m_partitions.back()->scheduler.setTimeBase(m_timebase);
+    }
+
+    for (const auto& elem : m_simulators) {
+        auto* simulator = elem.get();
+        auto index = m_partition_of.at(simulator);
+        auto& partition = *m_partitions[index];
+
+        const auto& ports = simulator->getStructure()->getOutputPortList();
+
+        for (const auto& port : ports) {
+            if (m_optimistic)
+                break;
+
+            auto x = simulator->targets(port.first);
+
+            for (auto it = x.first; it != x.second; ++it) {
+                if (m_partition_of.at(it->second.first) != index) {
+                    auto lookahead = simulator->dynamics()->lookahead();
+                    if (lookahead < 0.0)
+                        throw utils::ModellingError(
+                          _("Negative lookahead in '%s' (%g)"),
+                          simulator->getStructure()->getCompleteName().c_str(),
+                          lookahead);
+
+                    partition.boundary.emplace(simulator, lookahead);
+                    break;
+                }
+            }
+        }
+
+        auto tn = simulator->getTn();
+        m_eventTable.delSimulator(simulator);
+        simulator->resetInternalEvent();
+        if (not isInfinity(tn))
+            partition.scheduler.addInternal(
+              simulator, tn, simulator->inserted());
+    }
+
+    m_partition_workers =
+      std::make_unique<PartitionWorkers>(m_partitions.size());
+
+    vInfo(m_context,
+          _("Simulation kernel: %lu partitions\n"),
+          static_cast<unsigned long>(m_partitions.size()));
+
+    if (m_optimistic)
+        vInfo(m_context, _("Simulation kernel: optimistic simulation\n"));
+}
+
+Time
+Coordinator::partitionsNextTime() const noexcept
+{
+    auto result = infinity;
+
+    for (const auto& elem : m_partitions)
+        result = std::min(result, elem->nextTime());
+
+    return result;
+}
+
+void
+Coordinator::dispatchPartitionEvent(std::vector<Simulator*>& simulators,
+                                    std::size_t number,
+                                    std::size_t partition)
+{
+    for (std::size_t i = 0; i != number; ++i) {
+        auto& eventList = simulators[i]->result();
+
+        for (auto& elem : eventList) {
+            auto x = simulators[i]->targets(elem.getPort());
+
+            for (auto jt = x.first; jt != x.second; ++jt) {
+                auto index = m_partition_of.at(jt->second.first);
+
+                if (partition < m_partitions.size() and index != partition)
+                    throw utils::InternalError(
+                      _("Partition: '%s' sends an event to another "
+                        "partition before its lookahead"),
+                      simulators[i]->getStructure()->getCompleteName().c_str());
+
+                m_partitions[index]->scheduler.addExternal(
+                  jt->second.first, elem.attributes(), jt->second.second);
+            }
+        }
+
+        simulators[i]->clear_result();
+    }
+}
+
+void
+Coordinator::partitionTransition(Partition& partition,
+                                 Simulator* simulator,
+                                 Time time)
+{
+    auto tn = simulator->transition(time);
+    auto it = partition.boundary.find(simulator);
+    if (it != partition.boundary.end() and tn < time + it->second)
+        throw utils::ModellingError(
+          _("Time advance of '%s' (%g) lower than its lookahead (%g)"),
+          simulator->getStructure()->getCompleteName().c_str(),
+          tn - time,
+          it->second);
+
+    if (not isInfinity(tn))
+        partition.scheduler.addInternal(simulator, tn);
+}
+
+void
+Coordinator::runWindow(std::size_t index, Time window, Time limit) noexcept
+{
+    vle_trace_scope("kernel", "partition window");
+
+    auto& partition = *m_partitions[index];
+    auto previous = negativeInfinity;
+    std::uint64_t number_at_time = 0;
 
-/** Compute the depth of the hierarchy.
- *
- * @return @e depth returns 0 if executive is in the top model otherwise a
- * internet less than 0.
- */
-inline int
-depth(const std::unique_ptr<vle::devs::Dynamics>& mdl) noexcept
+    try {
+        for (;;) {
+            auto time = partition.scheduler.getNextTime();
+            if (not(time < window and time <= limit))
+                break;
+
+            number_at_time = time == previous ? number_at_time + 1 : 0;
+            previous = time;
+
+            partition.scheduler.makeNextBag();
+            auto& bag = partition.scheduler.getCurrentBag();
+            const auto number = bag.dynamics.size();
+
+            for (std::size_t i = 0; i != number; ++i)
+                bag.dynamics[i]->output(time);
+
+            dispatchPartitionEvent(bag.dynamics, number, index);
+
+            for (auto* elem : bag.dynamics)
+                partitionTransition(partition, elem, time);
+
+            for (auto* elem : bag.dynamics) {
+                for (auto& obs : elem->getObservations())
+                    partition.observations.emplace_back(
+                      time, number_at_time, elem, std::move(obs));
+
+                elem->getObservations().clear();
+            }
+
+            partition.last = time;
+        }
+    } catch (...) {
+        partition.error = std::current_exception();
+    }
+}
+
+void
+Coordinator::runPartitionsBag(Time time)
 {
-    int ret = 0;
+    vle_trace_scope("kernel", "partition bag");
 
-    const vle::vpz::CoupledModel* parent = mdl->getModel().getParent();
-    while (parent != nullptr) {
-        parent = parent->getParent();
-        --ret;
+    //
+    // The bags of the partitions are merged in the order of the insertion
+    // sequence of the Scheduler (see HeapElementCompare), the order of the
+    // bag of the sequential simulation: a Simulator receives the events of
+    // the other partitions in the same order.
+    //
+    std::vector<Simulator*> bag;
+    for (auto& elem : m_partitions) {
+        elem->scheduler.init(time);
+        const auto& dynamics = elem->scheduler.getCurrentBag().dynamics;
+        bag.insert(bag.end(), dynamics.begin(), dynamics.end());
     }
 
-    return ret;
-}
-}
+    std::sort(bag.begin(),
+              bag.end(),
+              [](const Simulator* lhs, const Simulator* rhs) {
+                  return lhs->inserted() < rhs->inserted() or
+                         (lhs->inserted() == rhs->inserted() and
+                          lhs->index() < rhs->index());
+              });
 
-namespace vle {
-namespace devs {
+    for (auto* elem : bag)
+        elem->output(time);
 
-Coordinator::Coordinator(utils::ContextPtr context,
-                         const vpz::Dynamics& dyn,
-                         const vpz::Classes& cls,
-                         const vpz::Experiment& experiment)
-  : m_context(context)
-  , m_currentTime(0.0)
-  , m_simulators_thread_pool(m_context)
-  , m_modelFactory(context, m_eventViewList, dyn, cls, experiment)
-  , m_isStarted(false)
+    dispatchPartitionEvent(bag, bag.size(), m_partitions.size());
+
+    bag.clear();
+    for (auto& elem : m_partitions) {
+        const auto& dynamics = elem->scheduler.getCurrentBag().dynamics;
+        for (auto* simulator : dynamics)
+            partitionTransition(*elem, simulator, time);
+
+        bag.insert(bag.end(), dynamics.begin(), dynamics.end());
+    }
+
+    runObservations(bag, m_observed, time);
+}
+
+/* Send the observations of the partitions to the views in the order of
+ * the sequential simulation (see PartitionObservation). */
+static void
+runPartitionObservations(std::vector<PartitionObservation>& observations)
 {
+    std::stable_sort(
+      observations.begin(),
+      observations.end(),
+      [](const PartitionObservation& lhs, const PartitionObservation& rhs) {
+          if (lhs.time != rhs.time)
+              return lhs.time < rhs.time;
+
+          if (lhs.bag != rhs.bag)
+              return lhs.bag < rhs.bag;
+
+          return lhs.simulator->index() < rhs.simulator->index();
+      });
+
+    for (auto& elem : observations)
+        elem.observation.view->run(elem.simulator->dynamics().get(),
+                                   elem.time,
+                                   elem.observation.portname,
+                                   std::move(elem.observation.value));
 }
 
 void
-Coordinator::init(const vpz::Model& mdls, Time current, Time duration)
+Coordinator::runPartitions()
 {
-    m_currentTime = current;
-    m_durationTime = duration;
-    buildViews();
-    addModels(mdls);
-    m_isStarted = true;
+    auto next = partitionsNextTime();
 
-    m_eventTable.init(current);
+    //
+    // An observation at date t sees all the bags lower or equal to t: the
+    // bags after the next timed observation wait the next call.
+    //
+    auto limit = std::min(m_timed_observation_scheduler.getNextTime(),
+                          m_durationTime);
+
+    if (next <= limit and m_optimistic) {
+        runOptimistic(limit);
+    } else if (next <= limit) {
+        auto window = infinity;
+        for (const auto& elem : m_partitions)
+            window = std::min(window, elem->bound());
+
+        vDbg(m_context,
+             _("-------- PARTITIONS [%f, %f[ --------\n"),
+             next,
+             window);
+
+        if (window > next) {
+            m_partition_workers->for_each([this, window, limit](std::size_t i) {
+                runWindow(i, window, limit);
+            });
+
+            std::vector<PartitionObservation> observations;
+            for (auto& elem : m_partitions) {
+                if (elem->error)
+                    std::rethrow_exception(elem->error);
+
+                m_currentTime = std::max(m_currentTime, elem->last);
+                std::move(elem->observations.begin(),
+                          elem->observations.end(),
+                          std::back_inserter(observations));
+                elem->observations.clear();
+            }
+
+            runPartitionObservations(observations);
+        } else {
+            runPartitionsBag(next);
+            m_currentTime = next;
+        }
+    }
+
+    next = partitionsNextTime();
+    processTimedObservations(next);
+    m_currentTime = next;
 }
 
 void
-Coordinator::run()
+Coordinator::runOptimistic(Time limit)
 {
-    Bag& bag = m_eventTable.getCurrentBag();
-    if (not bag.dynamics.empty() or not bag.executives.empty())
-        m_currentTime = m_eventTable.getCurrentTime();
-    else
-        vDbg(m_context, "Coordinator::run bag is empty...\n");
+    for (;;) {
+        m_partition_workers->for_each(
+          [this, limit](std::size_t i) { runOptimisticRound(i, limit); });
 
-    vDbg(m_context, _("-------- BAG [%f] --------\n"), m_currentTime);
+        auto gvt = infinity;
+        for (auto& elem : m_partitions) {
+            if (elem->error)
+                std::rethrow_exception(elem->error);
+
+            gvt = std::min(gvt, std::min(elem->nextTime(), elem->inboxTime()));
+        }
+
+        vDbg(m_context, _("-------- GVT %f --------\n"), gvt);
+
+        //
+        // No message can undo a bag before the global virtual time: the
+        // bags are committed and their observations are sent to the views.
+        //
+        std::vector<PartitionObservation> observations;
+        for (auto& elem : m_partitions) {
+            auto& history = elem->history;
+
+            while (not history.empty() and history.front().date.first < gvt) {
+                auto& bag = history.front();
+                m_currentTime = std::max(m_currentTime, bag.date.first);
+                std::move(bag.observations.begin(),
+                          bag.observations.end(),
+                          std::back_inserter(observations));
+                history.pop_front();
+            }
+        }
+
+        runPartitionObservations(observations);
+
+        if (gvt > limit)
+            break;
+    }
 
     //
-    // Call output functions for all executives and dynamics models then
-    // dispatches external events for all executives and dynamics.
+    // The messages of the inboxes are after the limit: they go into the
+    // pending messages without rollback.
     //
+    for (std::size_t i = 0, e = m_partitions.size(); i != e; ++i)
+        receivePartitionMessages(i);
+}
 
-    const std::size_t nb_dynamics = bag.dynamics.size();
-    const std::size_t nb_executive = bag.executives.size();
+void
+Coordinator::runOptimisticRound(std::size_t index, Time limit) noexcept
+{
+    vle_trace_scope("kernel", "partition round");
 
-    if (nb_dynamics > 0) {
-        for (std::size_t i = 0; i != nb_dynamics; ++i)
-            bag.dynamics[i]->output(m_currentTime);
+    auto& partition = *m_partitions[index];
 
-        dispatchExternalEvent(bag.dynamics, nb_dynamics);
-    }
+    try {
+        for (;;) {
+            receivePartitionMessages(index);
 
-    if (nb_executive > 0) {
-        for (std::size_t i = 0; i != nb_executive; ++i)
-            bag.executives[i]->output(m_currentTime);
+            auto date = partition.nextDate();
+            if (not(date.first <= limit))
+                break;
 
-        dispatchExternalEvent(bag.executives, nb_executive);
+            runOptimisticBag(index, date);
+        }
+    } catch (...) {
+        partition.error = std::current_exception();
     }
+}
+
+void
+Coordinator::runOptimisticBag(std::size_t index, PartitionDate date)
+{
+    auto& partition = *m_partitions[index];
+    auto time = date.first;
 
     //
-    // First we sort executives models according to the depth of the executive
-    // model into the structure of the models.
+    // The internal events of the partition are at this date or later, the
+    // scheduler pulls nothing if the bag starts with a message.
     //
-    if (not bag.executives.empty()) {
-        std::sort(bag.executives.begin(),
-                  bag.executives.end(),
-                  [](const Simulator* lhs, const Simulator* rhs) {
-                      return ::depth(lhs->dynamics()) <
-                             ::depth(rhs->dynamics());
-                  });
-    }
+    partition.scheduler.init(time);
+    auto& bag = partition.scheduler.getCurrentBag();
+    const auto number = bag.dynamics.size();
+
+    partition.history.emplace_back(date);
+    auto& undo = partition.history.back();
+
+    for (std::size_t i = 0; i != number; ++i)
+        bag.dynamics[i]->output(time);
 
     //
-    // Compute internal, confluent or external transition for dynamics models.
-    // If parallelization is available, use it otherwise, compute transition
-    // linearly.
+    // The events of the bag are received in the order of the sequential
+    // simulation: the messages of the other partitions are merged with
+    // the outputs of the bag by insertion date then index of the source.
     //
-    if (m_simulators_thread_pool.parallelize()) {
-        m_simulators_thread_pool.for_each(bag.dynamics, m_currentTime);
-    } else {
-        for (auto& elem : bag.dynamics) {
-            if (elem->haveInternalEvent()) {
-                if (not elem->haveExternalEvents())
-                    elem->internalTransition(m_currentTime);
-                else
-                    elem->confluentTransitions(m_currentTime);
-            } else {
-                elem->externalTransition(m_currentTime);
+    auto end = partition.pending.upper_bound(date);
+    for (auto it = partition.pending.begin(); it != end; ++it)
+        undo.received.emplace_back(std::move(it->second));
+    partition.pending.erase(partition.pending.begin(), end);
+
+    std::sort(undo.received.begin(),
+              undo.received.end(),
+              [](const PartitionMessage& lhs, const PartitionMessage& rhs) {
+                  return std::tie(lhs.inserted, lhs.index, lhs.id) <
+                         std::tie(rhs.inserted, rhs.index, rhs.id);
+              });
+
+    auto received = undo.received.cbegin();
+    auto receive = [&partition, &undo, &received](std::int64_t inserted,
+                                                  std::uint64_t index) {
+        for (; received != undo.received.cend(); ++received) {
+            if (std::tie(inserted, index) <
+                std::tie(received->inserted, received->index))
+                break;
+
+            partition.scheduler.addExternal(
+              received->target, received->value, received->port);
+        }
+    };
+
+    for (std::size_t i = 0; i != number; ++i) {
+        auto* simulator = bag.dynamics[i];
+
+        receive(simulator->inserted(), simulator->index());
+
+        for (auto& elem : simulator->result()) {
+            auto x = simulator->targets(elem.getPort());
+
+            for (auto jt = x.first; jt != x.second; ++jt) {
+                auto target = m_partition_of.at(jt->second.first);
+
+                if (target == index) {
+                    partition.scheduler.addExternal(
+                      jt->second.first, elem.attributes(), jt->second.second);
+                } else {
+                    undo.sent.push_back(PartitionMessage{ date,
+                                                          jt->second.first,
+                                                          jt->second.second,
+                                                          elem.attributes(),
+                                                          index,
+                                                          partition.next_id++,
+                                                          simulator->inserted(),
+                                                          simulator->index(),
+                                                          false });
+                    m_partitions[target]->send(undo.sent.back());
+                }
             }
         }
+
+        simulator->clear_result();
     }
 
-    for (auto& elem : bag.dynamics) {
-        auto tn = elem->getTn();
-        if (not isInfinity(tn))
-            m_eventTable.addInternal(elem, tn);
+    receive(std::numeric_limits<std::int64_t>::max(),
+            std::numeric_limits<std::uint64_t>::max());
+
+    undo.states.reserve(bag.dynamics.size());
+    for (auto* elem : bag.dynamics)
+        undo.states.emplace_back(
+          elem, elem->checkpoint(), elem->getTn(), elem->inserted());
+
+    for (auto* elem : bag.dynamics)
+        partitionTransition(partition, elem, time);
+
+    for (auto* elem : bag.dynamics) {
+        for (auto& obs : elem->getObservations())
+            undo.observations.emplace_back(
+              time, date.second, elem, std::move(obs));
+
+        elem->getObservations().clear();
     }
+}
 
-    for (auto& elem : bag.executives) {
-        if (elem->haveInternalEvent()) {
-            if (not elem->haveExternalEvents())
-                elem->internalTransition(m_currentTime);
-            else
-                elem->confluentTransitions(m_currentTime);
-        } else {
-            elem->externalTransition(m_currentTime);
+void
+Coordinator::receivePartitionMessages(std::size_t index)
+{
+    auto& partition = *m_partitions[index];
+
+    for (auto& elem : partition.receive()) {
+        if (not partition.history.empty() and
+            elem.date <= partition.history.back().date)
+            rollbackPartition(index, elem.date);
+
+        if (not elem.anti) {
+            auto date = elem.date;
+            partition.pending.emplace(date, std::move(elem));
+            continue;
         }
-    }
 
-    for (auto& elem : bag.executives) {
-        auto tn = elem->getTn();
-        if (not isInfinity(tn))
-            m_eventTable.addInternal(elem, tn);
+        //
+        // The messages of a source are received in the order of sending:
+        // the message of an anti message is pending.
+        //
+        auto range = partition.pending.equal_range(elem.date);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second.source == elem.source and
+                it->second.id == elem.id) {
+                partition.pending.erase(it);
+                break;
+            }
+        }
     }
+}
 
-    //
-    // Finally, we go through simulators and executive to get all observation
-    // and dispatch to output plug-in.
-    //
-    for (auto& elem : bag.dynamics) {
-        auto& observations = elem->getObservations();
-        for (auto& obs : observations)
-            obs.view->run(elem->dynamics().get(),
-                          m_currentTime,
-                          obs.portname,
-                          std::move(obs.value));
+void
+Coordinator::rollbackPartition(std::size_t index, PartitionDate date)
+{
+    vle_trace_scope("kernel", "partition rollback");
 
-        observations.clear();
-    }
+    auto& partition = *m_partitions[index];
 
-    for (auto& elem : bag.executives) {
-        auto& observations = elem->getObservations();
-        for (auto& obs : observations)
-            obs.view->run(elem->dynamics().get(),
-                          m_currentTime,
-                          obs.portname,
-                          std::move(obs.value));
+    while (not partition.history.empty() and
+           partition.history.back().date >= date) {
+        auto& undo = partition.history.back();
 
-        observations.clear();
+        for (auto& elem : undo.sent) {
+            elem.anti = true;
+            elem.value.reset();
+            m_partitions[m_partition_of.at(elem.target)]->send(
+              std::move(elem));
+        }
+
+        partition.scheduler.rollback(undo.date.first);
+
+        for (auto it = undo.states.rbegin(); it != undo.states.rend(); ++it) {
+            partition.scheduler.delSimulator(it->simulator);
+            it->simulator->resetInternalEvent();
+            it->simulator->restore(*it->state, undo.date.first, it->tn);
+
+            if (not isInfinity(it->tn))
+                partition.scheduler.addInternal(
+                  it->simulator, it->tn, it->inserted);
+        }
+
+        for (auto& elem : undo.received) {
+            auto received = elem.date;
+            partition.pending.emplace(received, std::move(elem));
+        }
+
+        partition.history.pop_back();
+        ++partition.rollbacks;
     }
+}
 
+void
+Coordinator::processTimedObservations(Time next)
+{
     //
-    // Process observation event if the next bag is scheduled for a different
-    // date than \e m_currentTime.
+    // Process observation event if the next bag is scheduled for a
+    // different date than \e m_currentTime.
     //
-    auto next = m_eventTable.getNextTime();
     if (next > m_currentTime) {
 
         //
-        // Scheduler is empty. We eat all timed view until the duration time
+        // Scheduler is empty. We eat all timed view until the duration
+        // time
         //
         auto eatuntil = std::min(next, m_durationTime);
 
-        while (m_timed_observation_scheduler.haveObservationAtTime(eatuntil)) {
-            auto obs =
-              m_timed_observation_scheduler.getObservationAtTime(eatuntil);
-
-            if (not obs.empty()) {
-                m_currentTime = obs.back().mTime;
-
-                for (auto& elem : obs) {
-                    elem.run();
-                    elem.update();
-
-                    if (not isInfinity(elem.mTime))
-                        m_timed_observation_scheduler.add(
-                          elem.mView, elem.mTime, elem.mTimestep);
-                }
-            }
-        }
+        while (m_timed_observation_scheduler.haveObservationAtTime(eatuntil))
+            m_currentTime = m_timed_observation_scheduler.run();
 
         if (isInfinity(next) or next > m_durationTime) {
             //
-            // For all Timed view, process a final observation and clear the
-            // scheduler.
+            // For all Timed view, process a final observation and clear
+            // the scheduler.
             //
             m_currentTime = m_durationTime;
             m_timed_observation_scheduler.finalize(m_currentTime);
         }
     }
-
-    //
-    // Finally, we destroy model and simulator if one executive delete a model
-    //
-    if (not m_delete_model.empty())
-        dynamic_deletion();
-
-    m_eventTable.makeNextBag();
-    m_currentTime = m_eventTable.getCurrentTime();
 }
 
 void
@@ -335,6 +1514,9 @@ Coordinator::dynamic_deletion()
 
     m_delete_model.clear();
 
+    if (m_profile)
+        m_profile->scheduler_delete += lst.size();
+
     for (auto& elem : lst) {
         m_eventTable.delSimulator(elem);
 
@@ -414,6 +1596,11 @@ Coordinator::addModel(vpz::AtomicModel* model)
     assert(model && "Coordinator: nullptr model to add?");
 
     m_simulators.emplace_back(std::make_unique<Simulator>(model));
+    m_simulators.back()->setTimeBase(m_timebase);
+    m_simulators.back()->setIndex(m_next_index++);
+
+    if (m_profile)
+        m_simulators.back()->enableProfile();
 
     return m_simulators.back().get();
 }
@@ -436,6 +1623,10 @@ Coordinator::delAtomicModel(vpz::AtomicModel* atom,
     for (auto& elem : m_timedViewList)
         elem.second.removeObservable(satom->dynamics().get());
 
+    if (satom->profile())
+        m_profile_deleted.emplace_back(atom->getCompleteName(),
+                                       *satom->profile());
+
     to_delete.emplace_back(satom);
 }
 
@@ -468,13 +1659,24 @@ Coordinator::dispatchExternalEvent(std::vector<Simulator*>& simulators,
 
         auto& eventList = simulators[i]->result();
         for (auto& elem : eventList) {
-            auto x = simulators[i]->targets(elem.getPortName());
+            auto x = simulators[i]->targets(elem.getPort());
 
             if (x.first != x.second and x.first->second.first) {
                 for (auto jt = x.first; jt != x.second; ++jt)
                     m_eventTable.addExternal(
                       jt->second.first, elem.attributes(), jt->second.second);
+
+                if (m_profile) {
+                    std::uint64_t fanout = std::distance(x.first, x.second);
+                    m_profile->dispatch_messages += fanout;
+                    m_profile->scheduler_external += fanout;
+                    m_profile->dispatch_fanout_max =
+                      std::max(m_profile->dispatch_fanout_max, fanout);
+                }
             }
+
+            if (m_profile)
+                ++m_profile->dispatch_events;
         }
 
         simulators[i]->clear_result();
@@ -488,6 +1690,32 @@ Coordinator::buildViews()
     const vpz::Views& views(m_modelFactory.views());
     const vpz::ViewList& viewlist(views.viewlist());
 
+    //
+    // In a distributed simulation, only the process 0 opens the plug-ins,
+    // the observations of all the processes are recorded and sent to it.
+    //
+    auto open = [this](View& v,
+                       const vpz::View& view,
+                       const vpz::Output& output,
+                       const std::string& file) {
+        if (m_channel and m_channel->rank() != 0) {
+            v.open(view.name(), &m_records);
+            return;
+        }
+
+        v.open(m_context,
+               view.name(),
+               output.plugin(),
+               output.package(),
+               output.location(),
+               file,
+               m_currentTime,
+               (output.data()) ? output.data()->clone() : nullptr);
+
+        if (m_channel)
+            v.record(&m_records);
+    };
+
     for (const auto& elem : viewlist) {
         if (elem.second.is_enable()) {
             auto file =
@@ -499,29 +1727,16 @@ Coordinator::buildViews()
 
             if (elem.second.type() == vpz::View::TIMED) {
                 View& v = m_timedViewList[elem.second.name()];
+                open(v, elem.second, output, file);
 
-                v.open(m_context,
-                       elem.second.name(),
-                       output.plugin(),
-                       output.package(),
-                       output.location(),
-                       file,
-                       m_currentTime,
-                       (output.data()) ? output.data()->clone() : nullptr);
+                if (m_simulators_thread_pool.parallelize())
+                    v.parallelize(&m_simulators_thread_pool);
 
                 m_timed_observation_scheduler.add(
                   &v, m_currentTime, elem.second.timestep());
             } else {
                 auto& v = m_eventViewList[elem.second.name()];
-
-                v.open(m_context,
-                       elem.second.name(),
-                       output.plugin(),
-                       output.package(),
-                       output.location(),
-                       file,
-                       m_currentTime,
-                       (output.data()) ? output.data()->clone() : nullptr);
+                open(v, elem.second, output, file);
             }
         }
     }
@@ -530,16 +1745,43 @@ Coordinator::buildViews()
 void
 Coordinator::processInit(Simulator* simulator)
 {
-    Time tn = simulator->init(m_currentTime);
+    Time tn;
+
+    if (m_restore) {
+        auto name = simulator->getStructure()->getCompleteName();
+        auto it = m_restore->find(name);
+
+        if (it == m_restore->end())
+            throw utils::InternalError(
+              _("Checkpoint: model '%s' has no state"), name.c_str());
+
+        const auto& model = it->second->toMap();
+        tn = simulator->restore(
+          *model.get("state"), m_currentTime, model.getDouble("tn"));
+    } else {
+        tn = simulator->init(m_currentTime);
+    }
 
     if (not isInfinity(tn)) {
-        m_eventTable.addInternal(simulator, tn);
+        addInternal(simulator, tn);
     }
 }
 
 std::unique_ptr<value::Map>
 Coordinator::finish()
 {
+    vle_trace_scope("kernel", "finish");
+
+    if (m_optimistic) {
+        std::uint64_t rollbacks = 0;
+        for (const auto& elem : m_partitions)
+            rollbacks += elem->rollbacks;
+
+        vInfo(m_context,
+              _("Simulation kernel: %llu bags undone\n"),
+              static_cast<unsigned long long>(rollbacks));
+    }
+
     for (auto& elem : m_simulators) {
         assert(elem.get());
         elem->finish();
@@ -553,6 +1795,9 @@ Coordinator::finish()
         observations.clear();
     }
 
+    if (m_channel)
+        exchangeRecords();
+
     std::unique_ptr<value::Map> result;
     for (auto& elem : m_timedViewList) {
         auto matrix = elem.second.finish(m_currentTime);
@@ -605,5 +1850,158 @@ Coordinator::getMap() const
 
     return result;
 }
+
+void
+Coordinator::enableProfile()
+{
+    if (not m_profile)
+        m_profile = std::make_unique<KernelProfile>();
+
+    for (auto& elem : m_simulators)
+        elem->enableProfile();
+}
+
+static double
+to_seconds(ProfileClock::duration duration) noexcept
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+static void
+add_profile(value::Map& models,
+            const std::string& name,
+            const SimulatorProfile& profile)
+{
+    //
+    // Two models can share the same complete name if an executive builds a
+    // model with the name of a deleted one. Counters are summed.
+    //
+    auto it = models.find(name);
+    value::Map* mdl = nullptr;
+    if (it == models.end())
+        mdl = &models.addMap(name);
+    else
+        mdl = &it->second->toMap();
+
+    auto add = [mdl](const std::string& key, double value) {
+        auto jt = mdl->find(key);
+        if (jt == mdl->end())
+            mdl->addDouble(key, value);
+        else
+            jt->second->toDouble().value() += value;
+    };
+
+    for (int i = 0; i != SimulatorProfile::FUNCTION_COUNT; ++i) {
+        auto function = static_cast<SimulatorProfile::Function>(i);
+        std::string prefix(SimulatorProfile::name(function));
+
+        add(prefix + "-count", profile.count[i]);
+        add(prefix + "-time", to_seconds(profile.time[i]));
+    }
+
+    add("external-events", profile.external_events);
+    add("output-events", profile.output_events);
+
+    std::uint64_t allocations = 0, bytes = 0;
+    for (int i = 0; i != SimulatorProfile::FUNCTION_COUNT; ++i) {
+        allocations += profile.allocations[i];
+        bytes += profile.bytes[i];
+    }
+
+    add("allocations", allocations);
+    add("bytes", bytes);
+}
+
+std::unique_ptr<value::Map>
+Coordinator::profile() const
+{
+    if (not m_profile)
+        return nullptr;
+
+    auto result = std::make_unique<value::Map>();
+    auto& kernel = result->addMap("kernel");
+
+    //
+    // Counters are stored into value::Double because value::Integer is a
+    // 32 bits integer.
+    //
+    kernel.addDouble("bags", m_profile->bags);
+    kernel.addDouble("bag-dynamics", m_profile->bag_dynamics);
+    kernel.addDouble("bag-executives", m_profile->bag_executives);
+    kernel.addDouble("bag-size-max", m_profile->bag_max);
+    kernel.addDouble("bag-size-mean",
+                     m_profile->bags == 0
+                       ? 0.0
+                       : static_cast<double>(m_profile->bag_dynamics +
+                                             m_profile->bag_executives) /
+                           m_profile->bags);
+
+    auto last = m_profile->bag_histogram.size();
+    while (last > 0 and m_profile->bag_histogram[last - 1] == 0)
+        --last;
+
+    auto& histogram = kernel.addTuple("bag-size-histogram", last, 0.0);
+    for (std::size_t i = 0; i != last; ++i)
+        histogram.value()[i] = m_profile->bag_histogram[i];
+
+    kernel.addDouble("scheduler-internal", m_profile->scheduler_internal);
+    kernel.addDouble("scheduler-external", m_profile->scheduler_external);
+    kernel.addDouble("scheduler-delete", m_profile->scheduler_delete);
+    kernel.addDouble("dispatch-events", m_profile->dispatch_events);
+    kernel.addDouble("dispatch-messages", m_profile->dispatch_messages);
+    kernel.addDouble("dispatch-fanout-max", m_profile->dispatch_fanout_max);
+
+    for (int i = 0; i != KernelProfile::PHASE_COUNT; ++i) {
+        auto phase = static_cast<KernelProfile::Phase>(i);
+        kernel.addDouble(std::string("time-") + KernelProfile::name(phase),
+                         to_seconds(m_profile->time[i]));
+    }
+
+    //
+    // The allocations of the phases are the allocations of the thread of
+    // the Coordinator. With the parallel simulators, those of the worker
+    // threads are only found in the models.
+    //
+    for (int i = 0; i != KernelProfile::PHASE_COUNT; ++i) {
+        std::string phase(
+          KernelProfile::name(static_cast<KernelProfile::Phase>(i)));
+
+        kernel.addDouble("allocations-" + phase, m_profile->allocations[i]);
+        kernel.addDouble("bytes-" + phase, m_profile->bytes[i]);
+    }
+
+    auto& models = result->addMap("models");
+
+    for (const auto& elem : m_profile_deleted)
+        add_profile(models, elem.first, elem.second);
+
+    for (const auto& elem : m_simulators)
+        if (elem->profile())
+            add_profile(models,
+                        elem->getStructure()->getCompleteName(),
+                        *elem->profile());
+
+    //
+    // The counters of the subsystems are process wide: they include the
+    // simulations run in the other threads.
+    //
+    if (utils::Memory::enabled()) {
+        auto& memory = result->addMap("memory");
+
+        for (int i = 0; i != utils::Memory::tags; ++i) {
+            auto tag = static_cast<utils::MemoryTag>(i);
+            auto counter = utils::Memory::counter(tag);
+            auto& map = memory.addMap(utils::Memory::name(tag));
+
+            map.addDouble("allocations", counter.allocations);
+            map.addDouble("deallocations", counter.deallocations);
+            map.addDouble("bytes", counter.bytes);
+            map.addDouble("live-bytes", counter.live);
+            map.addDouble("peak-bytes", counter.peak);
+        }
+    }
+
+    return result;
+}
 }
 } // namespace vle devs
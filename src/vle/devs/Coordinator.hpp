@@ -27,9 +27,14 @@
 #ifndef VLE_DEVS_COORDINATOR_HPP
 #define VLE_DEVS_COORDINATOR_HPP 1
 
+#include "Partition.hpp"
 #include "Thread.hpp"
+#include <set>
+#include <unordered_map>
 #include <vle/DllDefines.hpp>
+#include <vle/devs/Distributed.hpp>
 #include <vle/devs/ModelFactory.hpp>
+#include <vle/devs/Profile.hpp>
 #include <vle/devs/Scheduler.hpp>
 #include <vle/devs/Simulator.hpp>
 #include <vle/devs/Time.hpp>
@@ -57,6 +62,25 @@ public:
 
     ~Coordinator() = default;
 
+    /**
+     * @brief Simulate only a part of the model in this process and exchange
+     * the external events and the observations with the other processes
+     * of @e channel. The sub-model @e i of the top coupled model is
+     * simulated by the process @e i modulo DistributedChannel::size(). All
+     * the processes call init(), run() and finish() together. Must be
+     * called before init().
+     */
+    void setDistributed(std::shared_ptr<DistributedChannel> channel)
+    {
+        m_channel = std::move(channel);
+    }
+
+    /**
+     * @brief Check if the Simulator of @e model is built in this process.
+     * @return true if the simulation is not distributed.
+     */
+    bool isLocalModel(const vpz::AtomicModel* model) const;
+
     /**
      * @brief Initialise Coordinator before running simulation. Rand is
      * initialized, send to all Simulator the first init event found and
@@ -68,6 +92,46 @@ public:
      */
     void init(const vpz::Model& mdls, Time current, Time duration);
 
+    /**
+     * @brief Initialise Coordinator from a checkpoint instead of init().
+     * The Simulators of the vpz::Model are built and restored with the
+     * states stored by checkpoint() (Dynamics::restore() replaces
+     * Dynamics::init()), then the plug-ins, the timed observations and
+     * the current bag are restored.
+     *
+     * @param mdls the structure of the models at the checkpoint.
+     * @param state the value built by checkpoint().
+     * @param duration the end of the simulation.
+     * @throw utils::InternalError if a model or a view of the structure
+     * is not in the checkpoint.
+     */
+    void restore(const vpz::Model& mdls,
+                 const value::Map& state,
+                 Time duration);
+
+    /**
+     * @brief Build a copy of the state of the simulation between two
+     * calls to run(): the current time, the order of the current bag, the
+     * tn and the Dynamics::checkpoint() of each Simulator, the next date
+     * of observation and the state of the plug-in of each View.
+     *
+     * @throw utils::NotYetImplemented if an atomic model does not
+     * implement Dynamics::checkpoint().
+     */
+    std::unique_ptr<value::Map> checkpoint();
+
+    /**
+     * @brief Replace the conditions @e names of the experiment by the
+     * conditions of the same name in @e conditions and call
+     * Dynamics::updateConditions() for each atomic model which uses one of
+     * them. Used between two calls to run().
+     *
+     * @throw utils::NotYetImplemented if an atomic model does not
+     * implement Dynamics::updateConditions().
+     */
+    void updateConditions(const vpz::Conditions& conditions,
+                          const std::set<std::string>& names);
+
     /**
      * \brief Returns the next time.
      * @return A devs::Time.
@@ -77,10 +141,24 @@ public:
     /**
      * @brief Pop the next devs::CompleteEventBagModel from the
      * devs::EventTable and call devs::Simulator function.
+     *
+     * With partitions (see buildPartitions()), run() processes either all
+     * the bags of each partition before the next event between two
+     * partitions, one thread by partition, or the bag of all the
+     * partitions at the next date. A distributed simulation (see
+     * setDistributed()) processes the bag of this process at the next
+     * date of all the processes.
      * @return 0.
      */
     void run();
 
+    /**
+     * @brief Call run() for all the bags scheduled before or at @e date.
+     * The loop stays in the kernel: the caller gets the control back only
+     * once the date of the next bag is greater than @e date.
+     */
+    void run_until(Time date);
+
     /**
      * @brief Build a new devs::Simulator from the dynamics library. Attach
      * to this model information of dynamics, condition and observable.
@@ -229,6 +307,16 @@ public:
         return m_modelFactory.observables();
     }
 
+    /**
+     * @brief Get a constant reference to the vpz::Experiment (conditions,
+     * views, outputs and observables) updated by the executives.
+     * @return A constant reference to the vpz::Experiment.
+     */
+    const vpz::Experiment& experiment() const
+    {
+        return m_modelFactory.experiment();
+    }
+
     bool isStarted() const
     {
         return m_isStarted;
@@ -272,15 +360,42 @@ public:
      */
     void dynamic_deletion();
 
+    /**
+     * Start to record the counters and the times of the Coordinator and of
+     * all its Simulators, including the Simulators built later by
+     * executives. Must be called before init() to profile the whole
+     * simulation.
+     */
+    void enableProfile();
+
+    /**
+     * Build the report of the profiler: a \c value::Map with a "kernel"
+     * map (bags, scheduler and dispatch counters, time in seconds of each
+     * phase of run()) and a "models" map indexed by the complete name of
+     * the atomic models (number of calls and time in seconds of each
+     * function, number of events received and sent).
+     *
+     * @return nullptr if the profiler is not enabled.
+     */
+    std::unique_ptr<value::Map> profile() const;
+
 private:
     Coordinator(const Coordinator& other);
     Coordinator& operator=(const Coordinator& other);
 
     utils::ContextPtr m_context;
+    TimeBase m_timebase;
     Time m_currentTime;
     Time m_durationTime;
     SimulatorProcessParallel m_simulators_thread_pool;
     std::vector<std::unique_ptr<Simulator>> m_simulators;
+
+    /// The index of the next Simulator built by addModel().
+    std::uint64_t m_next_index;
+
+    /// The Simulators of a bag with observations (see runObservations()).
+    std::vector<Simulator*> m_observed;
+
     Scheduler m_eventTable;
     TimedObservationScheduler m_timed_observation_scheduler;
     std::map<std::string, View> m_eventViewList;
@@ -289,8 +404,187 @@ private:
 
     std::vector<vpz::BaseModel*> m_delete_model;
 
+    std::unique_ptr<KernelProfile> m_profile;
+
+    /// Profiles of the Simulators removed by dynamic_deletion().
+    std::vector<std::pair<std::string, SimulatorProfile>> m_profile_deleted;
+
+    /// The "models" map of the checkpoint during restore().
+    const value::Map* m_restore;
+
     bool m_isStarted;
 
+    /// The partitions of the top coupled model, empty if the bags are
+    /// processed with the m_eventTable.
+    std::vector<std::unique_ptr<Partition>> m_partitions;
+
+    /// The index in m_partitions of each Simulator.
+    std::unordered_map<const Simulator*, std::size_t> m_partition_of;
+
+    std::unique_ptr<PartitionWorkers> m_partition_workers;
+
+    /// The partitions run the optimistic simulation instead of the
+    /// conservative windows.
+    bool m_optimistic;
+
+    /// The processes of a distributed simulation or nullptr.
+    std::shared_ptr<DistributedChannel> m_channel;
+
+    /// The atomic models of the distributed simulation, the index of a
+    /// model is used to send its external events to another process.
+    std::vector<vpz::AtomicModel*> m_models;
+    std::unordered_map<const vpz::AtomicModel*, std::size_t> m_model_index;
+
+    /// The process of each model of m_models.
+    std::vector<int> m_rank_of;
+
+    /// The targets of the output ports in the distributed simulation.
+    std::map<std::pair<const Simulator*, utils::Symbol>, vpz::ModelPortList>
+      m_distributed_targets;
+
+    /// The calls to the plug-ins of the views not yet sent to the
+    /// process 0.
+    std::vector<ViewRecord> m_records;
+
+    /**
+     * @brief Assign the atomic models of the sub-models of the top model to
+     * the processes of m_channel.
+     */
+    void buildDistribution(const vpz::Model& mdls);
+
+    /**
+     * @brief Compute the transitions of the simulators of a bag at the
+     * date m_currentTime, with the thread pool if any (see
+     * Simulator::transition()).
+     */
+    void transitions(std::vector<Simulator*>& simulators);
+
+    /**
+     * @brief Push the simulators of a bag into the scheduler at the date
+     * of their next internal event.
+     */
+    void schedule(const std::vector<Simulator*>& simulators);
+
+    /**
+     * @brief Finish run() after the output functions of the dynamics for
+     * the bags without executive when no event view and no profiler are
+     * used: only the transitions of the dynamics and the timed
+     * observations are processed.
+     */
+    void runDynamics(Bag& bag);
+
+    /**
+     * @brief Replace run() in a distributed simulation: process the bag of
+     * this process, exchange the external events with the other
+     * processes, then the date of the next bag and the observations.
+     */
+    void runDistributed();
+
+    /**
+     * @brief Send the m_records of all the processes to the process 0 which
+     * calls the plug-ins in the order of the dates.
+     */
+    void exchangeRecords();
+
+    /**
+     * @brief With the setting vle.simulation.partition, build a Partition
+     * for each sub-model of the top coupled model and move the Simulators
+     * of the m_eventTable into the Scheduler of their partition.
+     * Partitions are not used if the top model has less than two
+     * sub-models or if the simulation has an executive. The optimistic
+     * simulation (setting vle.simulation.optimistic) needs the
+     * Dynamics::checkpoint() and Dynamics::restore() of all the models,
+     * otherwise the conservative windows are used.
+     */
+    void buildPartitions(const vpz::Model& mdls);
+
+    /**
+     * @brief Replace run() with partitions: run a window or a bag of all
+     * the partitions then the timed observations.
+     */
+    void runPartitions();
+
+    /**
+     * @brief Process, in the thread of the partition @e index, all the bags
+     * of the partition before @e window and lower or equal to @e limit.
+     * Exceptions are stored into the partition.
+     */
+    void runWindow(std::size_t index, Time window, Time limit) noexcept;
+
+    /**
+     * @brief Run the optimistic simulation until the global virtual time
+     * (the lower date of the next bags and of the messages not yet
+     * received) is greater than @e limit. Between two rounds, the bags
+     * before the global virtual time are committed: their states are
+     * freed and their observations are sent to the views.
+     */
+    void runOptimistic(Time limit);
+
+    /**
+     * @brief Process, in the thread of the partition @e index, the messages
+     * received and the bags lower or equal to @e limit. Exceptions are
+     * stored into the partition.
+     */
+    void runOptimisticRound(std::size_t index, Time limit) noexcept;
+
+    /**
+     * @brief Process the bag at @e date of the partition @e index and save
+     * the states of its Simulators before the transitions.
+     */
+    void runOptimisticBag(std::size_t index, PartitionDate date);
+
+    /**
+     * @brief Move the messages of the inbox of the partition @e index into
+     * its pending messages. A message before a processed bag (a straggler)
+     * rolls back the partition.
+     */
+    void receivePartitionMessages(std::size_t index);
+
+    /**
+     * @brief Undo the bags of the partition @e index greater or equal to @e
+     * date: restore the states of the Simulators, push back the messages
+     * received and send an anti message for each message sent.
+     */
+    void rollbackPartition(std::size_t index, PartitionDate date);
+
+    /**
+     * @brief Process the bag of all the partitions at @e time: the events
+     * between partitions are sent during this bag.
+     */
+    void runPartitionsBag(Time time);
+
+    /**
+     * @brief Send the outputs of the @e number first simulators to their
+     * targets, into the Scheduler of the target partition.
+     * @throw utils::InternalError if @e partition is a valid index and a
+     * target belongs to another partition.
+     */
+    void dispatchPartitionEvent(std::vector<Simulator*>& simulators,
+                                std::size_t number,
+                                std::size_t partition);
+
+    /**
+     * @brief Compute the transition of the simulator and push its next
+     * internal event into the Scheduler of @e partition.
+     * @throw utils::ModellingError if a boundary simulator breaks its
+     * lookahead.
+     */
+    void partitionTransition(Partition& partition,
+                             Simulator* simulator,
+                             Time time);
+
+    /**
+     * @brief Get the date of the next bag of the partitions.
+     */
+    Time partitionsNextTime() const noexcept;
+
+    /**
+     * @brief Process the observations of the timed views before @e next
+     * if the next bag is scheduled for a different date than
+     * m_currentTime and finalize the timed views after the duration.
+     */
+    void processTimedObservations(Time next);
+
     /**
      * @brief Build, for each vpz::View a StreamWriter and View.
      * @throw utils::ArgError if the output or the view does not exist.
@@ -315,6 +609,17 @@ private:
     void dispatchExternalEvent(std::vector<Simulator*>& sim,
                                const std::size_t number);
 
+    /**
+     * Push the internal event of the simulator in the scheduler.
+     */
+    void addInternal(Simulator* simulator, Time tn)
+    {
+        if (m_profile)
+            ++m_profile->scheduler_internal;
+
+        m_eventTable.addInternal(simulator, tn);
+    }
+
     /**
      * @brief Delete the atomic model from Graph, the Simulator from
      * Coordinator and clean all events on devs::EventTable. Do not
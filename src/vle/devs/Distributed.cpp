@@ -0,0 +1,310 @@
+/*
+ * This file is part of VLE, a framework for multi-modeling, simulation
+ * and analysis of complex dynamical systems.
+ * http://www.vle-project.org
+ *
+ * Copyright (c) 2003-2017 Gauthier Quesnel <gauthier.quesnel@inra.fr>
+ * Copyright (c) 2003-2017 ULCO http://www.univ-littoral.fr
+ * Copyright (c) 2007-2017 INRA http://www.inra.fr
+ *
+ * See the AUTHORS or Authors.txt file for copyright owners and
+ * contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <vle/devs/Distributed.hpp>
+#include <vle/utils/Exception.hpp>
+#include <vle/utils/i18n.hpp>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace vle {
+namespace devs {
+
+#ifndef _WIN32
+
+/**
+ * A DistributedChannel with a Unix socket between each pair of processes.
+ * The buffers are sent with their size, all the sockets are written and
+ * read together with poll() to avoid a deadlock with large buffers.
+ */
+class SocketChannel : public DistributedChannel
+{
+    struct Peer
+    {
+        int fd = -1;
+        std::uint64_t size = 0;
+        std::size_t written = 0;
+        std::size_t read = 0;
+    };
+
+    std::vector<int> m_sockets;
+    std::vector<pid_t> m_children;
+    int m_rank;
+
+public:
+    SocketChannel(int rank,
+                  std::vector<int> sockets,
+                  std::vector<pid_t> children)
+      : m_sockets(std::move(sockets))
+      , m_children(std::move(children))
+      , m_rank(rank)
+    {
+        for (auto fd : m_sockets)
+            if (fd >= 0)
+                ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    }
+
+    virtual ~SocketChannel()
+    {
+        for (auto fd : m_sockets)
+            if (fd >= 0)
+                ::close(fd);
+
+        for (auto pid : m_children) {
+            int status;
+            while (::waitpid(pid, &status, 0) == -1 and errno == EINTR)
+                ;
+        }
+    }
+
+    virtual int rank() const override
+    {
+        return m_rank;
+    }
+
+    virtual int size() const override
+    {
+        return static_cast<int>(m_sockets.size());
+    }
+
+    virtual std::vector<std::string> exchange(
+      std::vector<std::string> buffers) override
+    {
+        const auto size = m_sockets.size();
+        std::vector<std::string> result(size);
+        std::vector<Peer> peers(size);
+        std::vector<std::uint64_t> headers(size);
+
+        result[m_rank] = std::move(buffers[m_rank]);
+
+        //
+        // The first 8 bytes written and read are the size of the buffer.
+        //
+        std::size_t remaining = 0;
+        for (std::size_t i = 0; i != size; ++i) {
+            if (static_cast<int>(i) == m_rank)
+                continue;
+
+            headers[i] = buffers[i].size();
+            peers[i].fd = m_sockets[i];
+            remaining += 2;
+        }
+
+        const std::size_t header = sizeof(std::uint64_t);
+        std::vector<pollfd> fds;
+
+        while (remaining) {
+            fds.clear();
+            for (std::size_t i = 0; i != size; ++i) {
+                if (peers[i].fd < 0)
+                    continue;
+
+                short events = 0;
+                if (peers[i].written < header + buffers[i].size())
+                    events |= POLLOUT;
+                if (peers[i].read < header or
+                    peers[i].read < header + peers[i].size)
+                    events |= POLLIN;
+
+                if (events)
+                    fds.push_back(pollfd{ peers[i].fd, events, 0 });
+            }
+
+            if (::poll(fds.data(), fds.size(), -1) == -1) {
+                if (errno == EINTR)
+                    continue;
+
+                throw utils::InternalError(
+                  _("Distributed: poll fails: %s"), std::strerror(errno));
+            }
+
+            for (const auto& elem : fds) {
+                std::size_t i = 0;
+                while (peers[i].fd != elem.fd)
+                    ++i;
+
+                auto& peer = peers[i];
+
+                if (elem.revents & POLLOUT)
+                    remaining -= write(peer, headers[i], buffers[i]);
+
+                if (elem.revents & (POLLIN | POLLHUP | POLLERR))
+                    remaining -= read(peer, i, result[i]);
+            }
+        }
+
+        return result;
+    }
+
+private:
+    /* Write the next bytes of the header or of the buffer. Returns 1 if
+     * all the bytes are written. */
+    std::size_t write(Peer& peer,
+                      const std::uint64_t& header,
+                      const std::string& buffer)
+    {
+        const std::size_t length = sizeof(std::uint64_t);
+        const char* data;
+        std::size_t size;
+
+        if (peer.written < length) {
+            data = reinterpret_cast<const char*>(&header) + peer.written;
+            size = length - peer.written;
+        } else {
+            data = buffer.data() + peer.written - length;
+            size = buffer.size() - (peer.written - length);
+        }
+
+        auto ret = ::send(peer.fd, data, size, MSG_NOSIGNAL);
+        if (ret == -1) {
+            if (errno == EAGAIN or errno == EWOULDBLOCK or errno == EINTR)
+                return 0;
+
+            throw utils::InternalError(
+              _("Distributed: fail to send to the process: %s"),
+              std::strerror(errno));
+        }
+
+        peer.written += static_cast<std::size_t>(ret);
+
+        return peer.written == length + buffer.size() ? 1 : 0;
+    }
+
+    /* Read the next bytes of the header or of the buffer. Returns 1 if all
+     * the bytes are read. */
+    std::size_t read(Peer& peer, std::size_t rank, std::string& buffer)
+    {
+        const std::size_t length = sizeof(std::uint64_t);
+        char* data;
+        std::size_t size;
+
+        if (peer.read < length) {
+            data = reinterpret_cast<char*>(&peer.size) + peer.read;
+            size = length - peer.read;
+        } else {
+            data = &buffer[0] + peer.read - length;
+            size = peer.size - (peer.read - length);
+        }
+
+        auto ret = ::recv(peer.fd, data, size, 0);
+        if (ret == -1) {
+            if (errno == EAGAIN or errno == EWOULDBLOCK or errno == EINTR)
+                return 0;
+
+            throw utils::InternalError(
+              _("Distributed: fail to receive from the process %lu: %s"),
+              static_cast<unsigned long>(rank),
+              std::strerror(errno));
+        }
+
+        if (ret == 0)
+            throw utils::InternalError(
+              _("Distributed: the process %lu closes the connection"),
+              static_cast<unsigned long>(rank));
+
+        peer.read += static_cast<std::size_t>(ret);
+
+        if (peer.read == length)
+            buffer.resize(peer.size);
+
+        return peer.read == length + peer.size ? 1 : 0;
+    }
+};
+
+std::unique_ptr<DistributedChannel>
+make_local_channel(int size)
+{
+    if (size < 1)
+        throw utils::InternalError(
+          _("Distributed: bad number of processes %d"), size);
+
+    std::vector<std::vector<int>> sockets(size, std::vector<int>(size, -1));
+
+    for (int i = 0; i < size; ++i) {
+        for (int j = i + 1; j < size; ++j) {
+            int fds[2];
+            if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1)
+                throw utils::InternalError(
+                  _("Distributed: fail to build the sockets: %s"),
+                  std::strerror(errno));
+
+            sockets[i][j] = fds[0];
+            sockets[j][i] = fds[1];
+        }
+    }
+
+    std::vector<pid_t> children;
+    int rank = 0;
+
+    for (int i = 1; i < size; ++i) {
+        auto pid = ::fork();
+
+        if (pid == -1)
+            throw utils::InternalError(
+              _("Distributed: fail to fork: %s"), std::strerror(errno));
+
+        if (pid == 0) {
+            rank = i;
+            children.clear();
+            break;
+        }
+
+        children.push_back(pid);
+    }
+
+    for (int i = 0; i < size; ++i)
+        if (i != rank)
+            for (auto fd : sockets[i])
+                if (fd >= 0)
+                    ::close(fd);
+
+    return std::unique_ptr<DistributedChannel>(
+      new SocketChannel(rank, std::move(sockets[rank]), std::move(children)));
+}
+
+#else
+
+std::unique_ptr<DistributedChannel>
+make_local_channel(int /* size */)
+{
+    throw utils::NotYetImplemented(
+      _("Distributed: local channel is not available on Windows"));
+}
+
+#endif
+}
+} // namespace vle devs
@@ -0,0 +1,98 @@
+/*
+ * This file is part of VLE, a framework for multi-modeling, simulation
+ * and analysis of complex dynamical systems.
+ * http://www.vle-project.org
+ *
+ * Copyright (c) 2003-2017 Gauthier Quesnel <gauthier.quesnel@inra.fr>
+ * Copyright (c) 2003-2017 ULCO http://www.univ-littoral.fr
+ * Copyright (c) 2007-2017 INRA http://www.inra.fr
+ *
+ * See the AUTHORS or Authors.txt file for copyright owners and
+ * contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef VLE_DEVS_DISTRIBUTED_HPP
+#define VLE_DEVS_DISTRIBUTED_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <vle/DllDefines.hpp>
+
+namespace vle {
+namespace devs {
+
+/**
+ * @brief The communication between the processes of a distributed
+ * simulation. Each process (a rank) simulates the atomic models of some
+ * sub-models of the top coupled model and exchanges, at each bag, the
+ * external events, the date of its next bag and the observations with the
+ * other processes.
+ *
+ * The library provides an implementation over Unix sockets (see
+ * make_local_channel()), mvle provides one over MPI.
+ */
+class VLE_API DistributedChannel
+{
+public:
+    virtual ~DistributedChannel() = default;
+
+    /**
+     * Get the rank of this process, between 0 and size() - 1. The process
+     * 0 sends the observations to the plug-ins.
+     */
+    virtual int rank() const = 0;
+
+    /**
+     * Get the number of processes.
+     */
+    virtual int size() const = 0;
+
+    /**
+     * Send the buffer @e buffers[i] to the process @e i and wait the
+     * buffers of all the processes. All the processes call exchange()
+     * together.
+     *
+     * @param buffers A vector of size() buffers, the buffer of this process
+     * is returned without copy.
+     * @return The buffers received, indexed by rank.
+     * @throw utils::InternalError if a process fails.
+     */
+    virtual std::vector<std::string> exchange(
+      std::vector<std::string> buffers) = 0;
+};
+
+/**
+ * @brief Fork @e size - 1 processes connected to the calling process with
+ * Unix sockets and return the channel of each process: rank 0 for the
+ * calling process, 1 to @e size - 1 for the children. A child must
+ * terminate with _exit() after the simulation. The channel of the rank 0
+ * waits the children when it is destroyed.
+ *
+ * Fork before the creation of threads (for instance before the
+ * construction of the devs::RootCoordinator).
+ *
+ * @throw utils::InternalError if the sockets or the processes can not be
+ * created.
+ * @throw utils::NotYetImplemented on Windows.
+ */
+VLE_API std::unique_ptr<DistributedChannel>
+make_local_channel(int size);
+}
+} // namespace vle devs
+
+#endif
@@ -42,9 +42,18 @@ Dynamics::Dynamics(const DynamicsInit& init, const InitEventList& /* events */)
   : m_context(init.context)
   , m_model(init.model)
   , m_packageid(init.packageid)
+  , m_seed(init.seed)
+  , m_replicate(init.replicate)
 {
 }
 
+utils::Rand
+Dynamics::buildRand() const
+{
+    return utils::Rand(
+      m_seed, utils::Rand::stream(m_model.getCompleteName()), m_replicate);
+}
+
 std::string
 Dynamics::getPackageDir() const
 {
@@ -194,5 +203,29 @@ Dynamics::getPackageExpFile(const std::string& name) const
           (fmt(_("Package '%1%' is not installed")) % *m_packageid).str());
     }
 }
+
+std::unique_ptr<vle::value::Value>
+Dynamics::checkpoint() const
+{
+    throw utils::NotYetImplemented(
+      _("Model '%s' does not implement the checkpoint function"),
+      m_model.getCompleteName().c_str());
+}
+
+void
+Dynamics::restore(const vle::value::Value& /* state */, Time /* time */)
+{
+    throw utils::NotYetImplemented(
+      _("Model '%s' does not implement the restore function"),
+      m_model.getCompleteName().c_str());
+}
+
+void
+Dynamics::updateConditions(const InitEventList& /* events */, Time /* time */)
+{
+    throw utils::NotYetImplemented(
+      _("Model '%s' does not implement the updateConditions function"),
+      m_model.getCompleteName().c_str());
+}
 }
 } // namespace vle devs
@@ -35,7 +35,9 @@
 #include <vle/devs/ObservationEvent.hpp>
 #include <vle/devs/Time.hpp>
 #include <vle/utils/Context.hpp>
+#include <vle/utils/Memory.hpp>
 #include <vle/utils/PackageTable.hpp>
+#include <vle/utils/Rand.hpp>
 #include <vle/utils/Types.hpp>
 #include <vle/value/Boolean.hpp>
 #include <vle/value/Double.hpp>
@@ -78,6 +80,7 @@ using PackageId = utils::PackageTable::index;
  * must be inherits to build simulation components.
  */
 class VLE_API Dynamics
+  : public utils::MemoryTagged<utils::MemoryTag::model>
 {
 public:
     /**
@@ -264,7 +267,56 @@ public:
     {
     }
 
-    /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+    /**
+     * @brief The lookahead of the model: after a transition at date t, the
+     * model does not send an output before t + lookahead(), ie. the
+     * timeAdvance() is never lower. With the setting
+     * vle.simulation.partition, the sub-models of the top coupled model run
+     * in parallel until the next event sent between two of them: the
+     * lookahead of the models connected to another sub-model enlarges
+     * these windows.
+     * @return a positive duration, 0 by default.
+     */
+    virtual Time lookahead() const
+    {
+        return 0.0;
+    }
+
+    /**
+     * @brief Build a copy of the state of the model to write a checkpoint
+     * of the simulation. The state is taken between two bags: no external
+     * event is pending.
+     *
+     * The default implementation throws: a simulation can be checkpointed
+     * only if all its atomic models override checkpoint() and restore().
+     * @return the state of the model. User values can not be stored.
+     * @throw utils::NotYetImplemented if the model can not be saved.
+     */
+    virtual std::unique_ptr<vle::value::Value> checkpoint() const;
+
+    /**
+     * @brief Replace the init() function when a simulation is restarted
+     * from a checkpoint.
+     * @param state the value built by checkpoint().
+     * @param time the date of the checkpoint.
+     * @throw utils::NotYetImplemented if the model can not be restored.
+     */
+    virtual void restore(const vle::value::Value& state, Time time);
+
+    /**
+     * @brief Called when a warm-started experimental frame branches a
+     * combination from the shared simulation (see
+     * manager::Manager::setWarmStart()): the conditions of the model are
+     * replaced by the values of the combination. The model keeps its state
+     * and its next internal event.
+     * @param events the new values of the conditions of the model.
+     * @param time the date of the branch.
+     * @throw utils::NotYetImplemented if the model can not change its
+     * conditions.
+     */
+    virtual void updateConditions(const InitEventList& events, Time time);
+
+    /* * ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
      * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
      * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
@@ -406,6 +458,21 @@ public:
 
     /*  - - - - - - - - - - - - - --ooOoo-- - - - - - - - - - - -  */
 
+    /**
+     * @brief Build a random number generator for this model: the stream
+     * of its complete name (see utils::Rand::stream()) with the seed and
+     * the replicate of the simulation (see vpz::Experiment::seed()). The
+     * numbers do not depend on the threads, partitions or processes of
+     * the simulation. Build it once, for instance in the constructor:
+     * @code
+     * m_rand = buildRand();
+     * @endcode
+     * @return A generator at the beginning of the stream of this model.
+     */
+    utils::Rand buildRand() const;
+
+    /*  - - - - - - - - - - - - - --ooOoo-- - - - - - - - - - - -  */
+
     /**
      * Get a Context shared pointer.
      */
@@ -423,6 +490,10 @@ private:
 
     ///< An iterator to std::set of the vle::utils::PackageTable.
     PackageId m_packageid;
+
+    ///< The seed and the replicate of the random number generators.
+    std::uint32_t m_seed;
+    std::uint32_t m_replicate;
 };
 
 #define Trace(ctx, priority, arg...)                                          \
@@ -206,5 +206,53 @@ DynamicsDbg::finish()
 
     mDynamics->finish();
 }
+
+std::unique_ptr<vle::value::Value>
+DynamicsDbg::checkpoint() const
+{
+    assert(mDynamics && "DynamicsDbg: missing set(Dynamics)");
+
+    vDbg(context(),
+         _("                     %s [DEVS] checkpoint\n"),
+         mName.c_str());
+
+    return mDynamics->checkpoint();
+}
+
+void
+DynamicsDbg::restore(const vle::value::Value& state, Time time)
+{
+    assert(mDynamics && "DynamicsDbg: missing set(Dynamics)");
+
+    vDbg(context(),
+         _("%.*g %s [DEVS] restore\n"),
+         std::numeric_limits<double>::max_digits10,
+         time,
+         mName.c_str());
+
+    mDynamics->restore(state, time);
+}
+
+Time
+DynamicsDbg::lookahead() const
+{
+    assert(mDynamics && "DynamicsDbg: missing set(Dynamics)");
+
+    return mDynamics->lookahead();
+}
+
+void
+DynamicsDbg::updateConditions(const InitEventList& events, Time time)
+{
+    assert(mDynamics && "DynamicsDbg: missing set(Dynamics)");
+
+    vDbg(context(),
+         _("%.*g %s [DEVS] update conditions\n"),
+         std::numeric_limits<double>::max_digits10,
+         time,
+         mName.c_str());
+
+    mDynamics->updateConditions(events, time);
+}
 }
 } // namespace vle devs
@@ -155,6 +155,15 @@ public:
      * finish method is invoked.
      */
     virtual void finish() override;
+
+    virtual Time lookahead() const override;
+
+    virtual std::unique_ptr<vle::value::Value> checkpoint() const override;
+
+    virtual void restore(const vle::value::Value& state, Time time) override;
+
+    virtual void updateConditions(const InitEventList& events,
+                                  Time time) override;
 };
 }
 } // namespace vle devs
@@ -27,6 +27,7 @@
 #ifndef VLE_DEVS_DYNAMICS_INIT_HPP
 #define VLE_DEVS_DYNAMICS_INIT_HPP
 
+#include <cstdint>
 #include <vle/utils/Context.hpp>
 #include <vle/utils/PackageTable.hpp>
 
@@ -46,6 +47,8 @@ struct DynamicsInit
     utils::ContextPtr context;
     const vpz::AtomicModel& model;
     utils::PackageTable::index packageid;
+    std::uint32_t seed = 0;
+    std::uint32_t replicate = 0;
 };
 
 struct ExecutiveInit
@@ -54,6 +57,8 @@ struct ExecutiveInit
     utils::ContextPtr context;
     const vpz::AtomicModel& model;
     utils::PackageTable::index packageid;
+    std::uint32_t seed = 0;
+    std::uint32_t replicate = 0;
 };
 
 struct DynamicsWrapperInit
@@ -62,6 +67,8 @@ struct DynamicsWrapperInit
     utils::ContextPtr context;
     const vpz::AtomicModel& model;
     utils::PackageTable::index packageid;
+    std::uint32_t seed = 0;
+    std::uint32_t replicate = 0;
 };
 }
 } // namespace vle devs
@@ -171,6 +171,15 @@ public:
      * finish method is invoked.
      */
     virtual void finish() override;
+
+    virtual Time lookahead() const override;
+
+    virtual std::unique_ptr<vle::value::Value> checkpoint() const override;
+
+    virtual void restore(const vle::value::Value& state, Time time) override;
+
+    virtual void updateConditions(const InitEventList& events,
+                                  Time time) override;
 };
 
 inline DynamicsObserver::DynamicsObserver(
@@ -316,6 +325,38 @@ DynamicsObserver::finish()
         mObservations.back().value = mDynamics->observation(event);
     }
 }
+
+inline Time
+DynamicsObserver::lookahead() const
+{
+    assert(mDynamics && "DynamicsObserver: missing set(Dynamics)");
+
+    return mDynamics->lookahead();
+}
+
+inline std::unique_ptr<vle::value::Value>
+DynamicsObserver::checkpoint() const
+{
+    assert(mDynamics && "DynamicsObserver: missing set(Dynamics)");
+
+    return mDynamics->checkpoint();
+}
+
+inline void
+DynamicsObserver::restore(const vle::value::Value& state, Time time)
+{
+    assert(mDynamics && "DynamicsObserver: missing set(Dynamics)");
+
+    mDynamics->restore(state, time);
+}
+
+inline void
+DynamicsObserver::updateConditions(const InitEventList& events, Time time)
+{
+    assert(mDynamics && "DynamicsObserver: missing set(Dynamics)");
+
+    mDynamics->updateConditions(events, time);
+}
 }
 } // namespace vle devs
 
@@ -32,7 +32,12 @@ namespace devs {
 
 DynamicsWrapper::DynamicsWrapper(const DynamicsWrapperInit& init,
                                  const devs::InitEventList& events)
-  : Dynamics(DynamicsInit{ init.context, init.model, init.packageid }, events)
+  : Dynamics(DynamicsInit{ init.context,
+                            init.model,
+                            init.packageid,
+                            init.seed,
+                            init.replicate },
+             events)
   , m_library(init.library)
 {
 }
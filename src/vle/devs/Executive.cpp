@@ -35,7 +35,12 @@ namespace vle {
 namespace devs {
 
 Executive::Executive(const ExecutiveInit& init, const InitEventList& events)
-  : Dynamics(DynamicsInit{ init.context, init.model, init.packageid }, events)
+  : Dynamics(DynamicsInit{ init.context,
+                            init.model,
+                            init.packageid,
+                            init.seed,
+                            init.replicate },
+             events)
   , m_coordinator(init.coordinator)
 {
 }
@@ -119,6 +124,14 @@ Executive::createModel(const std::string& name,
     auto model = new vpz::AtomicModel(name, cpled());
     std::vector<std::string>::const_iterator it;
 
+    //
+    // The structure records the dynamics, the conditions and the
+    // observable to be written by a checkpoint.
+    //
+    model->setDynamics(dynamics);
+    model->setConditions(conds);
+    model->setObservables(observable);
+
     for (it = inputs.begin(); it != inputs.end(); ++it) {
         model->addInputPort(*it);
     }
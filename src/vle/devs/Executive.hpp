@@ -123,7 +123,10 @@ public:
     const vpz::Conditions& conditions() const;
 
     /**
-     * @brief Get a reference to the list of vpz::Conditions objects.
+     * @brief Get a reference to the list of vpz::Conditions objects. The
+     * first call copies the list of the coordinator but the copy shares
+     * its values: the non-const accessors of vpz::Condition clone a shared
+     * value before returning it, the coordinator's values are not modified.
      * @return A reference to the list of vpz::Conditions objects.
      */
     vpz::Conditions& conditions();
@@ -330,7 +333,7 @@ private:
     Coordinator& m_coordinator;
 
     /*
-     * Stores a clone of condition if the user call the @c conditions()
+     * Stores a copy of condition if the user call the @c conditions()
      * non constant function.
      */
     std::unique_ptr<vpz::Conditions> m_conditions;
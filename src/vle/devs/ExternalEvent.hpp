@@ -31,6 +31,8 @@
 #include <string>
 #include <vle/DllDefines.hpp>
 #include <vle/utils/Exception.hpp>
+#include <vle/utils/Memory.hpp>
+#include <vle/utils/Symbol.hpp>
 #include <vle/value/Map.hpp>
 
 namespace vle {
@@ -53,19 +55,28 @@ public:
     ExternalEvent& operator=(ExternalEvent&& other) = default;
     ~ExternalEvent() = default;
 
-    ExternalEvent(const std::string& port)
+    ExternalEvent(const utils::Symbol& port)
       : m_port(port)
     {
     }
 
     ExternalEvent(const std::shared_ptr<value::Value>& attributes,
-                  const std::string& port)
+                  const utils::Symbol& port)
       : m_attributes(attributes)
       , m_port(port)
     {
     }
 
     const std::string& getPortName() const
+    {
+        return m_port.str();
+    }
+
+    /**
+     * Get the interned name of the port, cheaper to compare, hash and copy
+     * than getPortName().
+     */
+    const utils::Symbol& getPort() const
     {
         return m_port;
     }
@@ -405,12 +416,14 @@ public:
 
 private:
     std::shared_ptr<value::Value> m_attributes;
-    std::string m_port;
+    utils::Symbol m_port;
 
     template <typename T, typename... Args>
     T& pp_add(Args&&... args)
     {
-        auto value = std::make_shared<T>(std::forward<Args>(args)...);
+        auto value = std::allocate_shared<T>(
+          utils::MemoryAllocator<T, utils::MemoryTag::event>(),
+          std::forward<Args>(args)...);
         auto ret = value.get();
         m_attributes = value;
         return *ret;
@@ -30,13 +30,21 @@
 #include <ostream>
 #include <vector>
 #include <vle/DllDefines.hpp>
+#include <vle/utils/Memory.hpp>
 
 namespace vle {
 namespace devs {
 
 class ExternalEvent;
 
-typedef std::vector<ExternalEvent> ExternalEventList;
+/**
+ * The events of a port or of a model. Its memory is accounted into
+ * utils::MemoryTag::event.
+ */
+typedef std::vector<ExternalEvent,
+                    utils::MemoryAllocator<ExternalEvent,
+                                           utils::MemoryTag::event>>
+  ExternalEventList;
 
 VLE_API std::ostream& operator<<(std::ostream& o,
                                  const ExternalEventList& evts);
@@ -91,79 +91,98 @@ void
 InitEventList::add(const std::string& name,
                    std::shared_ptr<const value::Value> value)
 {
-    std::swap(m_value[name], value);
+    std::swap(container()[name], value);
+}
+
+InitEventList::container_type&
+InitEventList::container()
+{
+    if (not m_value)
+        m_value = std::make_shared<container_type>();
+    else if (m_value.use_count() > 1)
+        m_value = std::make_shared<container_type>(*m_value);
+
+    return *m_value;
+}
+
+const InitEventList::container_type&
+InitEventList::empty_container() noexcept
+{
+    static const container_type empty;
+
+    return empty;
 }
 
 const std::shared_ptr<const value::Value>& InitEventList::operator[](
   const std::string& name) const
 {
-    return ::pp_get(m_value, name)->second;
+    return ::pp_get(value(), name)->second;
 }
 
 const std::shared_ptr<const value::Value>&
 InitEventList::get(const std::string& name) const
 {
-    return ::pp_get(m_value, name)->second;
+    return ::pp_get(value(), name)->second;
 }
 
 const value::Map&
 InitEventList::getMap(const std::string& name) const
 {
-    return ::pp_get_value(m_value, name).toMap();
+    return ::pp_get_value(value(), name).toMap();
 }
 
 const value::Set&
 InitEventList::getSet(const std::string& name) const
 {
-    return ::pp_get_value(m_value, name).toSet();
+    return ::pp_get_value(value(), name).toSet();
 }
 
 const value::Matrix&
 InitEventList::getMatrix(const std::string& name) const
 {
-    return ::pp_get_value(m_value, name).toMatrix();
+    return ::pp_get_value(value(), name).toMatrix();
 }
 
 const std::string&
 InitEventList::getString(const std::string& name) const
 {
-    return ::pp_get_value(m_value, name).toString().value();
+    return ::pp_get_value(value(), name).toString().value();
 }
 
 bool
 InitEventList::getBoolean(const std::string& name) const
 {
-    return ::pp_get_value(m_value, name).toBoolean().value();
+    return ::pp_get_value(value(), name).toBoolean().value();
 }
 
 int32_t
 InitEventList::getInt(const std::string& name) const
 {
-    return ::pp_get_value(m_value, name).toInteger().value();
+    return ::pp_get_value(value(), name).toInteger().value();
 }
 
 double
 InitEventList::getDouble(const std::string& name) const
 {
-    return ::pp_get_value(m_value, name).toDouble().value();
+    return ::pp_get_value(value(), name).toDouble().value();
 }
 
 const std::string&
 InitEventList::getXml(const std::string& name) const
 {
-    return ::pp_get_value(m_value, name).toXml().value();
+    return ::pp_get_value(value(), name).toXml().value();
 }
 
 const value::Table&
 InitEventList::getTable(const std::string& name) const
 {
-    return ::pp_get_value(m_value, name).toTable();
+    return ::pp_get_value(value(), name).toTable();
 }
 
 const value::Tuple&
 InitEventList::getTuple(const std::string& name) const
 {
-    return ::pp_get_value(m_value, name).toTuple();
+    return ::pp_get_value(value(), name).toTuple();
 }
 }
 } // namespace vle devs
@@ -27,6 +27,7 @@
 #ifndef VLE_DEVS_INITEVENTLIST_HPP
 #define VLE_DEVS_INITEVENTLIST_HPP
 
+#include <memory>
 #include <unordered_map>
 #include <vle/DllDefines.hpp>
 #include <vle/value/Value.hpp>
@@ -48,6 +49,12 @@ public:
     using const_iterator = container_type::const_iterator;
     using value_type = container_type::value_type;
 
+    /**
+     * @brief Copies of an InitEventList share the same storage: the
+     * models built from the same conditions read the same container and
+     * the same values. The storage is copied by the first modification
+     * (add() or the non-constant iterators) of a shared InitEventList.
+     */
     InitEventList() = default;
     InitEventList(const InitEventList&) = default;
     InitEventList(InitEventList&&) = default;
@@ -99,7 +106,7 @@ public:
      */
     inline const container_type& value() const
     {
-        return m_value;
+        return m_value ? *m_value : empty_container();
     }
 
     /**
@@ -108,7 +115,7 @@ public:
      */
     inline bool empty() const
     {
-        return m_value.empty();
+        return value().empty();
     }
 
     /**
@@ -118,7 +125,7 @@ public:
      */
     inline size_type size() const
     {
-        return m_value.size();
+        return value().size();
     }
 
     /**
@@ -127,7 +134,7 @@ public:
      */
     inline const_iterator begin() const
     {
-        return m_value.begin();
+        return value().begin();
     }
 
     /**
@@ -136,25 +143,27 @@ public:
      */
     inline const_iterator end() const
     {
-        return m_value.end();
+        return value().end();
     }
 
     /**
-     * @brief Get the first constant iterator from Map.
+     * @brief Get the first iterator from Map. The storage is copied first
+     * if it is shared with another InitEventList.
      * @return the first iterator.
      */
     inline iterator begin()
     {
-        return m_value.begin();
+        return container().begin();
     }
 
     /**
-     * @brief Get the last constant iterator from Map.
+     * @brief Get the last iterator from Map. The storage is copied first
+     * if it is shared with another InitEventList.
      * @return the last iterator.
      */
     inline iterator end()
     {
-        return m_value.end();
+        return container().end();
     }
 
     /**
@@ -164,7 +173,7 @@ public:
      */
     inline const_iterator find(const std::string& key) const
     {
-        return m_value.find(key);
+        return value().find(key);
     }
 
     /**
@@ -256,7 +265,20 @@ public:
     const value::Matrix& getMatrix(const std::string& name) const;
 
 private:
-    container_type m_value;
+    /**
+     * @brief Get a writable access to the storage, copy it if it is
+     * shared with another InitEventList.
+     * @return A reference to the storage of this InitEventList.
+     */
+    container_type& container();
+
+    /**
+     * @brief The storage of the default constructed InitEventList.
+     * @return A reference to an empty container.
+     */
+    static const container_type& empty_container() noexcept;
+
+    std::shared_ptr<container_type> m_value;
 };
 }
 } // namespace vle devs
@@ -54,6 +54,8 @@ ModelFactory::ModelFactory(utils::ContextPtr context,
   , mDynamics(dyn)
   , mClasses(cls)
   , mExperiment(exp)
+  , mSeed(exp.seed())
+  , mReplicate(exp.replicate())
 {
 }
 
@@ -64,30 +66,24 @@ ModelFactory::createModel(Coordinator& coordinator,
                           const std::string& dynamics,
                           const std::vector<std::string>& conditions,
                           const std::string& observable)
+{
+    createModel(coordinator,
+                model,
+                dynamics,
+                buildInitEventList(experiment_conditions, conditions),
+                observable);
+}
+
+void
+ModelFactory::createModel(Coordinator& coordinator,
+                          vpz::AtomicModel* model,
+                          const std::string& dynamics,
+                          const InitEventList& initValues,
+                          const std::string& observable)
 {
     const vpz::Dynamic& dyn = mDynamics.get(dynamics);
     auto sim = coordinator.addModel(model);
 
-    InitEventList initValues;
-
-    if (not conditions.empty()) {
-        for (const auto& elem : conditions) {
-            const auto& cnd = experiment_conditions.get(elem);
-            auto vl = cnd.fillWithFirstValues();
-
-            for (auto& elem : vl) {
-                if (initValues.exist(elem.first))
-                    throw utils::InternalError(
-                      (fmt(_("Multiples condition with the same init port "
-                             "name '%1%'")) %
-                       elem.first)
-                        .str());
-
-                initValues.add(elem.first, elem.second);
-            }
-        }
-    }
-
     sim->addDynamics(
       attachDynamics(coordinator, sim, dyn, initValues, observable));
 
@@ -118,17 +114,65 @@ ModelFactory::createModels(Coordinator& coordinator, const vpz::Model& model)
             vpz::BaseModel::getAtomicModelList(mdl, atomicmodellist);
         }
 
+        // The atomic models with the same list of conditions share the
+        // same InitEventList and so the same values.
+        std::unordered_map<std::string, InitEventList> cache;
+        std::string key;
+
         for (auto& elem : atomicmodellist) {
+            if (not coordinator.isLocalModel(elem))
+                continue;
+
+            key.clear();
+            for (const auto& cnd : elem->conditions()) {
+                key += cnd;
+                key += ',';
+            }
+
+            auto it = cache.find(key);
+            if (it == cache.end())
+                it = cache
+                       .emplace(key,
+                                buildInitEventList(mExperiment.conditions(),
+                                                   elem->conditions()))
+                       .first;
+
             createModel(coordinator,
-                        mExperiment.conditions(),
                         elem,
-                        (elem)->dynamics(),
-                        (elem)->conditions(),
-                        (elem)->observables());
+                        elem->dynamics(),
+                        it->second,
+                        elem->observables());
         }
     }
 }
 
+InitEventList
+ModelFactory::buildInitEventList(const vpz::Conditions& experiment_conditions,
+                                 const std::vector<std::string>& conditions)
+{
+    InitEventList initValues;
+
+    for (const auto& elem : conditions) {
+        const auto& cnd = experiment_conditions.get(elem);
+
+        for (const auto& port : cnd.conditionvalues()) {
+            if (port.second.empty())
+                continue;
+
+            if (initValues.exist(port.first))
+                throw utils::InternalError(
+                  (fmt(_("Multiples condition with the same init port "
+                         "name '%1%'")) %
+                   port.first)
+                    .str());
+
+            initValues.add(port.first, port.second.front());
+        }
+    }
+
+    return initValues;
+}
+
 vpz::BaseModel*
 ModelFactory::createModelFromClass(Coordinator& coordinator,
                                    vpz::CoupledModel* parent,
@@ -159,7 +203,9 @@ buildNewDynamicsWrapper(utils::ContextPtr context,
                         devs::Simulator* atom,
                         const vpz::Dynamic& dyn,
                         const InitEventList& events,
-                        void* symbol)
+                        void* symbol,
+                        std::uint32_t seed,
+                        std::uint32_t replicate)
 {
     typedef Dynamics* (*fctdw)(const DynamicsWrapperInit&,
                                const InitEventList&);
@@ -173,7 +219,9 @@ buildNewDynamicsWrapper(utils::ContextPtr context,
           fct(DynamicsWrapperInit{ dyn.library(),
                                    context,
                                    *atom->getStructure(),
-                                   pkg_table.get(dyn.package()) },
+                                   pkg_table.get(dyn.package()),
+                                   seed,
+                                   replicate },
               events));
     } catch (const std::exception& e) {
         throw utils::ModellingError(
@@ -261,7 +309,9 @@ buildNewDynamics(utils::ContextPtr context,
                  devs::Simulator* atom,
                  const vpz::Dynamic& dyn,
                  const InitEventList& events,
-                 void* symbol)
+                 void* symbol,
+                 std::uint32_t seed,
+                 std::uint32_t replicate)
 {
     typedef Dynamics* (*fctdyn)(const DynamicsInit&, const InitEventList&);
 
@@ -272,7 +322,9 @@ buildNewDynamics(utils::ContextPtr context,
 
         DynamicsInit init{ context,
                            *atom->getStructure(),
-                           pkg_table.get(dyn.package()) };
+                           pkg_table.get(dyn.package()),
+                           seed,
+                           replicate };
         auto dynamics = std::unique_ptr<Dynamics>(fct(init, events));
 
         if (haveEventView(vpzviews, observable)) {
@@ -320,7 +372,9 @@ buildNewExecutive(utils::ContextPtr context,
                   devs::Simulator* atom,
                   const vpz::Dynamic& dyn,
                   const InitEventList& events,
-                  void* symbol)
+                  void* symbol,
+                  std::uint32_t seed,
+                  std::uint32_t replicate)
 {
     typedef Dynamics* (*fctexe)(const ExecutiveInit&, const InitEventList&);
 
@@ -332,11 +386,15 @@ buildNewExecutive(utils::ContextPtr context,
         ExecutiveInit executiveinit{ coordinator,
                                      context,
                                      *atom->getStructure(),
-                                     pkg_table.get(dyn.package()) };
+                                     pkg_table.get(dyn.package()),
+                                     seed,
+                                     replicate };
 
         DynamicsInit init{ context,
                            *atom->getStructure(),
-                           pkg_table.get(dyn.package()) };
+                           pkg_table.get(dyn.package()),
+                           seed,
+                           replicate };
 
         auto executive = std::unique_ptr<Dynamics>(fct(executiveinit, events));
 
@@ -428,7 +486,9 @@ ModelFactory::attachDynamics(Coordinator& coordinator,
                                 atom,
                                 dyn,
                                 events,
-                                symbol);
+                                symbol,
+                                mSeed,
+                                mReplicate);
     case utils::Context::ModuleType::MODULE_DYNAMICS_EXECUTIVE:
         return buildNewExecutive(mContext,
                                  mEventViews,
@@ -438,9 +498,12 @@ ModelFactory::attachDynamics(Coordinator& coordinator,
                                  atom,
                                  dyn,
                                  events,
-                                 symbol);
+                                 symbol,
+                                 mSeed,
+                                 mReplicate);
     case utils::Context::ModuleType::MODULE_DYNAMICS_WRAPPER:
-        return buildNewDynamicsWrapper(mContext, atom, dyn, events, symbol);
+        return buildNewDynamicsWrapper(
+          mContext, atom, dyn, events, symbol, mSeed, mReplicate);
     default:
         throw utils::InternalError("Missing type");
     }
@@ -227,7 +227,30 @@ public:
                                          const std::string& modelname,
                                          const vpz::Conditions& conditions);
 
+    /**
+     * @brief Build the InitEventList of an atomic model: the first value
+     * of each port of the conditions. Values are shared with the
+     * conditions, they are not cloned.
+     * @param experiment_conditions the conditions of the experiment.
+     * @param conditions the names of the conditions of the model.
+     * @throw utils::InternalError if two conditions define the same port.
+     * @throw utils::ArgError if a condition does not exist.
+     */
+    static InitEventList buildInitEventList(
+      const vpz::Conditions& experiment_conditions,
+      const std::vector<std::string>& conditions);
+
 private:
+    /**
+     * @brief Build a new devs::Simulator from the dynamics library and
+     * the already built InitEventList.
+     */
+    void createModel(Coordinator& coordinator,
+                     vpz::AtomicModel* model,
+                     const std::string& dynamics,
+                     const InitEventList& initValues,
+                     const std::string& observable);
+
     utils::ContextPtr mContext;
     std::map<std::string, View>& mEventViews;
 
@@ -236,6 +259,9 @@ private:
     vpz::Experiment mExperiment; /**< A reference to the
                                    vpz::Experiment. */
 
+    std::uint32_t mSeed;      /**< The seed of the models. */
+    std::uint32_t mReplicate; /**< The replicate of the simulation. */
+
     /**
      * Try to open the plug-in and return the type of opened plugin
      * (MODULE_DYNAMICS, MODULE_DYNAMICS_WRAPPER or MODULE_EXECUTIVE).
@@ -31,6 +31,7 @@
 #include <vle/DllDefines.hpp>
 #include <vle/devs/Time.hpp>
 #include <vle/utils/Exception.hpp>
+#include <vle/utils/Symbol.hpp>
 
 namespace vle {
 namespace devs {
@@ -50,8 +51,8 @@ public:
     ObservationEvent& operator=(const ObservationEvent& other) = delete;
 
     ObservationEvent(const Time& time,
-                     const std::string& viewname,
-                     const std::string& portName)
+                     const utils::Symbol& viewname,
+                     const utils::Symbol& portName)
       : m_time(time)
       , m_viewName(viewname)
       , m_portName(portName)
@@ -62,12 +63,12 @@ public:
 
     const std::string& getViewName() const
     {
-        return m_viewName;
+        return m_viewName.str();
     }
 
     const std::string& getPortName() const
     {
-        return m_portName;
+        return m_portName.str();
     }
 
     bool onPort(std::string const& portName) const
@@ -85,8 +86,8 @@ public:
 
 private:
     Time m_time;
-    std::string m_viewName;
-    std::string m_portName;
+    utils::Symbol m_viewName;
+    utils::Symbol m_portName;
 };
 }
 } // namespace vle devs
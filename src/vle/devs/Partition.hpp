@@ -0,0 +1,367 @@
+/*
+ * This file is part of VLE, a framework for multi-modeling, simulation
+ * and analysis of complex dynamical systems.
+ * http://www.vle-project.org
+ *
+ * Copyright (c) 2003-2017 Gauthier Quesnel <gauthier.quesnel@inra.fr>
+ * Copyright (c) 2003-2017 ULCO http://www.univ-littoral.fr
+ * Copyright (c) 2007-2017 INRA http://www.inra.fr
+ *
+ * See the AUTHORS or Authors.txt file for copyright owners and
+ * contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VLE_DEVS_PARTITION_HPP
+#define VLE_DEVS_PARTITION_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <vle/devs/Scheduler.hpp>
+#include <vle/devs/Simulator.hpp>
+#include <vle/devs/View.hpp>
+#include <vle/utils/Trace.hpp>
+
+namespace vle {
+namespace devs {
+
+/**
+ * An observation of an event view produced during a window: the views are
+ * not thread safe, the observations are sent at the end of the window in
+ * the order of the sequential simulation: by date, by number of the bag
+ * at this date (models with a null time advance) then by index of the
+ * Simulator.
+ */
+struct PartitionObservation
+{
+    PartitionObservation(Time time,
+                         std::uint64_t bag,
+                         Simulator* simulator,
+                         Observation&& obs)
+      : time(time)
+      , bag(bag)
+      , simulator(simulator)
+      , observation(std::move(obs))
+    {
+    }
+
+    Time time;
+    std::uint64_t bag;
+    Simulator* simulator;
+    Observation observation;
+};
+
+/**
+ * The date of a bag of the optimistic simulation: the time and the number
+ * of the bag at this time. The bags of a time (models with a null time
+ * advance) are numbered as in the sequential simulation: a message sent
+ * by the bag (t, n) is received by the bag (t, n) of its target.
+ */
+using PartitionDate = std::pair<Time, std::uint64_t>;
+
+/**
+ * An event sent to a Simulator of another partition by the optimistic
+ * simulation. An \e anti message cancels the message with the same \e
+ * source and \e id after a rollback of the source partition. The \e
+ * inserted date and the \e index of the sending Simulator give the order
+ * of the events received by a bag (see Scheduler::addInternal()).
+ */
+struct PartitionMessage
+{
+    PartitionDate date;
+    Simulator* target;
+    std::string port;
+    std::shared_ptr<value::Value> value;
+    std::size_t source;
+    std::uint64_t id;
+    std::int64_t inserted;
+    std::uint64_t index;
+    bool anti;
+};
+
+/**
+ * The state of a Simulator before the transition of a bag: the value
+ * returned by Dynamics::checkpoint(), the date of its next internal event
+ * and the key of the bag which scheduled it.
+ */
+struct PartitionState
+{
+    PartitionState(Simulator* simulator,
+                   std::unique_ptr<value::Value> state,
+                   Time tn,
+                   std::int64_t inserted)
+      : simulator(simulator)
+      , state(std::move(state))
+      , tn(tn)
+      , inserted(inserted)
+    {
+    }
+
+    Simulator* simulator;
+    std::unique_ptr<value::Value> state;
+    Time tn;
+    std::int64_t inserted;
+};
+
+/**
+ * A bag processed by the optimistic simulation and all the data needed to
+ * undo it: the states of its Simulators, the messages received from the
+ * other partitions and the messages sent to them. The observations are
+ * sent to the views when the bag is committed.
+ */
+struct PartitionBag
+{
+    PartitionBag(PartitionDate date)
+      : date(date)
+    {
+    }
+
+    PartitionDate date;
+    std::vector<PartitionState> states;
+    std::vector<PartitionMessage> received;
+    std::vector<PartitionMessage> sent;
+    std::vector<PartitionObservation> observations;
+};
+
+/**
+ * @brief A Partition groups the Simulators of a sub-model of the top
+ * coupled model with their own Scheduler.
+ *
+ * The Simulators of the \e boundary have an output port connected to a
+ * Simulator of another partition. With its \e lookahead (see
+ * Dynamics::lookahead()), a boundary Simulator gives the lower date of the
+ * next event this partition can send to the others. The optimistic
+ * simulation does not use the lookahead: the partitions exchange messages
+ * and undo the bags processed too early.
+ */
+struct Partition
+{
+    Scheduler scheduler;
+
+    /// The boundary Simulators and their lookahead.
+    std::unordered_map<Simulator*, Time> boundary;
+
+    /// The observations of the event views during a window.
+    std::vector<PartitionObservation> observations;
+
+    /// The date of the last bag of the window.
+    Time last = negativeInfinity;
+
+    /// The exception thrown during a window.
+    std::exception_ptr error;
+
+    /// The optimistic simulation: the messages received but not yet
+    /// processed, sorted by date.
+    std::multimap<PartitionDate, PartitionMessage> pending;
+
+    /// The bags processed after the global virtual time.
+    std::deque<PartitionBag> history;
+
+    /// The messages sent by the other partitions during a round.
+    std::vector<PartitionMessage> inbox;
+    std::mutex inbox_mutex;
+
+    /// The identifier of the next message sent by this partition.
+    std::uint64_t next_id = 0;
+
+    /// The number of bags undone by rollbacks.
+    std::uint64_t rollbacks = 0;
+
+    /**
+     * Get the date of the next bag: the next internal event or the next
+     * message received from another partition. The Simulators with a null
+     * time advance are in the bag following the last one.
+     */
+    PartitionDate nextDate() const noexcept
+    {
+        PartitionDate result(scheduler.getNextTime(), 0);
+
+        if (not history.empty() and history.back().date.first == result.first)
+            result.second = history.back().date.second + 1;
+
+        if (not pending.empty())
+            result = std::min(result, pending.begin()->first);
+
+        return result;
+    }
+
+    Time nextTime() const noexcept
+    {
+        return nextDate().first;
+    }
+
+    /**
+     * Get the lower date of the messages of the inbox.
+     */
+    Time inboxTime() noexcept
+    {
+        std::lock_guard<std::mutex> lock(inbox_mutex);
+
+        auto result = infinity;
+        for (const auto& elem : inbox)
+            result = std::min(result, elem.date.first);
+
+        return result;
+    }
+
+    /**
+     * Take all the messages of the inbox.
+     */
+    std::vector<PartitionMessage> receive()
+    {
+        std::vector<PartitionMessage> result;
+
+        {
+            std::lock_guard<std::mutex> lock(inbox_mutex);
+            result.swap(inbox);
+        }
+
+        return result;
+    }
+
+    /**
+     * Push a message into the inbox. Called from the thread of another
+     * partition.
+     */
+    void send(PartitionMessage message)
+    {
+        std::lock_guard<std::mutex> lock(inbox_mutex);
+        inbox.emplace_back(std::move(message));
+    }
+
+    /**
+     * Get the lower date of an event sent by this partition to another
+     * partition.
+     */
+    Time bound() const noexcept
+    {
+        auto next = scheduler.getNextTime();
+        auto result = infinity;
+
+        for (const auto& elem : boundary)
+            result = std::min(
+              result, std::min(elem.first->getTn(), next + elem.second));
+
+        return result;
+    }
+};
+
+/**
+ * @brief Run a job for each partition, one thread by partition. The
+ * threads wait the next round between two windows, the caller runs the
+ * first partition.
+ */
+class PartitionWorkers
+{
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+    std::function<void(std::size_t)> m_job;
+    std::size_t m_round;
+    std::size_t m_remaining;
+    bool m_running;
+
+    void run(std::size_t index)
+    {
+        vle_trace_thread("partition " + std::to_string(index));
+
+        std::size_t round = 0;
+
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_start.wait(lock, [this, round]() {
+                    return not m_running or m_round != round;
+                });
+
+                if (not m_running)
+                    return;
+
+                round = m_round;
+            }
+
+            m_job(index);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_remaining == 0)
+                    m_done.notify_one();
+            }
+        }
+    }
+
+public:
+    PartitionWorkers(std::size_t partitions)
+      : m_round(0)
+      , m_remaining(0)
+      , m_running(true)
+    {
+        m_workers.reserve(partitions - 1);
+        for (std::size_t i = 1; i < partitions; ++i)
+            m_workers.emplace_back(&PartitionWorkers::run, this, i);
+    }
+
+    ~PartitionWorkers() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_running = false;
+        }
+
+        m_start.notify_all();
+
+        for (auto& thread : m_workers)
+            if (thread.joinable())
+                thread.join();
+    }
+
+    PartitionWorkers(const PartitionWorkers&) = delete;
+    PartitionWorkers& operator=(const PartitionWorkers&) = delete;
+
+    /**
+     * Call \e job for each partition index and wait the end of all jobs.
+     * The \e job must not throw.
+     */
+    void for_each(std::function<void(std::size_t)> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job = std::move(job);
+            m_remaining = m_workers.size();
+            ++m_round;
+        }
+
+        m_start.notify_all();
+        m_job(0);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this]() { return m_remaining == 0; });
+    }
+};
+}
+} // namespace vle devs
+
+#endif
@@ -0,0 +1,191 @@
+/*
+ * This file is part of VLE, a framework for multi-modeling, simulation
+ * and analysis of complex dynamical systems.
+ * http://www.vle-project.org
+ *
+ * Copyright (c) 2003-2017 Gauthier Quesnel <gauthier.quesnel@inra.fr>
+ * Copyright (c) 2003-2017 ULCO http://www.univ-littoral.fr
+ * Copyright (c) 2007-2017 INRA http://www.inra.fr
+ *
+ * See the AUTHORS or Authors.txt file for copyright owners and
+ * contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VLE_DEVS_PROFILE_HPP
+#define VLE_DEVS_PROFILE_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vle/DllDefines.hpp>
+#include <vle/utils/Memory.hpp>
+
+namespace vle {
+namespace devs {
+
+using ProfileClock = std::chrono::steady_clock;
+
+/**
+ * Counters and cumulative times of the functions of an atomic model. Each
+ * Simulator owns its SimulatorProfile and a Simulator is processed by only
+ * one thread at a time (see SimulatorProcessParallel), so the worker
+ * threads accumulate without atomic or lock.
+ */
+struct VLE_LOCAL SimulatorProfile
+{
+    enum Function
+    {
+        OUTPUT,
+        INTERNAL,
+        EXTERNAL,
+        CONFLUENT,
+        TIME_ADVANCE,
+        FUNCTION_COUNT
+    };
+
+    static const char* name(Function function) noexcept
+    {
+        static const char* const names[] = {
+            "output", "internal", "external", "confluent", "time-advance"
+        };
+
+        return names[function];
+    }
+
+    std::array<std::uint64_t, FUNCTION_COUNT> count{};
+    std::array<ProfileClock::duration, FUNCTION_COUNT> time{};
+    std::array<std::uint64_t, FUNCTION_COUNT> allocations{};
+    std::array<std::uint64_t, FUNCTION_COUNT> bytes{};
+    std::uint64_t external_events = 0; ///< Number of events received.
+    std::uint64_t output_events = 0;   ///< Number of events sent.
+};
+
+/**
+ * Counters of the Coordinator: bags, scheduler operations, dispatch of the
+ * external events and time spent in each phase of Coordinator::run. Only
+ * the thread of the Coordinator updates it.
+ */
+struct VLE_LOCAL KernelProfile
+{
+    enum Phase
+    {
+        OUTPUT,
+        DISPATCH,
+        TRANSITION,
+        SCHEDULE,
+        OBSERVATION,
+        DELETION,
+        PHASE_COUNT
+    };
+
+    static const char* name(Phase phase) noexcept
+    {
+        static const char* const names[] = { "output",   "dispatch",
+                                             "transition", "schedule",
+                                             "observation", "deletion" };
+
+        return names[phase];
+    }
+
+    /**
+     * Store the size of a bag in the histogram: bucket i counts the bags
+     * with [2^i, 2^(i+1)[ simulators.
+     */
+    void addBag(std::uint64_t dynamics, std::uint64_t executives) noexcept
+    {
+        auto size = dynamics + executives;
+        std::size_t bucket = 0;
+
+        while ((size >> (bucket + 1)) and bucket + 1 < bag_histogram.size())
+            ++bucket;
+
+        ++bags;
+        bag_dynamics += dynamics;
+        bag_executives += executives;
+        bag_max = std::max(bag_max, size);
+        ++bag_histogram[bucket];
+    }
+
+    std::uint64_t bags = 0;
+    std::uint64_t bag_dynamics = 0;
+    std::uint64_t bag_executives = 0;
+    std::uint64_t bag_max = 0;
+    std::array<std::uint64_t, 32> bag_histogram{};
+
+    std::uint64_t scheduler_internal = 0; ///< Internal events scheduled.
+    std::uint64_t scheduler_external = 0; ///< External events scheduled.
+    std::uint64_t scheduler_delete = 0;   ///< Simulators removed.
+
+    std::uint64_t dispatch_events = 0;   ///< Output events dispatched.
+    std::uint64_t dispatch_messages = 0; ///< Events received by targets.
+    std::uint64_t dispatch_fanout_max = 0;
+
+    std::array<ProfileClock::duration, PHASE_COUNT> time{};
+    std::array<std::uint64_t, PHASE_COUNT> allocations{};
+    std::array<std::uint64_t, PHASE_COUNT> bytes{};
+};
+
+/**
+ * Add the time elapsed between its construction and its destruction into
+ * the @e time array of the profile and, if the utils::Memory accounting is
+ * enabled, the allocations and bytes of the calling thread into the
+ * @e allocations and @e bytes arrays. Does nothing if the profile is null.
+ */
+template <typename Profile, typename Index>
+class VLE_LOCAL ProfileTimer
+{
+public:
+    ProfileTimer(Profile* profile, Index index) noexcept
+      : m_profile(profile)
+      , m_index(index)
+    {
+        if (m_profile) {
+            m_memory = utils::Memory::thread();
+            m_start = ProfileClock::now();
+        }
+    }
+
+    ~ProfileTimer() noexcept
+    {
+        if (m_profile) {
+            m_profile->time[m_index] += ProfileClock::now() - m_start;
+
+            auto memory = utils::Memory::thread();
+            m_profile->allocations[m_index] +=
+              memory.allocations - m_memory.allocations;
+            m_profile->bytes[m_index] += memory.bytes - m_memory.bytes;
+        }
+    }
+
+    ProfileTimer(const ProfileTimer&) = delete;
+    ProfileTimer& operator=(const ProfileTimer&) = delete;
+
+private:
+    Profile* m_profile;
+    Index m_index;
+    ProfileClock::time_point m_start;
+    utils::MemoryCounter m_memory;
+};
+
+using SimulatorProfileTimer =
+  ProfileTimer<SimulatorProfile, SimulatorProfile::Function>;
+
+using KernelProfileTimer = ProfileTimer<KernelProfile, KernelProfile::Phase>;
+}
+} // namespace vle devs
+
+#endif
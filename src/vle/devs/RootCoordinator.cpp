@@ -24,8 +24,17 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <vle/devs/RootCoordinator.hpp>
+#include <vle/utils/Exception.hpp>
+#include <vle/utils/Memory.hpp>
+#include <vle/utils/Trace.hpp>
+#include <vle/utils/i18n.hpp>
+#include <vle/value/Map.hpp>
+#include <vle/value/Null.hpp>
+#include <vle/value/Set.hpp>
+#include <vle/value/String.hpp>
 
 namespace vle {
 namespace devs {
@@ -38,6 +47,8 @@ RootCoordinator::RootCoordinator(utils::ContextPtr context)
   , m_end(1.0)
   , m_coordinator(nullptr)
   , m_root(nullptr)
+  , m_profile(false)
+  , m_checkpoint(false)
 {
 }
 
@@ -46,18 +57,140 @@ RootCoordinator::~RootCoordinator() = default;
 void
 RootCoordinator::load(vpz::Vpz& io)
 {
-    m_begin = io.project().experiment().begin();
+    vle_trace_scope("kernel", "load");
+
+    m_begin = TimeBase(io.project().experiment().tick())
+                .round(io.project().experiment().begin());
     m_end = m_begin + io.project().experiment().duration();
     m_currentTime = m_begin;
+    m_rand.seed(io.project().experiment().seed(),
+                0,
+                io.project().experiment().replicate());
 
     m_coordinator = std::make_unique<Coordinator>(m_context,
                                                   io.project().dynamics(),
                                                   io.project().classes(),
                                                   io.project().experiment());
 
+    if (m_channel)
+        m_coordinator->setDistributed(m_channel);
+
+    if (m_profile) {
+        utils::Memory::enable();
+        m_coordinator->enableProfile();
+    }
+
     m_coordinator->init(io.project().model(), m_currentTime, m_end);
 
     m_root = io.project().model().graph();
+
+    if (m_checkpoint)
+        m_vpz = std::make_unique<vpz::Vpz>(io);
+}
+
+std::unique_ptr<value::Map>
+RootCoordinator::checkpoint()
+{
+    vle_trace_scope("kernel", "checkpoint");
+
+    if (not m_vpz or not m_coordinator)
+        throw utils::InternalError(
+          _("RootCoordinator: checkpoints are not enabled"));
+
+    auto kernel = m_coordinator->checkpoint();
+
+    auto result = std::make_unique<value::Map>();
+    result->addInt("version", 1);
+    result->addDouble("begin", m_begin);
+    result->addDouble("end", m_end);
+    result->addString("rand", m_rand.state());
+
+    //
+    // The executives update the structure, the dynamics and the
+    // experiment of the Coordinator. The structure is lent to m_vpz to be
+    // written.
+    //
+    m_vpz->project().dynamics() = m_coordinator->dynamics();
+    m_vpz->project().experiment() = m_coordinator->experiment();
+    m_vpz->project().model().setGraph(std::move(m_root));
+
+    std::string xml;
+    try {
+        xml = m_vpz->writeToString();
+    } catch (...) {
+        m_root = m_vpz->project().model().graph();
+        throw;
+    }
+    m_root = m_vpz->project().model().graph();
+    result->addString("vpz", xml);
+
+    auto& conditions = result->addMap("conditions");
+    for (const auto& elem : m_coordinator->conditions().conditionlist()) {
+        auto& condition = conditions.addMap(elem.first);
+        for (const auto& port : elem.second.conditionvalues()) {
+            auto& values = condition.addSet(port.first);
+            for (const auto& value : port.second)
+                values.add(value ? value->clone() : value::Null::create());
+        }
+    }
+
+    result->add("kernel", std::move(kernel));
+
+    return result;
+}
+
+void
+RootCoordinator::restore(const value::Map& checkpoint)
+{
+    vle_trace_scope("kernel", "restore");
+
+    if (not checkpoint.exist("version") or checkpoint.getInt("version") != 1)
+        throw utils::ArgError(_("RootCoordinator: unknown checkpoint"));
+
+    vpz::Vpz io;
+    io.parseMemory(checkpoint.getString("vpz"));
+
+    for (const auto& elem : checkpoint.getMap("conditions")) {
+        auto& condition = io.project().experiment().conditions().get(
+          elem.first);
+
+        for (const auto& port : elem.second->toMap()) {
+            auto& values = condition.getSetValues(port.first);
+            values.clear();
+            for (const auto& value : port.second->toSet())
+                values.emplace_back(value->clone());
+        }
+    }
+
+    m_begin = checkpoint.getDouble("begin");
+    m_end = checkpoint.getDouble("end");
+    m_rand.setState(checkpoint.getString("rand"));
+
+    m_coordinator = std::make_unique<Coordinator>(m_context,
+                                                  io.project().dynamics(),
+                                                  io.project().classes(),
+                                                  io.project().experiment());
+
+    if (m_profile) {
+        utils::Memory::enable();
+        m_coordinator->enableProfile();
+    }
+
+    m_coordinator->restore(
+      io.project().model(), checkpoint.getMap("kernel"), m_end);
+    m_currentTime = m_coordinator->getCurrentTime();
+
+    m_root = io.project().model().graph();
+
+    if (m_checkpoint)
+        m_vpz = std::make_unique<vpz::Vpz>(io);
+}
+
+void
+RootCoordinator::updateConditions(const vpz::Conditions& conditions,
+                                  const std::set<std::string>& names)
+{
+    m_coordinator->updateConditions(conditions, names);
 }
 
 void
@@ -82,6 +215,15 @@ RootCoordinator::run()
     return true;
 }
 
+bool
+RootCoordinator::run_until(Time date)
+{
+    m_coordinator->run_until(std::min(date, m_end));
+    m_currentTime = m_coordinator->getCurrentTime();
+
+    return not isInfinity(m_currentTime) and m_currentTime <= m_end;
+}
+
 std::unique_ptr<value::Map>
 RootCoordinator::finish()
 {
@@ -99,5 +241,14 @@ RootCoordinator::outputs() const
     }
     return {};
 }
+
+std::unique_ptr<value::Map>
+RootCoordinator::profile() const
+{
+    if (m_coordinator) {
+        return m_coordinator->profile();
+    }
+    return {};
+}
 }
 } // namespace vle devs
@@ -28,6 +28,7 @@
 #define DEVS_ROOTCOORDINATOR_HPP
 
 #include <memory>
+#include <set>
 #include <vle/DllDefines.hpp>
 #include <vle/devs/Coordinator.hpp>
 #include <vle/devs/Time.hpp>
@@ -77,6 +78,78 @@ public:
      */
     void load(vpz::Vpz& vp);
 
+    /**
+     * @brief Enable or disable the profiler of the Coordinator built by
+     * the next call to load(). Disabled by default. The profiler enables
+     * the utils::Memory accounting of the process.
+     * @param profile true to record the counters, the times and the
+     * allocations of the kernel and of the atomic models.
+     */
+    void setProfile(bool profile)
+    {
+        m_profile = profile;
+    }
+
+    /**
+     * @brief Enable or disable the checkpoints of the simulation built by
+     * the next call to load(). Disabled by default. When enabled, load()
+     * keeps a copy of the vpz::Vpz without its structure.
+     * @param checkpoint true to enable the checkpoint() function.
+     */
+    void setCheckpoint(bool checkpoint)
+    {
+        m_checkpoint = checkpoint;
+    }
+
+    /**
+     * @brief Distribute the simulation built by the next call to load() over
+     * the processes of @e channel (see Coordinator::setDistributed()).
+     * All the processes load the same vpz::Vpz and call run() and
+     * finish() together, only the process 0 returns the outputs.
+     * @param channel the processes or nullptr to simulate all the model.
+     */
+    void setDistributed(std::shared_ptr<DistributedChannel> channel)
+    {
+        m_channel = std::move(channel);
+    }
+
+    /**
+     * @brief Build a checkpoint of the simulation between two calls to
+     * run(). The \c value::Map stores:
+     * - "version": the version of the format (1).
+     * - "begin", "end": the dates of the simulation.
+     * - "rand": the state of the random generator.
+     * - "vpz": the vpz::Vpz written with the structure, the dynamics and
+     *   the experiment modified by the executives.
+     * - "conditions": the values of the conditions, the XML of the "vpz"
+     *   does not store the exact doubles.
+     * - "kernel": the state of the Coordinator (see
+     *   Coordinator::checkpoint()).
+     *
+     * @throw utils::InternalError if setCheckpoint() was not called before
+     * load().
+     * @throw utils::NotYetImplemented if an atomic model does not
+     * implement Dynamics::checkpoint().
+     */
+    std::unique_ptr<value::Map> checkpoint();
+
+    /**
+     * @brief Replace load() and init(): build a new Coordinator with the
+     * vpz::Vpz stored in the checkpoint and restore the state of the
+     * simulation. The next call to run() processes the bag of the
+     * checkpoint.
+     * @param checkpoint the value built by checkpoint().
+     * @throw utils::ArgError if the version of the checkpoint is unknown.
+     */
+    void restore(const value::Map& checkpoint);
+
+    /**
+     * @brief Replace the conditions @e names of the simulation between two
+     * calls to run(). See Coordinator::updateConditions().
+     */
+    void updateConditions(const vpz::Conditions& conditions,
+                          const std::set<std::string>& names);
+
     /**
      * @brief Initialise RootCoordinator and his Coordinator: initiale time
      * is define, coordinator init function is call.
@@ -90,6 +163,14 @@ public:
      */
     bool run();
 
+    /**
+     * @brief Run all the bags scheduled before or at @e date (and before
+     * the end of the simulation) without returning to the caller between
+     * two bags.
+     * @return false when simulation is finished, true otherwise.
+     */
+    bool run_until(Time date);
+
     /**
      * @brief Call the coordinator finish function and delete the
      * coordinator and all attached data.
@@ -105,6 +186,16 @@ public:
         return m_currentTime;
     }
 
+    /**
+     * @brief Return the date of the bag processed by the next call to
+     * run().
+     * @return A date or infinity if no event remains.
+     */
+    Time getNextTime() const
+    {
+        return m_coordinator->getCurrentTime();
+    }
+
     /**
      * Return the simulation results.
      *
@@ -116,6 +207,13 @@ public:
      */
     std::unique_ptr<value::Map> outputs() const;
 
+    /**
+     * Return the report of the profiler (see Coordinator::profile()).
+     *
+     * @return nullptr if the profiler is not enabled.
+     */
+    std::unique_ptr<value::Map> profile() const;
+
     /**
      * @brief Return a reference to the random generator.
      * @return Return a reference to the random generator.
@@ -143,6 +241,14 @@ private:
 
     std::unique_ptr<Coordinator> m_coordinator;
     std::unique_ptr<vpz::BaseModel> m_root;
+
+    /** @brief The vpz::Vpz without structure to write checkpoints. */
+    std::unique_ptr<vpz::Vpz> m_vpz;
+
+    std::shared_ptr<DistributedChannel> m_channel;
+
+    bool m_profile;
+    bool m_checkpoint;
 };
 }
 } // namespace vle devs
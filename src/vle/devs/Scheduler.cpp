@@ -37,13 +37,14 @@ void
 Scheduler::init(Time time)
 {
     m_current_time = time;
+    m_current_key = m_timebase.toKey(time);
 
     m_current_bag.dynamics.clear();
     m_current_bag.executives.clear();
     m_current_bag.unique_simulators.clear();
 
     while (not m_scheduler.empty() and
-           m_scheduler.top().m_time <= m_current_time) {
+           m_scheduler.top().m_key <= m_current_key) {
 
         Simulator* sim = m_scheduler.top().m_simulator;
 
@@ -70,16 +71,29 @@ Scheduler::init(Time time)
 
 void
 Scheduler::addInternal(Simulator* simulator, Time time)
+{
+    addInternal(simulator, time, m_current_key);
+}
+
+void
+Scheduler::addInternal(Simulator* simulator, Time time, std::int64_t inserted)
 {
     assert(not isInfinity(time) && "addInternal: infinity time?");
     assert(not isNegativeInfinity(time) && "addInternal: infinity time?");
-    assert(time >= m_current_time && "addInternal: time < m_current_time?");
+
+    auto key = m_timebase.toKey(time);
+    assert(key >= m_current_key && "addInternal: time < m_current_time?");
+
+    simulator->setInserted(inserted);
 
     if (simulator->haveHandle()) {
-        (*simulator->handle()).m_time = time;
+        (*simulator->handle()).m_key = key;
+        (*simulator->handle()).m_inserted = inserted;
+        (*simulator->handle()).m_index = simulator->index();
         m_scheduler.update(simulator->handle());
     } else {
-        HandleT handle = m_scheduler.emplace(time, simulator);
+        HandleT handle =
+          m_scheduler.emplace(key, inserted, simulator->index(), simulator);
         simulator->setHandle(handle);
     }
 }
@@ -87,7 +101,7 @@ Scheduler::addInternal(Simulator* simulator, Time time)
 void
 Scheduler::addExternal(Simulator* simulator,
                        std::shared_ptr<value::Value> values,
-                       const std::string& portname)
+                       const utils::Symbol& portname)
 {
     //
     // Tries to insert the simulator into the std::unordered_set. If insertion
@@ -110,7 +124,8 @@ Scheduler::addExternal(Simulator* simulator,
     // bag, we erase this event.
     //
 
-    if (simulator->haveHandle() and simulator->getTn() > m_current_time) {
+    if (simulator->haveHandle() and
+        (*simulator->handle()).m_key > m_current_key) {
         m_scheduler.erase(simulator->handle());
         simulator->resetHandle();
         assert(not simulator->haveInternalEvent() && "Bad scheduler");
@@ -149,14 +164,22 @@ Scheduler::delSimulator(Simulator* simulator)
 void
 Scheduler::makeNextBag()
 {
-    m_current_time = getNextTime();
+    //
+    // The simulators of the bag have the same key: with an integer time
+    // base, the dates are compared without rounding errors.
+    //
+
+    m_current_key = m_scheduler.empty()
+                      ? m_timebase.toKey(infinity)
+                      : m_scheduler.top().m_key;
+    m_current_time = m_timebase.toTime(m_current_key);
 
     m_current_bag.dynamics.clear();
     m_current_bag.executives.clear();
     m_current_bag.unique_simulators.clear();
 
     while (not m_scheduler.empty() and
-           m_scheduler.top().m_time == m_current_time) {
+           m_scheduler.top().m_key == m_current_key) {
 
         Simulator* sim = m_scheduler.top().m_simulator;
 
@@ -27,7 +27,9 @@
 #ifndef VLE_DEVS_SCHEDULER_HPP
 #define VLE_DEVS_SCHEDULER_HPP
 
+#include <algorithm>
 #include <boost/heap/fibonacci_heap.hpp>
+#include <cstdint>
 #include <map>
 #include <unordered_set>
 #include <vector>
@@ -93,25 +95,50 @@ push(SchedulerT& scheduler, Args&&... args)
       scheduler.begin(), scheduler.end(), EventCompare<event_type>);
 }
 
+/**
+ * Order the elements of the heap by key then by insertion sequence: the
+ * date of the bag which pushed the simulator, then the index of the
+ * simulator. The sequence does not depend on the order of the calls to
+ * addInternal() in a bag, so the partitions of a parallel simulation
+ * order their bags like the sequential simulation.
+ */
 struct HeapElementCompare
 {
     template <typename HeapElementT>
     bool operator()(const HeapElementT& lhs, const HeapElementT& rhs) const
       noexcept
     {
-        return lhs.m_time >= rhs.m_time;
+        if (lhs.m_key != rhs.m_key)
+            return lhs.m_key > rhs.m_key;
+
+        if (lhs.m_inserted != rhs.m_inserted)
+            return lhs.m_inserted > rhs.m_inserted;
+
+        return lhs.m_index > rhs.m_index;
     }
 };
 
+/**
+ * An element of the \e Scheduler heap: the \e Simulator, the key of its
+ * next date in the \e TimeBase of the experiment and its insertion
+ * sequence (the key of the bag which pushed it and its index).
+ */
 struct HeapElement
 {
-    HeapElement(Time time, Simulator* Simulator)
-      : m_time(time)
+    HeapElement(std::int64_t key,
+                std::int64_t inserted,
+                std::uint64_t index,
+                Simulator* Simulator)
+      : m_key(key)
+      , m_inserted(inserted)
+      , m_index(index)
       , m_simulator(Simulator)
     {
     }
 
-    Time m_time;
+    std::int64_t m_key;
+    std::int64_t m_inserted;
+    std::uint64_t m_index;
     Simulator* m_simulator;
 };
 
@@ -142,6 +169,7 @@ class VLE_LOCAL Scheduler
 public:
     Scheduler()
       : m_current_time(negativeInfinity)
+      , m_current_key(m_timebase.toKey(negativeInfinity))
     {
     }
 
@@ -152,12 +180,35 @@ public:
     Scheduler(Scheduler&&) = delete;
     Scheduler& operator=(Scheduler&&) = delete;
 
+    /**
+     * Use the integer time base @e timebase for the dates of the
+     * simulators. To call before the first addInternal().
+     */
+    void setTimeBase(const TimeBase& timebase) noexcept
+    {
+        m_timebase = timebase;
+        m_current_key = m_timebase.toKey(m_current_time);
+    }
+
     void init(Time time);
 
+    /**
+     * Push or move the @e simulator to the date @e time. The simulator
+     * gets the key of the current bag as insertion sequence: it leaves
+     * the heap after the simulators pushed at the same date by a previous
+     * bag.
+     */
     void addInternal(Simulator* simulator, Time time);
+
+    /**
+     * Push or move the @e simulator to the date @e time with the key @e
+     * inserted of the bag which pushed it: used to move a simulator from
+     * another scheduler or from a checkpoint.
+     */
+    void addInternal(Simulator* simulator, Time time, std::int64_t inserted);
     void addExternal(Simulator* simulator,
                      std::shared_ptr<value::Value> values,
-                     const std::string& portname);
+                     const utils::Symbol& portname);
     void delSimulator(Simulator* simulator);
 
     Bag& getCurrentBag() noexcept
@@ -173,39 +224,96 @@ public:
     Time getNextTime() const noexcept
     {
         if (not m_scheduler.empty())
-            return m_scheduler.top().m_time;
+            return m_timebase.toTime(m_scheduler.top().m_key);
 
         return infinity;
     }
 
     void makeNextBag();
 
+    /**
+     * Go back to the date @e time after a rollback of the optimistic
+     * simulation. The current bag is cleared, the Simulators of the undone
+     * bags are pushed again with addInternal().
+     */
+    void rollback(Time time) noexcept
+    {
+        m_current_time = time;
+        m_current_key = m_timebase.toKey(time);
+
+        m_current_bag.dynamics.clear();
+        m_current_bag.executives.clear();
+        m_current_bag.unique_simulators.clear();
+    }
+
 private:
     Bag m_current_bag;
     Heap m_scheduler;
+    TimeBase m_timebase;
     Time m_current_time;
+    std::int64_t m_current_key;
 };
 
+/**
+ * The calendar of the timed views. The views are grouped in buckets by
+ * timestep and date of their next observation: the observations of a date
+ * run the views of the buckets without allocation and the buckets move to
+ * their next date without reordering.
+ */
 class VLE_LOCAL TimedObservationScheduler
 {
     std::vector<ViewEvent> m_observation;
+    TimeBase m_timebase;
+    Time m_next = infinity;
 
 public:
+    /**
+     * Use the integer time base @e timebase for the dates of the
+     * observations.
+     */
+    void setTimeBase(const TimeBase& timebase) noexcept
+    {
+        m_timebase = timebase;
+    }
+
     void add(View* ptr, Time time, Time timestep)
     {
         assert(not isInfinity(time) && "addObservation: infinity time");
         assert(not isNegativeInfinity(time) &&
                "addObservation: negative infinity time");
 
-        push(m_observation, ptr, time, timestep);
+        //
+        // With an integer time base, the dates and the timestep are
+        // multiples of the tick: the observations do not drift when the
+        // timestep is accumulated.
+        //
+        if (m_timebase.tick() > 0.0) {
+            time = m_timebase.round(time);
+            timestep = std::max(m_timebase.tick(), m_timebase.round(timestep));
+        }
+
+        auto it = std::find_if(
+          m_observation.begin(),
+          m_observation.end(),
+          [time, timestep](const ViewEvent& elem) {
+              return elem.mTime == time and elem.mTimestep == timestep;
+          });
+
+        if (it == m_observation.end())
+            it = m_observation.emplace(m_observation.end(), time, timestep);
+
+        it->mViews.emplace_back(ptr);
+        m_next = std::min(m_next, time);
     }
 
-    bool haveObservationAtTime(Time time) noexcept
+    Time getNextTime() const noexcept
     {
-        if (m_observation.empty())
-            return false;
+        return m_next;
+    }
 
-        return m_observation[0].mTime < time;
+    bool haveObservationAtTime(Time time) const noexcept
+    {
+        return m_next < time;
     }
 
     void finalize(Time time)
@@ -213,19 +321,53 @@ public:
         for (auto& elem : m_observation)
             elem.run(time);
 
+        clear();
+    }
+
+    /**
+     * Access to the pending observations to write a checkpoint.
+     */
+    const std::vector<ViewEvent>& observations() const noexcept
+    {
+        return m_observation;
+    }
+
+    void clear() noexcept
+    {
         m_observation.clear();
+        m_next = infinity;
     }
 
-    std::vector<ViewEvent> getObservationAtTime(Time time)
+    /**
+     * Run the observations of the buckets of the next date and move them
+     * to the date of their next observation.
+     *
+     * @return the date of the observations.
+     */
+    Time run()
     {
-        std::vector<ViewEvent> ret;
+        const Time time = m_next;
+        m_next = infinity;
+
+        for (std::size_t i = 0; i < m_observation.size();) {
+            auto& elem = m_observation[i];
+
+            if (elem.mTime == time) {
+                elem.run();
+                elem.mTime = m_timebase.round(elem.mTime + elem.mTimestep);
+
+                if (isInfinity(elem.mTime)) {
+                    std::swap(elem, m_observation.back());
+                    m_observation.pop_back();
+                    continue;
+                }
+            }
 
-        while (not m_observation.empty() and m_observation[0].mTime < time) {
-            ret.push_back(std::move(m_observation[0]));
-            pop(m_observation);
+            m_next = std::min(m_next, elem.mTime);
+            ++i;
         }
 
-        return ret;
+        return time;
     }
 };
 }
@@ -24,6 +24,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <limits>
 #include <vle/devs/Dynamics.hpp>
 #include <vle/devs/Simulator.hpp>
 #include <vle/devs/Time.hpp>
@@ -37,6 +38,8 @@ namespace devs {
 Simulator::Simulator(vpz::AtomicModel* atomic)
   : m_atomicModel(atomic)
   , m_tn(negativeInfinity)
+  , m_index(0)
+  , m_inserted(std::numeric_limits<std::int64_t>::min())
   , m_have_handle(false)
   , m_have_internal(false)
 {
@@ -46,17 +49,17 @@ Simulator::Simulator(vpz::AtomicModel* atomic)
 }
 
 void
-Simulator::updateSimulatorTargets(const std::string& port)
+Simulator::updateSimulatorTargets(const utils::Symbol& port)
 {
     assert(m_atomicModel);
 
     mTargets.erase(port);
 
     vpz::ModelPortList result;
-    m_atomicModel->getAtomicModelsTarget(port, result);
+    m_atomicModel->getAtomicModelsTarget(port.str(), result);
 
     if (result.begin() == result.end()) {
-        mTargets.emplace(port, TargetSimulator(nullptr, std::string()));
+        mTargets.emplace(port, TargetSimulator(nullptr, utils::Symbol()));
         return;
     }
 
@@ -69,7 +72,7 @@ Simulator::updateSimulatorTargets(const std::string& port)
 }
 
 std::pair<Simulator::iterator, Simulator::iterator>
-Simulator::targets(const std::string& port)
+Simulator::targets(const utils::Symbol& port)
 {
     auto x = mTargets.equal_range(port);
 
@@ -103,7 +106,7 @@ Simulator::addTargetPort(const std::string& port)
     assert(mTargets.find(port) == mTargets.end());
 
     mTargets.insert(
-      value_type(port, TargetSimulator((Simulator*)nullptr, std::string())));
+      value_type(port, TargetSimulator((Simulator*)nullptr, utils::Symbol())));
 }
 
 void
@@ -132,13 +135,32 @@ Simulator::output(Time time)
 {
     assert(m_result.empty());
 
-    m_dynamics->output(time, m_result);
+    if (m_profile) {
+        SimulatorProfileTimer timer(m_profile.get(),
+                                    SimulatorProfile::OUTPUT);
+
+        ++m_profile->count[SimulatorProfile::OUTPUT];
+        m_dynamics->output(time, m_result);
+        m_profile->output_events += m_result.size();
+    } else {
+        m_dynamics->output(time, m_result);
+    }
 }
 
 Time
 Simulator::timeAdvance()
 {
-    Time tn = m_dynamics->timeAdvance();
+    Time tn;
+
+    if (m_profile) {
+        SimulatorProfileTimer timer(m_profile.get(),
+                                    SimulatorProfile::TIME_ADVANCE);
+
+        ++m_profile->count[SimulatorProfile::TIME_ADVANCE];
+        tn = m_dynamics->timeAdvance();
+    } else {
+        tn = m_dynamics->timeAdvance();
+    }
 
     if (tn < 0.0)
         throw utils::ModellingError(
@@ -158,7 +180,7 @@ Simulator::init(Time time)
           (fmt(_("Negative init function in '%1%' (%2%)")) % getName() % tn)
             .str());
 
-    m_tn = tn + time;
+    m_tn = m_timebase.next(time, tn);
     return m_tn;
 }
 
@@ -167,24 +189,55 @@ Simulator::confluentTransitions(Time time)
 {
     assert(not m_external_events.empty() and "Simulator d-conf error");
     assert(m_have_internal == true and "Simulator d-conf error");
-    m_dynamics->confluentTransitions(time, m_external_events);
+
+    if (m_profile) {
+        SimulatorProfileTimer timer(m_profile.get(),
+                                    SimulatorProfile::CONFLUENT);
+
+        ++m_profile->count[SimulatorProfile::CONFLUENT];
+        m_profile->external_events += m_external_events.size();
+        m_dynamics->confluentTransitions(time, m_external_events);
+    } else {
+        m_dynamics->confluentTransitions(time, m_external_events);
+    }
 
     m_external_events.clear();
     m_have_internal = false;
 
-    m_tn = timeAdvance() + time;
+    m_tn = m_timebase.next(time, timeAdvance());
     return m_tn;
 }
 
+Time
+Simulator::transition(Time time)
+{
+    if (not m_have_internal)
+        return externalTransition(time);
+
+    if (m_external_events.empty())
+        return internalTransition(time);
+
+    return confluentTransitions(time);
+}
+
 Time
 Simulator::internalTransition(Time time)
 {
     assert(m_have_internal == true and "Simulator d-int error");
-    m_dynamics->internalTransition(time);
+
+    if (m_profile) {
+        SimulatorProfileTimer timer(m_profile.get(),
+                                    SimulatorProfile::INTERNAL);
+
+        ++m_profile->count[SimulatorProfile::INTERNAL];
+        m_dynamics->internalTransition(time);
+    } else {
+        m_dynamics->internalTransition(time);
+    }
 
     m_have_internal = false;
 
-    m_tn = timeAdvance() + time;
+    m_tn = m_timebase.next(time, timeAdvance());
     return m_tn;
 }
 
@@ -192,11 +245,21 @@ Time
 Simulator::externalTransition(Time time)
 {
     assert(not m_external_events.empty() and "Simulator d-ext error");
-    m_dynamics->externalTransition(m_external_events, time);
+
+    if (m_profile) {
+        SimulatorProfileTimer timer(m_profile.get(),
+                                    SimulatorProfile::EXTERNAL);
+
+        ++m_profile->count[SimulatorProfile::EXTERNAL];
+        m_profile->external_events += m_external_events.size();
+        m_dynamics->externalTransition(m_external_events, time);
+    } else {
+        m_dynamics->externalTransition(m_external_events, time);
+    }
 
     m_external_events.clear();
 
-    m_tn = timeAdvance() + time;
+    m_tn = m_timebase.next(time, timeAdvance());
     return m_tn;
 }
 
@@ -205,5 +268,20 @@ Simulator::observation(const ObservationEvent& event) const
 {
     return m_dynamics->observation(event);
 }
+
+Time
+Simulator::restore(const value::Value& state, Time time, Time tn)
+{
+    m_dynamics->restore(state, time);
+
+    m_tn = tn;
+    return m_tn;
+}
+
+std::unique_ptr<value::Value>
+Simulator::checkpoint() const
+{
+    return m_dynamics->checkpoint();
+}
 }
 } // namespace vle devs
@@ -32,6 +32,7 @@
 #include <vle/devs/ExternalEventList.hpp>
 #include <vle/devs/InternalEvent.hpp>
 #include <vle/devs/ObservationEvent.hpp>
+#include <vle/devs/Profile.hpp>
 #include <vle/devs/Scheduler.hpp>
 #include <vle/devs/Time.hpp>
 #include <vle/devs/View.hpp>
@@ -48,10 +49,11 @@ class Dynamics;
  *
  */
 class VLE_LOCAL Simulator
+  : public utils::MemoryTagged<utils::MemoryTag::model>
 {
 public:
-    typedef std::pair<Simulator*, std::string> TargetSimulator;
-    typedef std::multimap<std::string, TargetSimulator> TargetSimulatorList;
+    typedef std::pair<Simulator*, utils::Symbol> TargetSimulator;
+    typedef std::multimap<utils::Symbol, TargetSimulator> TargetSimulatorList;
     typedef TargetSimulatorList::const_iterator const_iterator;
     typedef TargetSimulatorList::iterator iterator;
     typedef TargetSimulatorList::size_type size_type;
@@ -110,7 +112,7 @@ public:
      *
      * \param port The output port used to build simulators' target list.
      */
-    void updateSimulatorTargets(const std::string& port);
+    void updateSimulatorTargets(const utils::Symbol& port);
 
     /**
      * Get begin and end iterators to find Simulator connected to the
@@ -120,7 +122,7 @@ public:
      *
      * \return Two iterators.
      */
-    std::pair<iterator, iterator> targets(const std::string& port);
+    std::pair<iterator, iterator> targets(const utils::Symbol& port);
 
     /**
      * @brief Add an empty target port.
@@ -143,9 +145,30 @@ public:
     Time internalTransition(Time time);
     Time externalTransition(Time time);
     Time confluentTransitions(Time time);
+
+    /**
+     * @brief Compute the transition of the current bag: the internal
+     * transition without external event, the confluent transitions with
+     * external events or the external transition without internal event.
+     * @return The date of the next internal event.
+     */
+    Time transition(Time time);
     std::unique_ptr<value::Value> observation(
       const ObservationEvent& event) const;
 
+    /**
+     * Restart the model from a checkpoint instead of calling init().
+     *
+     * \param state The value returned by \e checkpoint().
+     * \param time The date of the checkpoint.
+     * \param tn The date of the next internal event of the model.
+     *
+     * \return \e tn.
+     */
+    Time restore(const value::Value& state, Time time, Time tn);
+
+    std::unique_ptr<value::Value> checkpoint() const;
+
     inline const ExternalEventList& result() const noexcept
     {
         return m_result;
@@ -183,13 +206,42 @@ public:
         m_have_handle = false;
     }
 
+    /**
+     * The number of the simulator in the order of creation: the
+     * simulators pushed in the scheduler by a same bag are ordered by
+     * index.
+     */
+    inline std::uint64_t index() const noexcept
+    {
+        return m_index;
+    }
+
+    inline void setIndex(std::uint64_t index) noexcept
+    {
+        m_index = index;
+    }
+
+    /**
+     * The key of the date of the bag which pushed the simulator in the
+     * scheduler for the last time (see Scheduler::addInternal).
+     */
+    inline std::int64_t inserted() const noexcept
+    {
+        return m_inserted;
+    }
+
+    inline void setInserted(std::int64_t inserted) noexcept
+    {
+        m_inserted = inserted;
+    }
+
     inline bool haveExternalEvents() const noexcept
     {
         return not m_external_events.empty();
     }
 
     inline void addExternalEvents(std::shared_ptr<value::Value> values,
-                                  const std::string& portname)
+                                  const utils::Symbol& portname)
     {
         m_external_events.emplace_back(values, portname);
     }
@@ -214,6 +266,34 @@ public:
         return m_observations;
     }
 
+    /**
+     * Round the next dates of the simulator with the integer time base
+     * @e timebase of the experiment.
+     */
+    void setTimeBase(const TimeBase& timebase) noexcept
+    {
+        m_timebase = timebase;
+    }
+
+    /**
+     * Start to record the number of calls and the time spent in the
+     * functions of the dynamics.
+     */
+    void enableProfile()
+    {
+        if (not m_profile)
+            m_profile = std::make_unique<SimulatorProfile>();
+    }
+
+    /**
+     * Get the profile of the simulator or nullptr if the profiler is not
+     * enabled.
+     */
+    const SimulatorProfile* profile() const noexcept
+    {
+        return m_profile.get();
+    }
+
 private:
     std::unique_ptr<Dynamics> m_dynamics;
     vpz::AtomicModel* m_atomicModel;
@@ -221,9 +301,13 @@ private:
     ExternalEventList m_external_events;
     ExternalEventList m_result;
     std::vector<Observation> m_observations;
+    std::unique_ptr<SimulatorProfile> m_profile;
     std::string m_parents;
+    TimeBase m_timebase;
     Time m_tn;
     HandleT m_handle;
+    std::uint64_t m_index;
+    std::int64_t m_inserted;
     bool m_have_handle;
     bool m_have_internal;
 };
@@ -33,6 +33,7 @@
 #include <vle/devs/Simulator.hpp>
 #include <vle/utils/Context.hpp>
 #include <vle/utils/ContextPrivate.hpp>
+#include <vle/utils/Trace.hpp>
 #include <vle/utils/i18n.hpp>
 
 namespace vle {
@@ -43,14 +44,7 @@ bool
 simulator_process(SimulatorT* simulator, Time time) noexcept
 {
     try {
-        if (simulator->haveInternalEvent()) {
-            if (not simulator->haveExternalEvents())
-                simulator->internalTransition(time);
-            else
-                simulator->confluentTransitions(time);
-        } else {
-            simulator->externalTransition(time);
-        }
+        simulator->transition(time);
     } catch (...) {
         return false;
     }
@@ -60,29 +54,40 @@ simulator_process(SimulatorT* simulator, Time time) noexcept
 
 class SimulatorProcessParallel
 {
+    using BlockFunction = void (*)(void*, std::size_t, std::size_t);
+
     std::vector<std::thread> m_workers;
     std::atomic<long int> m_block_id;
     std::atomic<long int> m_block_count;
     std::atomic<bool> m_running_flag;
 
-    std::vector<Simulator*>* m_jobs;
-    Time m_time;
+    BlockFunction m_function;
+    void* m_data;
+    std::size_t m_size;
     long m_block_size;
 
+    void process(long block) noexcept
+    {
+        std::size_t begin = block * m_block_size;
+        std::size_t begin_plus_b = begin + m_block_size;
+        std::size_t end = std::min(m_size, begin_plus_b);
+
+        if (begin < end)
+            m_function(m_data, begin, end);
+
+        m_block_count.fetch_sub(1, std::memory_order_release);
+    }
+
     void run()
     {
+        vle_trace_thread("simulation worker");
+
         while (m_running_flag.load(std::memory_order_relaxed)) {
-            auto block = m_block_id.fetch_sub(1, std::memory_order_relaxed);
+            auto block = m_block_id.fetch_sub(1, std::memory_order_acquire);
 
             if (block >= 0) {
-                std::size_t begin = block * m_block_size;
-                std::size_t begin_plus_b = begin + m_block_size;
-                std::size_t end = std::min(m_jobs->size(), begin_plus_b);
-
-                for (; begin < end; ++begin)
-                    simulator_process((*m_jobs)[begin], m_time);
-
-                m_block_count.fetch_sub(1, std::memory_order_relaxed);
+                vle_trace_scope("kernel", "worker block");
+                process(block);
             } else {
                 //
                 // TODO: Maybe we can use a yield instead of this
@@ -96,7 +101,9 @@ class SimulatorProcessParallel
 
 public:
     SimulatorProcessParallel(utils::ContextPtr context)
-      : m_jobs(nullptr)
+      : m_function(nullptr)
+      , m_data(nullptr)
+      , m_size(0)
     {
         long block_size = 8;
         {
@@ -149,37 +156,52 @@ public:
         return not m_workers.empty();
     }
 
-    bool for_each(std::vector<Simulator*>& simulators, Time time) noexcept
+    /**
+     * Call @e function(begin, end) for blocks of indices between 0 and @e
+     * size in the workers and in the calling thread and wait for all the
+     * blocks. @e function must not throw.
+     */
+    template <typename Function>
+    void parallel_for(std::size_t size, Function& function) noexcept
     {
-        m_jobs = &simulators;
-        m_time = time;
+        m_function = [](void* data, std::size_t begin, std::size_t end) {
+            (*static_cast<Function*>(data))(begin, end);
+        };
+        m_data = &function;
+        m_size = size;
 
-        auto sz = (simulators.size() / m_block_size) +
-                  ((simulators.size() % m_block_size) ? 1 : 0);
+        auto sz = (size / m_block_size) + ((size % m_block_size) ? 1 : 0);
 
         m_block_count.store(sz, std::memory_order_relaxed);
-        m_block_id.store(sz, std::memory_order_relaxed);
+        m_block_id.store(sz, std::memory_order_release);
 
         for (;;) {
-            auto block = m_block_id.fetch_sub(1, std::memory_order_relaxed);
+            auto block = m_block_id.fetch_sub(1, std::memory_order_acquire);
 
             if (block < 0)
                 break;
 
-            std::size_t begin = block * m_block_size;
-            std::size_t begin_plus_b = begin + m_block_size;
-            std::size_t end = std::min(m_jobs->size(), begin_plus_b);
-
-            for (; begin < end; ++begin)
-                simulator_process((*m_jobs)[begin], m_time);
-
-            m_block_count.fetch_sub(1, std::memory_order_relaxed);
+            vle_trace_scope("kernel", "block");
+            process(block);
         }
 
-        while (m_block_count.load(std::memory_order_relaxed) >= 0)
+        vle_trace_scope("kernel", "wait workers");
+        while (m_block_count.load(std::memory_order_acquire) >= 0)
             std::this_thread::sleep_for(std::chrono::nanoseconds(1));
 
-        m_jobs = nullptr;
+        m_function = nullptr;
+        m_data = nullptr;
+    }
+
+    bool for_each(std::vector<Simulator*>& simulators, Time time) noexcept
+    {
+        auto function = [&simulators, time](std::size_t begin,
+                                            std::size_t end) {
+            for (; begin < end; ++begin)
+                simulator_process(simulators[begin], time);
+        };
+
+        parallel_for(simulators.size(), function);
 
         return true;
     }
@@ -28,6 +28,8 @@
 #define VLE_DEVS_TIME_HPP
 
 #include <cmath> /* for isnan */
+#include <cstdint>
+#include <cstring>
 #include <limits>
 #include <string>
 #include <vle/DllDefines.hpp>
@@ -109,6 +111,127 @@ isNegativeInfinity(Time time)
     return time == negativeInfinity;
 }
 
+/**
+ * @e TimeBase converts the dates of the schedulers into integer keys.
+ *
+ * With a positive @e tick, the experiment uses an integer time base: the
+ * dates are rounded to the nearest multiple of the tick and the key of a
+ * date is its number of ticks. Logically simultaneous dates (for instance
+ * after accumulated timesteps) are equal and their events are in the same
+ * bag. With a null tick (the default), the dates are not rounded and the
+ * key of a date is its bit pattern, ordered like the date.
+ */
+class TimeBase
+{
+public:
+    explicit TimeBase(Time tick = 0.0) noexcept
+      : m_tick(tick > 0.0 ? tick : 0.0)
+    {
+    }
+
+    /**
+     * Get the resolution of the time base, 0 if the dates are not rounded.
+     */
+    Time tick() const noexcept
+    {
+        return m_tick;
+    }
+
+    /**
+     * Get the key of the @e time: two dates have the same key if they are
+     * in the same bag and the keys are ordered like the dates.
+     */
+    std::int64_t toKey(Time time) const noexcept
+    {
+        if (m_tick > 0.0) {
+            const Time ticks = time / m_tick;
+
+            if (ticks >= maxTicks())
+                return std::numeric_limits<std::int64_t>::max();
+            if (ticks <= -maxTicks())
+                return std::numeric_limits<std::int64_t>::min();
+
+            return std::llround(ticks);
+        }
+
+        time += 0.0; // -0.0 and 0.0 have the same key.
+
+        std::int64_t bits;
+        std::memcpy(&bits, &time, sizeof(bits));
+
+        return bits < 0 ? bits ^ std::numeric_limits<std::int64_t>::max()
+                        : bits;
+    }
+
+    /**
+     * Get the date of the @e key built by toKey().
+     */
+    Time toTime(std::int64_t key) const noexcept
+    {
+        if (m_tick > 0.0) {
+            if (key == std::numeric_limits<std::int64_t>::max())
+                return std::numeric_limits<Time>::infinity();
+            if (key == std::numeric_limits<std::int64_t>::min())
+                return -std::numeric_limits<Time>::infinity();
+
+            return static_cast<Time>(key) * m_tick;
+        }
+
+        if (key < 0)
+            key ^= std::numeric_limits<std::int64_t>::max();
+
+        Time time;
+        std::memcpy(&time, &key, sizeof(time));
+
+        return time;
+    }
+
+    /**
+     * Round the @e time to the nearest multiple of the tick.
+     */
+    Time round(Time time) const noexcept
+    {
+        return m_tick > 0.0 ? toTime(toKey(time)) : time;
+    }
+
+    /**
+     * Get the date of the next event of a model at the @e time with the
+     * time advance @e duration. With a tick, a positive duration is rounded
+     * up to the next multiple of the tick, at least one tick after the
+     * @e time: a duration smaller than the tick can not schedule the model
+     * again at the current date, nor before a longer duration.
+     */
+    Time next(Time time, Time duration) const noexcept
+    {
+        if (m_tick <= 0.0)
+            return time + duration;
+
+        if (not(duration > 0.0))
+            return round(time + duration);
+
+        const Time ticks = (time + duration) / m_tick;
+        if (ticks >= maxTicks())
+            return std::numeric_limits<Time>::infinity();
+
+        /* Tolerates the rounding errors of the division: a date a few ulps
+         * above a multiple of the tick stays on this multiple. */
+        const Time epsilon = std::fmax(
+          1e-9, std::fabs(ticks) * 4 * std::numeric_limits<Time>::epsilon());
+        const auto key = static_cast<std::int64_t>(std::ceil(ticks - epsilon));
+        const auto current = toKey(time);
+
+        return toTime(key > current ? key : current + 1);
+    }
+
+private:
+    static constexpr Time maxTicks() noexcept
+    {
+        return 9.2e18; /* below the largest std::int64_t. */
+    }
+
+    Time m_tick;
+};
+
 /**
  * Transform the @e Time time into @e an std::string.
  *
@@ -24,11 +24,15 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "Thread.hpp"
 #include <cassert>
+#include <exception>
+#include <mutex>
 #include <vle/devs/Dynamics.hpp>
 #include <vle/devs/View.hpp>
 #include <vle/utils/Algo.hpp>
 #include <vle/utils/i18n.hpp>
+#include <vle/value/Double.hpp>
 #include <vle/vpz/CoupledModel.hpp>
 
 namespace vle {
@@ -79,6 +83,82 @@ View::open(utils::ContextPtr ctx,
       pluginname, location, file, std::move(parameters), time);
 }
 
+void
+View::open(const std::string& name, std::vector<ViewRecord>* records)
+{
+    m_name = name;
+    m_records = records;
+}
+
+void
+View::call(ViewRecord::Type type,
+           const Dynamics* dynamics,
+           const std::string& port,
+           Time time,
+           std::unique_ptr<value::Value> value)
+{
+    if (m_records) {
+        m_records->emplace_back();
+        auto& record = m_records->back();
+
+        record.type = type;
+        if (dynamics) {
+            record.simulator = dynamics->getModel().getName();
+            record.parent = dynamics->getModel().getParentName();
+        }
+        record.port = port;
+        record.view = m_name;
+        record.time = time;
+        record.value = std::move(value);
+        return;
+    }
+
+    assert(m_plugin);
+
+    const std::string empty;
+    const auto& simulator = dynamics ? dynamics->getModel().getName() : empty;
+    const auto& parent =
+      dynamics ? dynamics->getModel().getParentName() : empty;
+
+    switch (type) {
+    case ViewRecord::NEW_OBSERVABLE:
+        m_plugin->onNewObservable(simulator, parent, port, m_name, time);
+        break;
+    case ViewRecord::VALUE:
+        m_plugin->onValue(
+          simulator, parent, port, m_name, time, std::move(value));
+        break;
+    case ViewRecord::DEL_OBSERVABLE:
+        m_plugin->onDelObservable(simulator, parent, port, m_name, time);
+        break;
+    }
+}
+
+void
+View::replay(ViewRecord& record)
+{
+    assert(m_plugin);
+
+    switch (record.type) {
+    case ViewRecord::NEW_OBSERVABLE:
+        m_plugin->onNewObservable(
+          record.simulator, record.parent, record.port, m_name, record.time);
+        break;
+    case ViewRecord::VALUE:
+        m_plugin->onValue(record.simulator,
+                          record.parent,
+                          record.port,
+                          m_name,
+                          record.time,
+                          std::move(record.value));
+        break;
+    case ViewRecord::DEL_OBSERVABLE:
+        m_plugin->onDelObservable(
+          record.simulator, record.parent, record.port, m_name, record.time);
+        break;
+    }
+}
+
 void
 View::addObservable(Dynamics* dynamics,
                     const std::string& portname,
@@ -86,31 +166,25 @@ View::addObservable(Dynamics* dynamics,
 {
     assert(dynamics);
     assert(not exist(dynamics, portname));
-    assert(m_plugin);
 
-    m_observableList.emplace(dynamics, portname);
+    m_observableList.emplace(dynamics, Observable{ portname, m_next_id++ });
 
-    m_plugin->onNewObservable(dynamics->getModel().getName(),
-                              dynamics->getModel().getParentName(),
-                              portname,
-                              m_name,
-                              currenttime);
+    call(ViewRecord::NEW_OBSERVABLE, dynamics, portname, currenttime, nullptr);
 }
 
 void
 View::removeObservable(Dynamics* dynamics)
 {
     assert(dynamics);
-    assert(m_plugin);
 
     auto result = m_observableList.equal_range(dynamics);
 
     for (auto it = result.first; it != result.second; ++it)
-        m_plugin->onDelObservable(it->first->getModel().getName(),
-                                  it->first->getModel().getParentName(),
-                                  it->second,
-                                  m_name,
-                                  0.0);
+        call(ViewRecord::DEL_OBSERVABLE,
+             it->first,
+             it->second.port,
+             0.0,
+             nullptr);
 
     m_observableList.erase(result.first, result.second);
 }
@@ -121,7 +195,7 @@ View::exist(Dynamics* dynamics, const std::string& portname) const
     auto result = m_observableList.equal_range(dynamics);
 
     for (auto it = result.first; it != result.second; ++it)
-        if (it->second == portname)
+        if (it->second.port == portname)
             return true;
 
     return false;
@@ -136,24 +210,84 @@ View::exist(Dynamics* dynamics) const
 void
 View::run(Time time)
 {
-    if (not m_observableList.empty()) {
-        for (auto& elem : m_observableList) {
-            ObservationEvent event(time, m_name, elem.second);
-            auto val = elem.first->observation(event);
-            m_plugin->onValue(elem.first->getModel().getName(),
-                              elem.first->getModel().getParentName(),
-                              elem.second,
-                              m_name,
-                              time,
-                              std::move(val));
-        }
-    } else {
+    if (m_observableList.empty()) {
         //
         // Strange behavior.
         //
-        m_plugin->onValue(
-          std::string(), std::string(), std::string(), m_name, time, nullptr);
+        call(ViewRecord::VALUE, nullptr, std::string(), time, nullptr);
+        return;
+    }
+
+    const std::size_t size = m_observableList.size();
+    std::vector<const ObservableList::value_type*> observables;
+    observables.reserve(size);
+    for (const auto& elem : m_observableList)
+        observables.push_back(&elem);
+
+    std::vector<std::unique_ptr<value::Value>> values(size);
+
+    if (m_pool and size > 1) {
+        //
+        // The const observation() functions are called by the workers, the
+        // values are sent to the plug-in in the order of m_observableList.
+        //
+        std::exception_ptr error;
+        std::mutex mutex;
+
+        auto observe = [this, time, &observables, &values, &error, &mutex](
+          std::size_t begin, std::size_t end) {
+            for (; begin < end; ++begin) {
+                try {
+                    const auto* elem = observables[begin];
+                    ObservationEvent event(time, m_name, elem->second.port);
+                    values[begin] = elem->first->observation(event);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (not error)
+                        error = std::current_exception();
+                }
+            }
+        };
+
+        m_pool->parallel_for(size, observe);
+
+        if (error)
+            std::rethrow_exception(error);
+    } else {
+        for (std::size_t i = 0; i != size; ++i) {
+            ObservationEvent event(time, m_name, observables[i]->second.port);
+            values[i] = observables[i]->first->observation(event);
+        }
+    }
+
+    if (m_plugin and not m_records and m_plugin->batch()) {
+        std::vector<std::size_t> ids(size);
+        bool doubles = true;
+
+        for (std::size_t i = 0; i != size; ++i) {
+            ids[i] = observables[i]->second.id;
+            doubles = doubles and values[i] and values[i]->isDouble();
+        }
+
+        if (doubles) {
+            std::vector<double> reals(size);
+            for (std::size_t i = 0; i != size; ++i)
+                reals[i] = values[i]->toDouble().value();
+
+            m_plugin->onDoubles(time, m_name, ids, reals);
+        } else {
+            m_plugin->onValues(time, m_name, ids, values);
+        }
+
+        return;
     }
+
+    for (std::size_t i = 0; i != size; ++i)
+        call(ViewRecord::VALUE,
+             observables[i]->first,
+             observables[i]->second.port,
+             time,
+             std::move(values[i]));
 }
 
 void
@@ -162,12 +296,7 @@ View::run(const Dynamics* dynamics, Time current, const std::string& port)
     ObservationEvent event(current, m_name, port);
     auto val = dynamics->observation(event);
 
-    m_plugin->onValue(dynamics->getModel().getName(),
-                      dynamics->getModel().getParentName(),
-                      port,
-                      m_name,
-                      current,
-                      std::move(val));
+    call(ViewRecord::VALUE, dynamics, port, current, std::move(val));
 }
 
 void
@@ -176,24 +305,37 @@ View::run(const Dynamics* dynamics,
           const std::string& port,
           std::unique_ptr<value::Value> value)
 {
-    m_plugin->onValue(dynamics->getModel().getName(),
-                      dynamics->getModel().getParentName(),
-                      port,
-                      m_name,
-                      current,
-                      std::move(value));
+    call(ViewRecord::VALUE, dynamics, port, current, std::move(value));
 }
 
 std::unique_ptr<value::Matrix>
 View::matrix() const
 {
+    if (not m_plugin)
+        return {};
+
     return m_plugin->matrix();
 }
 
 std::unique_ptr<value::Matrix>
 View::finish(Time current)
 {
+    if (not m_plugin)
+        return {};
+
     return m_plugin->finish(current);
 }
+
+std::unique_ptr<value::Value>
+View::checkpoint()
+{
+    return m_plugin->checkpoint();
+}
+
+void
+View::restore(const value::Value& state)
+{
+    m_plugin->restore(state);
+}
 }
 } // namespace vle devs
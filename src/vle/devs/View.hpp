@@ -29,16 +29,19 @@
 
 #include <map>
 #include <string>
+#include <vector>
 #include <vle/DllDefines.hpp>
 #include <vle/devs/Time.hpp>
 #include <vle/oov/Plugin.hpp>
 #include <vle/utils/Context.hpp>
+#include <vle/utils/Symbol.hpp>
 #include <vle/value/Matrix.hpp>
 
 namespace vle {
 namespace devs {
 
 class Dynamics;
+class SimulatorProcessParallel;
 class View;
 
 /**
@@ -52,6 +55,28 @@ struct Observation
     std::unique_ptr<value::Value> value;
 };
 
+/**
+ * A call to the plug-in of a View stored during a distributed simulation
+ * to be sent to the process that owns the plug-in.
+ */
+struct ViewRecord
+{
+    enum Type
+    {
+        NEW_OBSERVABLE,
+        VALUE,
+        DEL_OBSERVABLE
+    };
+
+    Type type = VALUE;
+    std::string simulator;
+    std::string parent;
+    std::string port;
+    std::string view;
+    Time time = 0.0;
+    std::unique_ptr<value::Value> value;
+};
+
 /**
  * @brief Represent a View on a devs::Dynamics and a port name.
  *
@@ -81,6 +106,39 @@ public:
               Time time,
               std::unique_ptr<value::Value> parameters);
 
+    /**
+     * Initialize a View without plug-in: all the calls to the plug-in are
+     * stored into @e records.
+     *
+     * @param name the name of the View.
+     * @param records where to store the calls to the plug-in.
+     */
+    void open(const std::string& name, std::vector<ViewRecord>* records);
+
+    /**
+     * Store the next calls to the plug-in into @e records instead of
+     * calling the plug-in, until the next call with nullptr.
+     */
+    void record(std::vector<ViewRecord>* records) noexcept
+    {
+        m_records = records;
+    }
+
+    /**
+     * Compute the observations of run(Time) with the workers of @e pool,
+     * nullptr to compute them in the calling thread. The values are sent
+     * to the plug-in in the same order in both cases.
+     */
+    void parallelize(SimulatorProcessParallel* pool) noexcept
+    {
+        m_pool = pool;
+    }
+
+    /**
+     * Call the plug-in with a ViewRecord stored by another View.
+     */
+    void replay(ViewRecord& record);
+
     /**
      * Add new observable (\e Dynamics*, \e portname) into the View.
      *
@@ -150,12 +208,40 @@ public:
      */
     std::unique_ptr<value::Matrix> finish(Time current);
 
+    /**
+     * Return the state of the plug-in to store in a checkpoint or NULL if
+     * the plug-in has nothing to save.
+     */
+    std::unique_ptr<value::Value> checkpoint();
+
+    /**
+     * Give to the plug-in the state stored in a checkpoint.
+     */
+    void restore(const value::Value& state);
+
 protected:
-    using ObservableList = std::multimap<Dynamics*, std::string>;
+    /// A port of a Dynamics and its index in the onNewObservable() calls
+    /// of the plug-in (see oov::Plugin::onValues()).
+    struct Observable
+    {
+        utils::Symbol port;
+        std::size_t id;
+    };
+
+    using ObservableList = std::multimap<Dynamics*, Observable>;
 
     ObservableList m_observableList;
-    std::string m_name;
+    std::size_t m_next_id = 0;
+    utils::Symbol m_name;
     oov::PluginPtr m_plugin;
+    std::vector<ViewRecord>* m_records = nullptr;
+    SimulatorProcessParallel* m_pool = nullptr;
+
+    void call(ViewRecord::Type type,
+              const Dynamics* dynamics,
+              const std::string& port,
+              Time time,
+              std::unique_ptr<value::Value> value);
 };
 }
 } // namespace vle devs
@@ -28,6 +28,7 @@
 #define VLE_DEVS_VIEWEVENT_HPP 1
 
 #include <cassert>
+#include <vector>
 #include <vle/DllDefines.hpp>
 #include <vle/devs/View.hpp>
 
@@ -35,35 +36,32 @@ namespace vle {
 namespace devs {
 
 /**
- * ViewEvent is used in scheduller to store the date to launch observation of
- * atomic models.
+ * ViewEvent is used in the timed observation scheduler to store the timed
+ * views sharing the same timestep and the same date of their next
+ * observation.
  */
 struct VLE_LOCAL ViewEvent
 {
-    ViewEvent(View* view, Time currenttime, Time timestep)
-      : mView(view)
-      , mTime(currenttime)
+    ViewEvent(Time currenttime, Time timestep)
+      : mTime(currenttime)
       , mTimestep(timestep)
     {
-        assert(view && "ViewEvent: view is null");
         assert(not isInfinity(currenttime) && "ViewEvent: bad current time");
         assert(not isInfinity(timestep) && "ViewEvent: bad timestep");
     }
 
     /**
-     * Call for each \e devs::Dynamics attached to this view, the
+     * Call for each \e devs::Dynamics attached to the views, the
      * observation function.
      */
     void run()
     {
-        assert(mView &&
-               "ViewEvent::run(Time) was called previously. Mistake.");
-
-        mView->run(mTime);
+        for (auto* view : mViews)
+            view->run(mTime);
     }
 
     /**
-     * Call for each \e devs::Dynanics attached to this view, the
+     * Call for each \e devs::Dynanics attached to the views, the
      * observation function for a specified time.
      *
      * \note To be use in final simulation loop.
@@ -72,22 +70,11 @@ struct VLE_LOCAL ViewEvent
      */
     void run(Time time)
     {
-        assert(mView &&
-               "ViewEvent::run(Time) was called previously. Mistake.");
-
-        mView->run(time);
-        mView = nullptr;
-    }
-
-    /**
-     * Update the next wake-up time.
-     */
-    void update()
-    {
-        mTime += mTimestep;
+        for (auto* view : mViews)
+            view->run(time);
     }
 
-    View* mView;
+    std::vector<View*> mViews;
     Time mTime;
     Time mTimestep;
 };
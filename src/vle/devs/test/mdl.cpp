@@ -26,6 +26,7 @@
 
 #include "oov.hpp"
 #include <boost/format.hpp>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <limits>
@@ -33,19 +34,29 @@
 #include <stack>
 #include <stdexcept>
 #include <vle/devs/Coordinator.hpp>
+#include <vle/devs/Distributed.hpp>
 #include <vle/devs/Dynamics.hpp>
 #include <vle/devs/DynamicsDbg.hpp>
+#include <vle/devs/DynamicsInit.hpp>
 #include <vle/devs/Executive.hpp>
 #include <vle/devs/RootCoordinator.hpp>
 #include <vle/oov/Plugin.hpp>
 #include <vle/utils/Filesystem.hpp>
 #include <vle/utils/unit-test.hpp>
+#include <vle/value/Binary.hpp>
+#include <vle/value/Null.hpp>
 #include <vle/value/Set.hpp>
+#include <vle/value/String.hpp>
+#include <vle/value/Tuple.hpp>
 #include <vle/vpz/Classes.hpp>
 #include <vle/vpz/CoupledModel.hpp>
 #include <vle/vpz/Dynamics.hpp>
 #include <vle/vpz/Experiment.hpp>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 using namespace vle;
 
 #define xstringify(a) stringify(a)
@@ -105,6 +116,95 @@ public:
     {
         output.emplace_back("out");
     }
+
+    virtual std::unique_ptr<value::Value> checkpoint() const override
+    {
+        return value::Null::create();
+    }
+
+    virtual void restore(const value::Value& /* state */,
+                         devs::Time /* time */) override
+    {
+    }
+};
+
+/* Sends its name every period. */
+class Tagger : public devs::Dynamics
+{
+public:
+    Tagger(const devs::DynamicsInit& model, const devs::InitEventList& events)
+      : devs::Dynamics(model, events)
+      , m_period(events.getDouble(getModelName()))
+    {
+    }
+
+    virtual devs::Time init(devs::Time /* time */) override
+    {
+        return m_period;
+    }
+
+    virtual devs::Time timeAdvance() const override
+    {
+        return m_period;
+    }
+
+    virtual void output(devs::Time /* time */,
+                        devs::ExternalEventList& output) const override
+    {
+        output.emplace_back("out");
+        output.back().addString(getModelName());
+    }
+
+    virtual std::unique_ptr<value::Value> checkpoint() const override
+    {
+        return value::Null::create();
+    }
+
+    virtual void restore(const value::Value& /* state */,
+                         devs::Time /* time */) override
+    {
+    }
+
+private:
+    devs::Time m_period;
+};
+
+/* Records the names received, in the order of the external events. */
+class Recorder : public devs::Dynamics
+{
+public:
+    Recorder(const devs::DynamicsInit& model,
+             const devs::InitEventList& events)
+      : devs::Dynamics(model, events)
+    {
+    }
+
+    virtual void externalTransition(const devs::ExternalEventList& events,
+                                    devs::Time /* time */) override
+    {
+        for (const auto& elem : events)
+            m_names += elem.getString().value() + ' ';
+    }
+
+    virtual std::unique_ptr<value::Value> observation(
+      const devs::ObservationEvent& /* event */) const override
+    {
+        return value::String::create(m_names);
+    }
+
+    virtual std::unique_ptr<value::Value> checkpoint() const override
+    {
+        return value::String::create(m_names);
+    }
+
+    virtual void restore(const value::Value& state,
+                         devs::Time /* time */) override
+    {
+        m_names = state.toString().value();
+    }
+
+private:
+    std::string m_names;
 };
 
 class Branch : public devs::Executive
@@ -160,8 +260,11 @@ public:
     Counter(const devs::DynamicsInit& model, const devs::InitEventList& events)
       : devs::Dynamics(model, events)
       , m_counter(0)
+      , m_step(1)
       , m_active(false)
     {
+        if (events.exist("step"))
+            m_step = events.getInt("step");
     }
 
     virtual devs::Time init(devs::Time /* time */) override
@@ -191,7 +294,7 @@ public:
     virtual void externalTransition(const devs::ExternalEventList& events,
                                     devs::Time /* time */) override
     {
-        m_counter += events.size();
+        m_counter += m_step * events.size();
         m_active = true;
     }
 
@@ -210,11 +313,82 @@ public:
         return {};
     }
 
+    virtual std::unique_ptr<value::Value> checkpoint() const override
+    {
+        auto state = std::make_unique<value::Map>();
+        state->addDouble("counter", m_counter);
+        state->addBoolean("active", m_active);
+
+        return state;
+    }
+
+    virtual void restore(const value::Value& state,
+                         devs::Time /* time */) override
+    {
+        m_counter = static_cast<long>(state.toMap().getDouble("counter"));
+        m_active = state.toMap().getBoolean("active");
+    }
+
+    virtual void updateConditions(const devs::InitEventList& events,
+                                  devs::Time /* time */) override
+    {
+        m_step = events.getInt("step");
+    }
+
 private:
     long m_counter;
+    long m_step;
     bool m_active;
 };
 
+class Pulse : public devs::Dynamics
+{
+public:
+    Pulse(const devs::DynamicsInit& model, const devs::InitEventList& events)
+      : devs::Dynamics(model, events)
+      , m_period(events.getDouble("period"))
+      , m_lookahead(m_period)
+    {
+        if (events.exist("lookahead"))
+            m_lookahead = events.getDouble("lookahead");
+    }
+
+    virtual devs::Time init(devs::Time /* time */) override
+    {
+        return m_period;
+    }
+
+    virtual devs::Time timeAdvance() const override
+    {
+        return m_period;
+    }
+
+    virtual devs::Time lookahead() const override
+    {
+        return m_lookahead;
+    }
+
+    virtual void output(devs::Time /* time */,
+                        devs::ExternalEventList& output) const override
+    {
+        output.emplace_back("out");
+    }
+
+    virtual std::unique_ptr<value::Value> checkpoint() const override
+    {
+        return value::Null::create();
+    }
+
+    virtual void restore(const value::Value& /* state */,
+                         devs::Time /* time */) override
+    {
+    }
+
+private:
+    devs::Time m_period;
+    devs::Time m_lookahead;
+};
+
 class DeleteConnection : public devs::Executive
 {
 public:
@@ -619,6 +793,29 @@ public:
         return devs::Executive::observation(ev);
     }
 
+    virtual std::unique_ptr<value::Value> checkpoint() const override
+    {
+        auto data = std::make_unique<value::Map>();
+        data->addInt("state", m_state);
+
+        auto& names = data->addSet("names");
+        auto copy = m_stacknames;
+        for (; not copy.empty(); copy.pop())
+            names.addString(copy.top());
+
+        return data;
+    }
+
+    virtual void restore(const value::Value& data,
+                         devs::Time /* time */) override
+    {
+        m_state = static_cast<state>(data.toMap().getInt("state"));
+
+        const auto& names = data.toMap().getSet("names");
+        for (auto i = names.size(); i > 0; --i)
+            m_stacknames.push(names.getString(i - 1));
+    }
+
     void add_new_model()
     {
         printf("add_new_model starts\n");
@@ -729,6 +926,9 @@ public:
 DECLARE_DYNAMICS_SYMBOL(dynamics_MyBeep, MyBeep)
 DECLARE_DYNAMICS_SYMBOL(dynamics_counter, Counter)
 DECLARE_DYNAMICS_SYMBOL(dynamics_transform, Transform)
+DECLARE_DYNAMICS_SYMBOL(dynamics_pulse, Pulse)
+DECLARE_DYNAMICS_SYMBOL(dynamics_tagger, Tagger)
+DECLARE_DYNAMICS_SYMBOL(dynamics_recorder, Recorder)
 DECLARE_DYNAMICS_SYMBOL(dynamics_confluent_transitionA, Confluent_transitionA)
 DECLARE_DYNAMICS_SYMBOL(dynamics_confluent_transitionB, Confluent_transitionB)
 DECLARE_DYNAMICS_SYMBOL(dynamics_confluent_transitionC, Confluent_transitionC)
@@ -739,6 +939,7 @@ DECLARE_EXECUTIVE_SYMBOL(exe_genexecutive, GenExecutive)
 DECLARE_EXECUTIVE_SYMBOL(exe_leaf, Leaf)
 DECLARE_EXECUTIVE_SYMBOL(exe_root, Root)
 DECLARE_OOV_SYMBOL(oov_plugin, vletest::OutputPlugin)
+DECLARE_OOV_SYMBOL(oov_batch_plugin, vletest::BatchOutputPlugin)
 
 void
 test_normal_behaviour()
@@ -820,6 +1021,353 @@ test_gensvpz()
     EnsuresEqual(value::toInteger(matrix(2, 100)), 1);
 }
 
+void
+test_gensvpz_run_until()
+{
+    auto ctx = vle::utils::make_context();
+    vle::utils::Path p(DEVS_TEST_DIR);
+    vle::utils::Path::current_path(p);
+
+    vpz::Vpz file(DEVS_TEST_DIR "/gens.vpz");
+    devs::RootCoordinator root(ctx);
+
+    root.load(file);
+    file.clear();
+    root.init();
+
+    Ensures(root.run_until(50.0));
+    Ensures(root.getCurrentTime() > 50.0);
+    Ensures(not root.run_until(devs::infinity));
+
+    std::unique_ptr<value::Map> out = root.outputs();
+    root.finish();
+
+    Ensures(out);
+
+    value::Matrix& matrix = out->getMatrix("view1");
+    EnsuresEqual(matrix.rows(), (std::size_t)101);
+    EnsuresEqual(value::toDouble(matrix(1, 10)), 55);
+    EnsuresEqual(value::toDouble(matrix(1, 100)), 2550);
+    EnsuresEqual(value::toInteger(matrix(2, 100)), 1);
+}
+
+void
+test_gensvpz_tick()
+{
+    auto ctx = vle::utils::make_context();
+    vle::utils::Path p(DEVS_TEST_DIR);
+    vle::utils::Path::current_path(p);
+
+    vpz::Vpz file(DEVS_TEST_DIR "/gens.vpz");
+    file.project().experiment().setTick(0.1);
+    file.project().experiment().views().get("view1").setTimestep(0.1);
+    EnsuresEqual(file.project().experiment().tick(), 0.1);
+
+    devs::RootCoordinator root(ctx);
+    root.load(file);
+    file.clear();
+    root.init();
+
+    while (root.run())
+        ;
+    std::unique_ptr<value::Map> out = root.outputs();
+    root.finish();
+
+    Ensures(out);
+
+    /*
+     * The oov_plugin keeps the last observation of each unit of time: the
+     * accumulated timesteps are exact multiples of the tick.
+     */
+    value::Matrix& matrix = out->getMatrix("view1");
+    EnsuresEqual(matrix.rows(), (std::size_t)101);
+
+    for (std::size_t i = 0; i < 100; ++i)
+        EnsuresEqual(value::toDouble(matrix(0, i)), (10 * i + 9) * 0.1);
+
+    EnsuresEqual(value::toDouble(matrix(0, 100)), 100);
+    EnsuresEqual(value::toDouble(matrix(1, 100)), 2550);
+}
+
+void
+test_tick_smaller_time_advance()
+{
+    auto ctx = vle::utils::make_context();
+    vle::utils::Path p(DEVS_TEST_DIR);
+    vle::utils::Path::current_path(p);
+
+    /*
+     * The pulse has a time advance of a quarter of the tick: its next date
+     * is rounded up to the next tick, not back to the current date.
+     */
+    vpz::Vpz file(DEVS_TEST_DIR "/partitions.vpz");
+    file.project().experiment().setTick(1.0);
+    file.project().experiment().conditions().get("pulse").setValueToPort(
+      "period", value::Double::create(0.25));
+
+    devs::RootCoordinator root(ctx);
+    root.setProfile(true);
+    root.load(file);
+    file.clear();
+    root.init();
+
+    long bags = 0;
+    while (root.run() and bags < 1000)
+        ++bags;
+    Ensures(bags < 1000);
+    root.finish();
+
+    auto profile = root.profile();
+    Ensures(profile);
+
+    const auto& pulse = profile->getMap("models").getMap("top,left,pulse");
+    EnsuresEqual(pulse.getDouble("internal-count"), 100.0);
+}
+
+void
+test_gensvpz_profile()
+{
+    auto ctx = vle::utils::make_context();
+    vle::utils::Path p(DEVS_TEST_DIR);
+    vle::utils::Path::current_path(p);
+
+    {
+        vpz::Vpz file(DEVS_TEST_DIR "/gens.vpz");
+        devs::RootCoordinator root(ctx);
+
+        root.load(file);
+        file.clear();
+        root.init();
+        while (root.run())
+            ;
+        root.finish();
+
+        Ensures(not root.profile());
+    }
+
+    vpz::Vpz file(DEVS_TEST_DIR "/gens.vpz");
+    devs::RootCoordinator root(ctx);
+
+    root.setProfile(true);
+    root.load(file);
+    file.clear();
+    root.init();
+    while (root.run())
+        ;
+    root.finish();
+
+    auto profile = root.profile();
+    Ensures(profile);
+
+    const auto& kernel = profile->getMap("kernel");
+    Ensures(kernel.getDouble("bags") > 0);
+    Ensures(kernel.getDouble("bag-size-max") >= 1);
+    Ensures(kernel.getDouble("scheduler-internal") > 0);
+    Ensures(kernel.getDouble("dispatch-events") > 0);
+    EnsuresEqual(kernel.getDouble("dispatch-messages"),
+                 kernel.getDouble("scheduler-external"));
+
+    const auto& histogram = kernel.getTuple("bag-size-histogram");
+    double bags = 0;
+    for (auto elem : histogram.value())
+        bags += elem;
+    EnsuresEqual(bags, kernel.getDouble("bags"));
+
+    /* the executive builds and deletes generators during the simulation */
+    const auto& models = profile->getMap("models");
+    Ensures(models.size() > 2);
+
+    const auto& counter = models.getMap("top,counter");
+    Ensures(counter.getDouble("external-count") > 0);
+    Ensures(counter.getDouble("time-advance-count") > 0);
+    Ensures(counter.getDouble("output-count") > 0);
+}
+
+void
+test_gensvpz_checkpoint()
+{
+    auto ctx = vle::utils::make_context();
+    vle::utils::Path p(DEVS_TEST_DIR);
+    vle::utils::Path::current_path(p);
+
+    std::unique_ptr<value::Map> expected, checkpoint;
+
+    {
+        vpz::Vpz file(DEVS_TEST_DIR "/gens.vpz");
+        devs::RootCoordinator root(ctx);
+
+        EnsuresThrow(root.checkpoint(), utils::InternalError);
+
+        root.setCheckpoint(true);
+        root.load(file);
+        file.clear();
+        root.init();
+
+        /* the executive adds models until 50 and deletes them after */
+        while (root.run())
+            if (not checkpoint and root.getCurrentTime() >= 60.0)
+                checkpoint = root.checkpoint();
+
+        expected = root.outputs();
+        root.finish();
+    }
+
+    Ensures(checkpoint);
+    EnsuresEqual(checkpoint->getMap("kernel").getDouble("time"), 60.0);
+
+    auto copy = value::fromBinary(value::toBinary(*checkpoint));
+    devs::RootCoordinator root(ctx);
+    root.restore(copy->toMap());
+    while (root.run())
+        ;
+    auto out = root.outputs();
+    root.finish();
+
+    Ensures(out);
+    EnsuresEqual(out->getMatrix("view1").rows(), (std::size_t)101);
+    EnsuresEqual(value::toBinary(*out), value::toBinary(*expected));
+}
+
+void
+test_checkpoint_tied_dates()
+{
+    auto ctx = vle::utils::make_context();
+    vle::utils::Path p(DEVS_TEST_DIR);
+    vle::utils::Path::current_path(p);
+
+    std::unique_ptr<value::Map> expected, checkpoint;
+
+    {
+        vpz::Vpz file(DEVS_TEST_DIR "/ties.vpz");
+        devs::RootCoordinator root(ctx);
+
+        root.setCheckpoint(true);
+        root.load(file);
+        file.clear();
+        root.init();
+
+        while (root.run())
+            if (not checkpoint and root.getCurrentTime() >= 4.0)
+                checkpoint = root.checkpoint();
+
+        expected = root.outputs();
+        root.finish();
+    }
+
+    Ensures(checkpoint);
+
+    /* at the checkpoint, 'b' is pushed at 6 before 'a': the resumed run
+     * keeps this order, not the order of the models */
+    const auto& matrix = expected->getMatrix("view");
+    EnsuresEqual(matrix.rows(), (std::size_t)31);
+    EnsuresEqual(value::toString(matrix(1, 6)), "a b a c b a ");
+
+    auto copy = value::fromBinary(value::toBinary(*checkpoint));
+    devs::RootCoordinator root(ctx);
+    root.restore(copy->toMap());
+    while (root.run())
+        ;
+    auto out = root.outputs();
+    root.finish();
+
+    Ensures(out);
+    EnsuresEqual(value::toBinary(*out), value::toBinary(*expected));
+}
+
+/* Load gens.vpz with a "step" condition for the counter. */
+static void
+load_gens_step(devs::RootCoordinator& root, int step, bool executive = false)
+{
+    vpz::Vpz file(DEVS_TEST_DIR "/gens.vpz");
+    auto& cnd = file.project().experiment().conditions().add(
+      vpz::Condition("step"));
+    cnd.addValueToPort("step", value::Integer::create(step));
+
+    auto* top = static_cast<vpz::CoupledModel*>(file.project().model().node());
+    auto* counter = static_cast<vpz::AtomicModel*>(top->getModel("counter"));
+    counter->addCondition("step");
+    if (executive)
+        static_cast<vpz::AtomicModel*>(top->getModel("executive"))
+          ->addCondition("step");
+
+    root.load(file);
+    file.clear();
+    root.init();
+}
+
+void
+test_gensvpz_update_conditions()
+{
+    auto ctx = vle::utils::make_context();
+    vle::utils::Path p(DEVS_TEST_DIR);
+    vle::utils::Path::current_path(p);
+
+    vpz::Conditions step2;
+    step2.add(vpz::Condition("step"))
+      .addValueToPort("step", value::Integer::create(2));
+
+    std::unique_ptr<value::Map> expected, step1;
+    {
+        devs::RootCoordinator root(ctx);
+        load_gens_step(root, 2);
+        while (root.run())
+            ;
+        expected = root.outputs();
+        root.finish();
+    }
+
+    {
+        devs::RootCoordinator root(ctx);
+        load_gens_step(root, 1);
+        while (root.run())
+            ;
+        step1 = root.outputs();
+        root.finish();
+    }
+
+    EnsuresEqual(value::toDouble(step1->getMatrix("view1")(1, 100)), 2550);
+    EnsuresEqual(value::toDouble(expected->getMatrix("view1")(1, 100)), 5100);
+
+    {
+        /* updated before the first bag: same as a simulation with step=2 */
+        devs::RootCoordinator root(ctx);
+        load_gens_step(root, 1);
+        root.updateConditions(step2, { "step" });
+        while (root.run())
+            ;
+        auto out = root.outputs();
+        root.finish();
+
+        EnsuresEqual(value::toBinary(*out), value::toBinary(*expected));
+    }
+
+    {
+        /* updated at 10: the counter doubles its increments after 10 */
+        devs::RootCoordinator root(ctx);
+        load_gens_step(root, 1);
+        while (root.getNextTime() < 10.0 and root.run())
+            ;
+        root.updateConditions(step2, { "step" });
+        while (root.run())
+            ;
+        auto out = root.outputs();
+        root.finish();
+
+        const auto& matrix = out->getMatrix("view1");
+        EnsuresEqual(value::toDouble(matrix(1, 9)), 45);
+        auto last = value::toDouble(matrix(1, 100));
+        Ensures(last > 2550 and last < 5100);
+    }
+
+    {
+        /* the executive does not implement updateConditions */
+        devs::RootCoordinator root(ctx);
+        load_gens_step(root, 1, true);
+        EnsuresThrow(root.updateConditions(step2, { "step" }),
+                     utils::NotYetImplemented);
+    }
+}
+
 void
 test_gens_delete_connection()
 {
@@ -940,6 +1488,240 @@ test_confluent_transition_2()
     }
 }
 
+/* Run partitions.vpz sequentially or with one partition per sub-model. */
+static std::unique_ptr<value::Map>
+run_partitions(bool partition, double lookahead, bool optimistic = false)
+{
+    auto ctx = vle::utils::make_context();
+    ctx->set_setting("vle.simulation.partition", partition);
+    ctx->set_setting("vle.simulation.optimistic", optimistic);
+
+    vpz::Vpz file(DEVS_TEST_DIR "/partitions.vpz");
+    file.project().experiment().conditions().get("pulse").addValueToPort(
+      "lookahead", value::Double::create(lookahead));
+
+    devs::RootCoordinator root(ctx);
+    root.load(file);
+    file.clear();
+    root.init();
+
+    while (root.run())
+        ;
+    auto out = root.outputs();
+    root.finish();
+
+    return out;
+}
+
+void
+test_partitions()
+{
+    vle::utils::Path p(DEVS_TEST_DIR);
+    vle::utils::Path::current_path(p);
+
+    auto expected = run_partitions(false, 10.0);
+    auto out = run_partitions(true, 10.0);
+
+    Ensures(out);
+    EnsuresEqual(out->getMatrix("view1").rows(), (std::size_t)101);
+    EnsuresEqual(value::toBinary(*out), value::toBinary(*expected));
+
+    /* a lookahead greater than the time advance of the pulse is only
+     * checked by the partitioned run */
+    Ensures(run_partitions(false, 20.0));
+    EnsuresThrow(run_partitions(true, 20.0), utils::ModellingError);
+
+    /* the optimistic run does not use the lookahead */
+    for (int i = 0; i != 10; ++i) {
+        out = run_partitions(true, 20.0, true);
+        Ensures(out);
+        EnsuresEqual(value::toBinary(*out), value::toBinary(*expected));
+    }
+}
+
+/* Run ties.vpz sequentially or with one partition per atomic model. */
+static std::unique_ptr<value::Map>
+run_ties(bool partition, bool optimistic = false)
+{
+    auto ctx = vle::utils::make_context();
+    ctx->set_setting("vle.simulation.partition", partition);
+    ctx->set_setting("vle.simulation.optimistic", optimistic);
+
+    vpz::Vpz file(DEVS_TEST_DIR "/ties.vpz");
+    devs::RootCoordinator root(ctx);
+    root.load(file);
+    file.clear();
+    root.init();
+
+    while (root.run())
+        ;
+    auto out = root.outputs();
+    root.finish();
+
+    return out;
+}
+
+void
+test_partitions_ties()
+{
+    vle::utils::Path p(DEVS_TEST_DIR);
+    vle::utils::Path::current_path(p);
+
+    /* the three taggers and the recorder are in four partitions: the
+     * events sent at the same date by the taggers reach the recorder in
+     * the order of the sequential run */
+    auto expected = run_ties(false);
+    const auto& matrix = expected->getMatrix("view");
+    EnsuresEqual(matrix.rows(), (std::size_t)31);
+    EnsuresEqual(value::toString(matrix(1, 15)),
+                 "a b a c b a a b c a b a a c b ");
+
+    for (int i = 0; i != 10; ++i) {
+        auto out = run_ties(true);
+        Ensures(out);
+        EnsuresEqual(value::toBinary(*out), value::toBinary(*expected));
+
+        out = run_ties(true, true);
+        Ensures(out);
+        EnsuresEqual(value::toBinary(*out), value::toBinary(*expected));
+    }
+}
+
+void
+test_dynamics_rand()
+{
+    auto ctx = vle::utils::make_context();
+    vpz::CoupledModel top("top", nullptr);
+    auto* dice = top.addAtomicModel("dice");
+    devs::InitEventList events;
+    utils::PackageTable pkg_table;
+
+    /* the generator of a model is the stream of its complete name */
+    devs::Dynamics dynamics(
+      devs::DynamicsInit{ ctx, *dice, pkg_table.get(""), 42, 3 }, events);
+    auto rand = dynamics.buildRand();
+    utils::Rand expected(42, utils::Rand::stream(dice->getCompleteName()), 3);
+    for (int i = 0; i != 16; ++i)
+        EnsuresEqual(rand.getInt(), expected.getInt());
+
+    devs::Dynamics replicate(
+      devs::DynamicsInit{ ctx, *dice, pkg_table.get(""), 42, 4 }, events);
+    rand = dynamics.buildRand();
+    auto other = replicate.buildRand();
+    EnsuresNotEqual(rand.getInt(), other.getInt());
+}
+
+void
+test_timed_observation_threads()
+{
+    vle::utils::Path p(DEVS_TEST_DIR);
+    vle::utils::Path::current_path(p);
+
+    auto expected = run_partitions(false, 10.0);
+
+    /* the observations of the timed view are computed by the workers */
+    auto ctx = vle::utils::make_context();
+    ctx->set_setting("vle.simulation.thread", 2l);
+    ctx->set_setting("vle.simulation.block-size", 1l);
+
+    vpz::Vpz file(DEVS_TEST_DIR "/partitions.vpz");
+    devs::RootCoordinator root(ctx);
+    root.load(file);
+    file.clear();
+    root.init();
+
+    while (root.run())
+        ;
+    auto out = root.outputs();
+    root.finish();
+
+    Ensures(out);
+    EnsuresEqual(value::toBinary(*out), value::toBinary(*expected));
+}
+
+void
+test_batch_observation()
+{
+    vle::utils::Path p(DEVS_TEST_DIR);
+    vle::utils::Path::current_path(p);
+
+    auto expected = run_partitions(false, 10.0);
+
+    /* the timed view sends its values with onValues() and onDoubles() */
+    auto ctx = vle::utils::make_context();
+    vpz::Vpz file(DEVS_TEST_DIR "/partitions.vpz");
+    file.project().experiment().views().outputs().get("o").setStream(
+      "", "oov_batch_plugin");
+
+    devs::RootCoordinator root(ctx);
+    root.load(file);
+    file.clear();
+    root.init();
+
+    while (root.run())
+        ;
+    auto out = root.outputs();
+    root.finish();
+
+    Ensures(out);
+    EnsuresEqual(value::toBinary(*out), value::toBinary(*expected));
+}
+
+std::unique_ptr<value::Map>
+run_distributed(std::shared_ptr<devs::DistributedChannel> channel)
+{
+    auto ctx = vle::utils::make_context();
+    vpz::Vpz file(DEVS_TEST_DIR "/partitions.vpz");
+
+    devs::RootCoordinator root(ctx);
+    root.setDistributed(channel);
+    root.load(file);
+    file.clear();
+    root.init();
+
+    while (root.run())
+        ;
+    auto out = root.outputs();
+    root.finish();
+
+    return out;
+}
+
+void
+test_distributed()
+{
+#ifndef _WIN32
+    vle::utils::Path p(DEVS_TEST_DIR);
+    vle::utils::Path::current_path(p);
+
+    auto expected = run_partitions(false, 10.0);
+
+    /* the process 1 simulates the right model and sends its events and
+     * observations to the process 0 */
+    std::shared_ptr<devs::DistributedChannel> channel =
+      devs::make_local_channel(2);
+
+    if (channel->rank() != 0) {
+        int status = EXIT_SUCCESS;
+        try {
+            if (run_distributed(channel))
+                status = EXIT_FAILURE;
+        } catch (...) {
+            status = EXIT_FAILURE;
+        }
+        channel.reset();
+        ::_exit(status);
+    }
+
+    auto out = run_distributed(channel);
+    channel.reset();
+
+    Ensures(out);
+    EnsuresEqual(out->getMatrix("view1").rows(), (std::size_t)101);
+    EnsuresEqual(value::toBinary(*out), value::toBinary(*expected));
+#endif
+}
+
 int
 main()
 {
@@ -949,6 +1731,19 @@ main()
     test_confluent_transition();
     test_confluent_transition_2();
     test_gensvpz();
+    test_gensvpz_run_until();
+    test_gensvpz_tick();
+    test_tick_smaller_time_advance();
+    test_gensvpz_profile();
+    test_gensvpz_checkpoint();
+    test_checkpoint_tied_dates();
+    test_gensvpz_update_conditions();
+    test_partitions();
+    test_partitions_ties();
+    test_dynamics_rand();
+    test_timed_observation_threads();
+    test_batch_observation();
+    test_distributed();
     test_gens_delete_connection();
     test_gens_ordereddeleter();
 
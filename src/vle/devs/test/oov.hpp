@@ -30,8 +30,12 @@
 #include <cassert>
 #include <cmath>
 #include <memory>
+#include <vector>
 #include <vle/oov/Plugin.hpp>
 #include <vle/value/Double.hpp>
+#include <vle/value/Map.hpp>
+#include <vle/value/Null.hpp>
+#include <vle/value/Set.hpp>
 
 namespace vletest {
 inline std::string
@@ -174,6 +178,97 @@ public:
 
         ppD[id].emplace_back(time, std::move(value));
     }
+
+    virtual std::unique_ptr<vle::value::Value> checkpoint() override
+    {
+        auto state = std::make_unique<vle::value::Map>();
+
+        for (auto& elem : ppD) {
+            auto& values = state->addSet(elem.first);
+            for (auto& value : elem.second) {
+                auto& pair = values.addSet();
+                pair.addDouble(value.first);
+                pair.add(value.second ? value.second->clone()
+                                      : vle::value::Null::create());
+            }
+        }
+
+        return state;
+    }
+
+    virtual void restore(const vle::value::Value& state) override
+    {
+        ppD.clear();
+
+        for (auto& elem : state.toMap()) {
+            auto& values = ppD[elem.first];
+            for (auto& value : elem.second->toSet()) {
+                const auto& pair = value->toSet();
+                values.emplace_back(pair.getDouble(0),
+                                    pair.get(1)->isNull()
+                                      ? nullptr
+                                      : pair.get(1)->clone());
+            }
+        }
+    }
+};
+
+/**
+ * An OutputPlugin which receives the values of the timed views with
+ * onValues() and onDoubles().
+ */
+class BatchOutputPlugin : public OutputPlugin
+{
+    struct Observable
+    {
+        std::string simulator;
+        std::string parent;
+        std::string port;
+    };
+
+    std::vector<Observable> observables;
+
+public:
+    BatchOutputPlugin(const std::string& location)
+      : OutputPlugin(location)
+    {
+    }
+
+    virtual bool batch() const override
+    {
+        return true;
+    }
+
+    virtual void onNewObservable(const std::string& simulator,
+                                 const std::string& parent,
+                                 const std::string& port,
+                                 const std::string& view,
+                                 const double& time) override
+    {
+        OutputPlugin::onNewObservable(simulator, parent, port, view, time);
+
+        observables.push_back(Observable{ simulator, parent, port });
+    }
+
+    virtual void onValues(
+      const double& time,
+      const std::string& view,
+      const std::vector<std::size_t>& ids,
+      std::vector<std::unique_ptr<vle::value::Value>>& values) override
+    {
+        assert(ids.size() == values.size());
+
+        for (std::size_t i = 0, e = ids.size(); i != e; ++i) {
+            const auto& observable = observables.at(ids[i]);
+
+            onValue(observable.simulator,
+                    observable.parent,
+                    observable.port,
+                    view,
+                    time,
+                    std::move(values[i]));
+        }
+    }
 };
 
 } // namespace vletest
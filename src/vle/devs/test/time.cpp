@@ -185,6 +185,50 @@ prefix_and_postfix_operator()
     EnsuresEqual(a, 0.0);
 }
 
+void
+timebase()
+{
+    devs::TimeBase real;
+
+    Ensures(real.toKey(0.1 + 0.2) != real.toKey(0.3));
+    Ensures(real.toKey(-1.0) < real.toKey(-0.5));
+    Ensures(real.toKey(-0.5) < real.toKey(0.0));
+    Ensures(real.toKey(0.0) < real.toKey(0.5));
+    Ensures(real.toKey(0.5) < real.toKey(devs::infinity));
+    EnsuresEqual(real.toKey(-0.0), real.toKey(0.0));
+    EnsuresEqual(real.toTime(real.toKey(0.1 + 0.2)), 0.1 + 0.2);
+    EnsuresEqual(real.toTime(real.toKey(-2.5)), -2.5);
+    EnsuresEqual(real.round(0.1 + 0.2), 0.1 + 0.2);
+
+    devs::TimeBase tick(0.1);
+
+    EnsuresEqual(tick.toKey(0.1 + 0.2), 3);
+    EnsuresEqual(tick.toKey(0.1 + 0.2), tick.toKey(0.3));
+    EnsuresEqual(tick.round(0.1 + 0.2), tick.round(0.3));
+    EnsuresEqual(tick.toKey(-0.3), -3);
+    EnsuresEqual(tick.toTime(tick.toKey(devs::infinity)), devs::infinity);
+    EnsuresEqual(tick.toTime(tick.toKey(devs::negativeInfinity)),
+                 devs::negativeInfinity);
+
+    double time = 0.0;
+    for (int i = 0; i < 1000; ++i)
+        time = tick.round(time + 0.1);
+    EnsuresEqual(time, 100.0);
+
+    /* the time advances are rounded up, at least to the next tick */
+    EnsuresEqual(tick.next(0.3, 0.0), tick.round(0.3));
+    EnsuresEqual(tick.next(0.3, 0.01), tick.round(0.4));
+    EnsuresEqual(tick.next(0.3, 0.1), tick.round(0.4));
+    EnsuresEqual(tick.next(0.3, 0.11), tick.round(0.5));
+    EnsuresEqual(tick.next(0.3, devs::infinity), devs::infinity);
+    EnsuresEqual(real.next(0.3, 0.01), 0.3 + 0.01);
+
+    time = 0.0;
+    for (int i = 0; i < 1000; ++i)
+        time = tick.next(time, 0.1);
+    EnsuresEqual(time, 100.0);
+}
+
 int
 main()
 {
@@ -194,6 +238,7 @@ main()
     modify();
     modify_and_infinity();
     prefix_and_postfix_operator();
+    timebase();
 
     return unit_test::report_errors();
 }
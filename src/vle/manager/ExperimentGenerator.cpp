@@ -127,6 +127,7 @@ public:
             throw utils::InternalError(_("Bad rank"));
         }
 
+        mVpz.project().experiment().conditions().shareValues();
         computeRange();
     }
 
@@ -142,6 +143,7 @@ public:
             throw utils::InternalError(_("Bad rank"));
         }
 
+        mVpz.project().experiment().conditions().shareValues();
         computeRange();
     }
 
@@ -179,6 +181,18 @@ public:
                 cnvdst[elem.first] = std::move(cpy);
             }
         }
+
+        //
+        // Without replicate in the simulation engine condition, the index
+        // of the combination gives the replicate of the random number
+        // generators of the models (see devs::Dynamics::buildRand()).
+        //
+        const auto& engine = vpz::Experiment::defaultSimulationEngineCondName();
+        auto jt = cdldst.find(engine);
+        if (jt != cdldst.end() and
+            not cnds.get(engine).conditionvalues().count("replicate"))
+            jt->second.setValueToPort("replicate",
+                                      value::Integer::create(index));
     }
 };
 
@@ -24,18 +24,33 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <set>
 #include <sstream>
 #include <thread>
+#include <vle/devs/RootCoordinator.hpp>
 #include <vle/manager/ExperimentGenerator.hpp>
 #include <vle/manager/Manager.hpp>
 #include <vle/manager/Simulation.hpp>
 #include <vle/utils/Exception.hpp>
 #include <vle/utils/Tools.hpp>
+#include <vle/utils/Trace.hpp>
 #include <vle/utils/i18n.hpp>
+#include <vle/value/Binary.hpp>
+#include <vle/value/Map.hpp>
 #include <vle/value/Matrix.hpp>
 #include <vle/vpz/BaseModel.hpp>
 #include <vle/vpz/Vpz.hpp>
 
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 namespace vle {
 namespace manager {
 
@@ -108,6 +123,93 @@ setExperimentName(const std::unique_ptr<vpz::Vpz>& destination,
     destination->project().experiment().setName(result);
 }
 
+/**
+ * Get the names of the conditions with several values, ie. the conditions
+ * changed by the combinations of the experimental frame.
+ *
+ * @param conditions The conditions of the experimental frame.
+ */
+static std::set<std::string>
+variableConditions(const vpz::Conditions& conditions)
+{
+    std::set<std::string> result;
+
+    for (const auto& elem : conditions.conditionlist())
+        for (const auto& port : elem.second.conditionvalues())
+            if (port.second.size() > 1)
+                result.insert(elem.first);
+
+    return result;
+}
+
+#ifndef _WIN32
+/**
+ * A combination of a warm-started experimental frame: the child process
+ * and the read end of the pipe where the child writes its result.
+ */
+struct Branch
+{
+    pid_t pid;
+    int fd;
+    uint32_t index;
+};
+
+static void
+writeAll(int fd, const std::string& buffer)
+{
+    std::size_t done = 0;
+
+    while (done < buffer.size()) {
+        auto ret = ::write(fd, buffer.data() + done, buffer.size() - done);
+
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            return;
+        }
+
+        done += static_cast<std::size_t>(ret);
+    }
+}
+
+/**
+ * The body of the child process of a combination: update the conditions,
+ * finish the simulation and write into @e fd a zero byte followed by the
+ * binary outputs, or a one byte followed by the error message.
+ */
+[[noreturn]] static void
+runBranch(devs::RootCoordinator& root,
+          ExperimentGenerator& expgen,
+          const std::set<std::string>& names,
+          uint32_t index,
+          int fd)
+{
+    std::string buffer(1, '\0');
+
+    try {
+        vpz::Conditions conditions;
+        expgen.get(index, &conditions);
+        root.updateConditions(conditions, names);
+
+        {
+            vle_trace_scope("manager", "run");
+            root.run_until(devs::infinity);
+        }
+
+        auto outputs = root.finish();
+        if (outputs)
+            buffer += value::toBinary(*outputs);
+    } catch (const std::exception& e) {
+        buffer.assign(1, '\1');
+        buffer += e.what();
+    }
+
+    writeAll(fd, buffer);
+    ::close(fd);
+    ::_exit(0);
+}
+#endif
+
 class Manager::Pimpl
 {
 public:
@@ -121,6 +223,8 @@ public:
       , mOutputStream(output)
       , mLogOption(logoptions)
       , mSimulationOption(simulationoptions)
+      , mWarmStart(false)
+      , mWarmUp(0.0)
     {
         if (timeout != std::chrono::milliseconds::zero())
             mSimulationOption |= vle::manager::SIMULATION_SPAWN_PROCESS;
@@ -187,6 +291,8 @@ public:
 
         void operator()()
         {
+            vle_trace_thread("manager worker " + std::to_string(index));
+
             std::string vpzname(vpz->project().experiment().name());
 
             for (uint32_t i = expgen.min() + index; i < expgen.max();
@@ -310,11 +416,190 @@ public:
         return result;
     }
 
+#ifndef _WIN32
+    void reportError(const std::string& message, Error* error)
+    {
+        writeRunLog(message);
+
+        if (not error->code) {
+            error->code = -1;
+            error->message = message;
+        }
+    }
+
+    /**
+     * Wait the end of the child process of a combination and store its
+     * result.
+     */
+    void collect(const Branch& branch, value::Matrix* result, Error* error)
+    {
+        std::string buffer;
+        char chunk[4096];
+
+        for (;;) {
+            auto ret = ::read(branch.fd, chunk, sizeof(chunk));
+            if (ret == 0)
+                break;
+            if (ret < 0) {
+                if (errno == EINTR)
+                    continue;
+                break;
+            }
+            buffer.append(chunk, static_cast<std::size_t>(ret));
+        }
+
+        ::close(branch.fd);
+
+        int status = 0;
+        while (::waitpid(branch.pid, &status, 0) == -1 and errno == EINTR)
+            ;
+
+        if (buffer.empty()) {
+            reportError(utils::format(_("\n/!\\ error reported: combination "
+                                        "%u: process failed (status %d)\n"),
+                                      branch.index,
+                                      status),
+                        error);
+        } else if (buffer[0] != '\0') {
+            reportError(utils::format(_("\n/!\\ error reported: %s\n"),
+                                      buffer.c_str() + 1),
+                        error);
+        } else if (result and buffer.size() > 1) {
+            try {
+                result->add(
+                  branch.index, 0, value::fromBinary(buffer.substr(1)));
+            } catch (const std::exception& e) {
+                reportError(utils::format(_("\n/!\\ error reported: %s\n"),
+                                          e.what()),
+                            error);
+            }
+        }
+    }
+
+    /**
+     * Load and initialise the first combination once, run it until the
+     * warm-up date then fork() a child process by combination. At most @e
+     * processes children run at the same time.
+     */
+    std::unique_ptr<value::Matrix> runManagerWarmStart(
+      std::unique_ptr<vpz::Vpz> vpz,
+      uint32_t processes,
+      uint32_t rank,
+      uint32_t world,
+      Error* error)
+    {
+        ExperimentGenerator expgen(*vpz, rank, world);
+        std::string vpzname(vpz->project().experiment().name());
+        auto names =
+          variableConditions(vpz->project().experiment().conditions());
+        std::unique_ptr<value::Matrix> result;
+
+        error->code = 0;
+        error->message.clear();
+
+        if (mSimulationOption & manager::SIMULATION_SPAWN_PROCESS)
+            throw utils::ArgError(
+              _("Manager error: warm start can not spawn the simulations "
+                "in a process nor stop them after a timeout"));
+
+        if (not(mSimulationOption & manager::SIMULATION_NO_RETURN))
+            result = std::unique_ptr<value::Matrix>(
+              new value::Matrix(expgen.size(), 1, expgen.size(), 1));
+
+        if (expgen.min() >= expgen.max())
+            return result;
+
+        for (const auto& elem :
+             vpz->project().experiment().views().outputs().outputlist())
+            if (elem.second.plugin() != "storage")
+                throw utils::ArgError(
+                  _("Manager error: warm start needs storage outputs but "
+                    "output `%s' uses the plug-in `%s'"),
+                  elem.first.c_str(),
+                  elem.second.plugin().c_str());
+
+        // The threads of the simulation kernel are not copied by fork().
+        auto ctx = mContext->clone();
+        ctx->set_setting("vle.simulation.thread", 0l);
+
+        devs::RootCoordinator root(ctx);
+
+        try {
+            vle_trace_scope("manager", "warm up");
+
+            setExperimentName(vpz, vpzname, expgen.min());
+            expgen.get(expgen.min(),
+                       &vpz->project().experiment().conditions());
+
+            root.load(*vpz);
+            vpz->clear();
+            vpz.reset(nullptr);
+
+            root.init();
+            while (root.getNextTime() < mWarmUp and root.run())
+                ;
+        } catch (const std::exception& e) {
+            reportError(
+              utils::format(_("\n/!\\ error reported: %s\n"), e.what()),
+              error);
+            return result;
+        }
+
+        std::deque<Branch> running;
+
+        for (uint32_t i = expgen.min(); i < expgen.max(); ++i) {
+            if (running.size() >= processes) {
+                collect(running.front(), result.get(), error);
+                running.pop_front();
+            }
+
+            int fds[2];
+            if (::pipe(fds) == -1) {
+                reportError(utils::format(_("\n/!\\ error reported: pipe: "
+                                            "%s\n"),
+                                          std::strerror(errno)),
+                            error);
+                break;
+            }
+
+            if (mOutputStream)
+                mOutputStream->flush();
+            std::fflush(nullptr);
+
+            auto pid = ::fork();
+            if (pid == -1) {
+                ::close(fds[0]);
+                ::close(fds[1]);
+                reportError(utils::format(_("\n/!\\ error reported: fork: "
+                                            "%s\n"),
+                                          std::strerror(errno)),
+                            error);
+                break;
+            }
+
+            if (pid == 0) {
+                ::close(fds[0]);
+                runBranch(root, expgen, names, i, fds[1]);
+            }
+
+            ::close(fds[1]);
+            running.push_back({ pid, fds[0], i });
+        }
+
+        for (const auto& elem : running)
+            collect(elem, result.get(), error);
+
+        return result;
+    }
+#endif
+
     utils::ContextPtr mContext;
     std::chrono::milliseconds mTimeout;
     std::ostream* mOutputStream;
     LogOptions mLogOption;
     SimulationOptions mSimulationOption;
+    bool mWarmStart;
+    double mWarmUp;
 };
 
 Manager::Manager(utils::ContextPtr context,
@@ -376,7 +661,14 @@ Manager::run(std::unique_ptr<vpz::Vpz> exp,
 
     mPimpl->writeSummaryLog(_("Manager started"));
 
+#ifndef _WIN32
+    if (mPimpl->mWarmStart) {
+        result = mPimpl->runManagerWarmStart(
+          std::move(exp), thread, rank, world, error);
+    } else if (thread > 1) {
+#else
     if (thread > 1) {
+#endif
         result =
           mPimpl->runManagerThread(std::move(exp), thread, rank, world, error);
     } else {
@@ -387,5 +679,12 @@ Manager::run(std::unique_ptr<vpz::Vpz> exp,
 
     return result;
 }
+
+void
+Manager::setWarmStart(double warmup)
+{
+    mPimpl->mWarmStart = true;
+    mPimpl->mWarmUp = warmup;
+}
 }
 } // namespace vle manager
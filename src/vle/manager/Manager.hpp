@@ -95,6 +95,30 @@ public:
                                        uint32_t world,
                                        Error* error);
 
+    /**
+     * Enable the warm start of the experimental frame: the first
+     * combination is loaded and initialised once then simulated until
+     * the date @e warmup. Each combination branches from this shared
+     * state in a child process (fork(), the memory is copied on write):
+     * the conditions with several values are replaced by the values of
+     * the combination (see devs::Dynamics::updateConditions()) and the
+     * simulation continues until its end. The @e thread parameter of
+     * run() is the number of child processes at the same time.
+     *
+     * The views are shared until the branch, so only the storage plug-in
+     * is accepted. The children are not spawned processes of the vle
+     * command: run() throws utils::ArgError if a timeout or the
+     * SIMULATION_SPAWN_PROCESS option is set. The models are built once
+     * with the replicate of the first combination: their generators (see
+     * devs::Dynamics::buildRand()) continue the same streams in all the
+     * branches. On Windows, where fork() is missing, the experimental
+     * frame is run without warm start.
+     *
+     * @param warmup The date of the branch. The shared simulation does
+     * not run if @e warmup is lower or equal to the begin date.
+     */
+    void setWarmStart(double warmup);
+
 private:
     class Pimpl;
     std::unique_ptr<Pimpl> mPimpl;
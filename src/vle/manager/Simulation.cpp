@@ -27,14 +27,18 @@
 #include <boost/progress.hpp>
 #include <boost/timer.hpp>
 #include <fstream>
+#include <cstdio>
 #include <sstream>
+#include <thread>
 #include <vle/DllDefines.hpp>
 #include <vle/devs/RootCoordinator.hpp>
 #include <vle/manager/Simulation.hpp>
 #include <vle/utils/ContextPrivate.hpp>
 #include <vle/utils/Spawn.hpp>
 #include <vle/utils/Tools.hpp>
+#include <vle/utils/Trace.hpp>
 #include <vle/utils/i18n.hpp>
+#include <vle/value/Binary.hpp>
 
 namespace vle {
 namespace manager {
@@ -77,6 +81,95 @@ read_value(const utils::Path& p)
     return std::unique_ptr<value::Map>{};
 }
 
+/* Writes the checkpoints in a second thread. The encoding and the write
+ of a checkpoint overlap the next bags of the simulation, at most one
+ checkpoint is written at a time. The checkpoint is written into a
+ temporary file renamed on success, a crash during the write keeps the
+ previous checkpoint.
+ */
+class CheckpointWriter
+{
+    std::thread m_thread;
+    std::exception_ptr m_error;
+
+public:
+    CheckpointWriter() = default;
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    ~CheckpointWriter()
+    {
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    void write(const std::string& file, std::unique_ptr<value::Map> state)
+    {
+        join();
+
+        std::shared_ptr<value::Map> checkpoint(std::move(state));
+        m_thread = std::thread([this, file, checkpoint]() {
+            vle_trace_scope("manager", "checkpoint write");
+
+            try {
+                auto buffer = value::toBinary(*checkpoint);
+                auto tmp = file + ".tmp";
+
+                {
+                    std::ofstream out(tmp, std::ios::binary);
+                    out.write(buffer.data(), buffer.size());
+                    out.close();
+
+                    if (out.fail())
+                        throw utils::FileError(
+                          _("Checkpoint: fail to write '%s'"), tmp.c_str());
+                }
+
+                if (std::rename(tmp.c_str(), file.c_str()))
+                    throw utils::FileError(
+                      _("Checkpoint: fail to rename '%s'"), tmp.c_str());
+            } catch (...) {
+                m_error = std::current_exception();
+            }
+        });
+    }
+
+    /* Wait for the checkpoint in progress and throw its error. */
+    void join()
+    {
+        if (m_thread.joinable())
+            m_thread.join();
+
+        if (m_error) {
+            auto error = m_error;
+            m_error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+/* Read a checkpoint file written by the CheckpointWriter. */
+std::unique_ptr<value::Map>
+read_checkpoint(const std::string& file)
+{
+    std::ifstream ifs(file, std::ios::binary);
+    if (not ifs.is_open())
+        throw utils::FileError(_("Checkpoint: fail to open '%s'"),
+                               file.c_str());
+
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+
+    auto value = value::fromBinary(ss.str());
+    if (not value->isMap())
+        throw utils::ArgError(_("Checkpoint: '%s' is not a checkpoint"),
+                              file.c_str());
+
+    return std::unique_ptr<value::Map>(
+      static_cast<value::Map*>(value.release()));
+}
+
 class Simulation::Pimpl
 {
 public:
@@ -87,6 +180,14 @@ public:
     utils::Path m_output_file;
     LogOptions m_logoptions;
     SimulationOptions m_simulationoptions;
+    std::unique_ptr<value::Map> m_profile;
+    std::string m_checkpoint_file;
+    std::chrono::seconds m_checkpoint_interval;
+    std::chrono::steady_clock::time_point m_checkpoint_last;
+    CheckpointWriter m_checkpoint_writer;
+    std::string m_resume_file;
+    std::unique_ptr<value::Map> m_resume;
+    std::shared_ptr<devs::DistributedChannel> m_channel;
 
     Pimpl(utils::ContextPtr context,
           LogOptions logoptions,
@@ -100,6 +201,7 @@ public:
       , m_output_file(make_temp("vle-%%%%-%%%%-%%%%-%%%%.value"))
       , m_logoptions(logoptions)
       , m_simulationoptions(simulationoptionts)
+      , m_checkpoint_interval(std::chrono::seconds::zero())
     {
         if (timeout != std::chrono::milliseconds::zero())
             m_simulationoptions |= vle::manager::SIMULATION_SPAWN_PROCESS;
@@ -112,6 +214,92 @@ public:
             (*m_out) << t;
     }
 
+    bool profiling() const noexcept
+    {
+        return m_simulationoptions & SIMULATION_PROFILE;
+    }
+
+    /* Load the vpz or restore the checkpoint to resume. */
+    void load(devs::RootCoordinator& root, vpz::Vpz* vpz)
+    {
+        root.setProfile(profiling());
+        root.setCheckpoint(not m_checkpoint_file.empty());
+        root.setDistributed(m_channel);
+
+        if (m_resume) {
+            auto checkpoint = std::move(m_resume);
+            root.restore(*checkpoint);
+        } else {
+            root.load(*vpz);
+        }
+
+        m_checkpoint_last = std::chrono::steady_clock::now();
+    }
+
+    /* Copy the state of the simulation if the interval is elapsed and
+     start to write it. */
+    void checkpoint(devs::RootCoordinator& root)
+    {
+        if (m_checkpoint_file.empty())
+            return;
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - m_checkpoint_last < m_checkpoint_interval)
+            return;
+
+        m_checkpoint_last = now;
+        m_checkpoint_writer.write(m_checkpoint_file, root.checkpoint());
+    }
+
+    /* Run the simulation until the end. The bags are run one by one only
+     if a checkpoint can be written between two bags. */
+    void runAll(devs::RootCoordinator& root)
+    {
+        if (m_checkpoint_file.empty()) {
+            root.run_until(devs::infinity);
+        } else {
+            while (root.run())
+                checkpoint(root);
+        }
+    }
+
+    std::string filename(const std::unique_ptr<vpz::Vpz>& vpz) const
+    {
+        return vpz ? vpz->filename() : m_resume_file;
+    }
+
+    std::unique_ptr<value::Map> run(std::unique_ptr<vpz::Vpz> vpz,
+                                    Error* error)
+    {
+        if (m_simulationoptions & SIMULATION_SPAWN_PROCESS) {
+            if (not m_checkpoint_file.empty() or m_resume) {
+                m_resume.reset();
+                error->code = -1;
+                error->message = _("checkpoints are not available with a "
+                                   "simulation in a subprocess");
+                return {};
+            }
+
+            if (m_channel) {
+                error->code = -1;
+                error->message = _("a distributed simulation can not run "
+                                   "in a subprocess");
+                return {};
+            }
+
+            return runSubProcess(std::move(vpz), error);
+        }
+
+        if (m_logoptions != manager::LOG_NONE) {
+            if (m_logoptions & manager::LOG_RUN and m_out)
+                return runVerboseRun(std::move(vpz), error);
+
+            return runVerboseSummary(std::move(vpz), error);
+        }
+
+        return runQuiet(std::move(vpz), error);
+    }
+
     std::unique_ptr<value::Map> runVerboseRun(std::unique_ptr<vpz::Vpz> vpz,
                                               Error* error)
     {
@@ -121,19 +309,27 @@ public:
         try {
             devs::RootCoordinator root(m_context);
 
-            const double duration = vpz->project().experiment().duration();
-            const double begin = vpz->project().experiment().begin();
+            double duration, begin;
+            if (vpz) {
+                duration = vpz->project().experiment().duration();
+                begin = vpz->project().experiment().begin();
+            } else {
+                begin = m_resume->getDouble("begin");
+                duration = m_resume->getDouble("end") - begin;
+            }
 
-            write(fmt(_("[%1%]\n")) % vpz->filename());
+            write(fmt(_("[%1%]\n")) % filename(vpz));
             write(_(" - Coordinator load models ......: "));
 
-            root.load(*vpz);
+            load(root, vpz.get());
 
             write(_("ok\n"));
 
             write(_(" - Clean project file ...........: "));
-            vpz->clear();
-            vpz.reset(nullptr);
+            if (vpz) {
+                vpz->clear();
+                vpz.reset(nullptr);
+            }
             write(_("ok\n"));
 
             write(_(" - Coordinator initializing .....: "));
@@ -146,18 +342,37 @@ public:
               100, *m_out, "\n   ", "   ", "   ");
             long previous = 0;
 
-            while (root.run()) {
-                long pc = std::floor(100. * (root.getCurrentTime() - begin) /
-                                     duration);
-
-                display += pc - previous;
-                previous = pc;
+            //
+            // Without checkpoint, the kernel runs the bags of each percent
+            // of the duration before the update of the display.
+            //
+            auto next = [this, &root, &previous, begin, duration]() {
+                if (not m_checkpoint_file.empty())
+                    return root.run();
+
+                return root.run_until(begin +
+                                      duration * (previous + 1) / 100.);
+            };
+
+            {
+                vle_trace_scope("manager", "run");
+                while (next()) {
+                    long pc = std::floor(
+                      100. * (root.getCurrentTime() - begin) / duration);
+
+                    display += pc - previous;
+                    previous = pc;
+                    checkpoint(root);
+                }
+                m_checkpoint_writer.join();
             }
 
             display += 100 - previous;
 
             write(_(" - Coordinator cleaning .........: "));
             result = root.finish();
+            if (profiling())
+                m_profile = root.profile();
             write(_("ok\n"));
 
             write(fmt(_(" - Time spent in kernel .........: %1% s")) %
@@ -183,16 +398,18 @@ public:
         try {
             devs::RootCoordinator root(m_context);
 
-            write(fmt(_("[%1%]\n")) % vpz->filename());
+            write(fmt(_("[%1%]\n")) % filename(vpz));
             write(_(" - Coordinator load models ......: "));
 
-            root.load(*vpz);
+            load(root, vpz.get());
 
             write(_("ok\n"));
 
             write(_(" - Clean project file ...........: "));
-            vpz->clear();
-            vpz.reset(nullptr);
+            if (vpz) {
+                vpz->clear();
+                vpz.reset(nullptr);
+            }
             write(_("ok\n"));
 
             write(_(" - Coordinator initializing .....: "));
@@ -201,12 +418,17 @@ public:
 
             write(_(" - Simulation run................: "));
 
-            while (root.run())
-                ;
+            {
+                vle_trace_scope("manager", "run");
+                runAll(root);
+                m_checkpoint_writer.join();
+            }
             write(_("ok\n"));
 
             write(_(" - Coordinator cleaning .........: "));
             result = root.finish();
+            if (profiling())
+                m_profile = root.profile();
             write(_("ok\n"));
 
             write(fmt(_(" - Time spent in kernel .........: %1% s")) %
@@ -230,14 +452,21 @@ public:
         try {
             devs::RootCoordinator root(m_context);
 
-            root.load(*vpz);
-            vpz->clear();
-            vpz.reset(nullptr);
+            load(root, vpz.get());
+            if (vpz) {
+                vpz->clear();
+                vpz.reset(nullptr);
+            }
 
             root.init();
-            while (root.run()) {
+            {
+                vle_trace_scope("manager", "run");
+                runAll(root);
+                m_checkpoint_writer.join();
             }
             result = root.finish();
+            if (profiling())
+                m_profile = root.profile();
 
             error->code = 0;
         } catch (const std::exception& e) {
@@ -372,22 +601,12 @@ Simulation::~Simulation() = default;
 std::unique_ptr<value::Map>
 Simulation::run(std::unique_ptr<vpz::Vpz> vpz, Error* error)
 {
+    vle_trace_scope("manager", "simulation");
+
     error->code = 0;
-    std::unique_ptr<value::Map> result;
+    mPimpl->m_profile.reset();
 
-    if (mPimpl->m_simulationoptions & SIMULATION_SPAWN_PROCESS) {
-        result = mPimpl->runSubProcess(std::move(vpz), error);
-    } else {
-        if (mPimpl->m_logoptions != manager::LOG_NONE) {
-            if (mPimpl->m_logoptions & manager::LOG_RUN and mPimpl->m_out) {
-                result = mPimpl->runVerboseRun(std::move(vpz), error);
-            } else {
-                result = mPimpl->runVerboseSummary(std::move(vpz), error);
-            }
-        } else {
-            result = mPimpl->runQuiet(std::move(vpz), error);
-        }
-    }
+    auto result = mPimpl->run(std::move(vpz), error);
 
     if (mPimpl->m_simulationoptions & manager::SIMULATION_NO_RETURN) {
         return {};
@@ -395,5 +614,50 @@ Simulation::run(std::unique_ptr<vpz::Vpz> vpz, Error* error)
         return result;
     }
 }
+
+std::unique_ptr<value::Map>
+Simulation::profile()
+{
+    return std::move(mPimpl->m_profile);
+}
+
+void
+Simulation::setCheckpoint(const std::string& file,
+                          std::chrono::seconds interval)
+{
+    mPimpl->m_checkpoint_file = file;
+    mPimpl->m_checkpoint_interval = interval;
+}
+
+void
+Simulation::setDistributed(std::shared_ptr<devs::DistributedChannel> channel)
+{
+    mPimpl->m_channel = std::move(channel);
+}
+
+std::unique_ptr<value::Map>
+Simulation::resume(const std::string& file, Error* error)
+{
+    vle_trace_scope("manager", "resume");
+
+    error->code = 0;
+    mPimpl->m_profile.reset();
+
+    try {
+        mPimpl->m_resume = read_checkpoint(file);
+        mPimpl->m_resume_file = file;
+    } catch (const std::exception& e) {
+        error->code = -1;
+        error->message = e.what();
+        return {};
+    }
+
+    auto result = mPimpl->run(nullptr, error);
+
+    if (mPimpl->m_simulationoptions & manager::SIMULATION_NO_RETURN)
+        return {};
+
+    return result;
+}
 }
 }
@@ -29,6 +29,7 @@
 
 #include <chrono>
 #include <vle/DllDefines.hpp>
+#include <vle/devs/Distributed.hpp>
 #include <vle/manager/Types.hpp>
 #include <vle/utils/Context.hpp>
 #include <vle/vpz/Vpz.hpp>
@@ -65,6 +66,65 @@ public:
     std::unique_ptr<value::Map> run(std::unique_ptr<vpz::Vpz> vpz,
                                     Error* error);
 
+    /**
+     * Get the report of the profiler of the last run (see the
+     * SIMULATION_PROFILE option): a \c value::Map with a "kernel" map
+     * (number of bags, histogram of the bag sizes, scheduler and dispatch
+     * counters, time in seconds of each phase of the Coordinator) and a
+     * "models" map indexed by the complete name of the atomic models
+     * (number of calls and time in seconds of the output, internal,
+     * external, confluent and time-advance functions).
+     *
+     * @return nullptr if the profiler is not enabled, if the simulation
+     * fails or runs in a subprocess.
+     */
+    std::unique_ptr<value::Map> profile();
+
+    /**
+     * Write checkpoints of the next simulations into a file. A checkpoint
+     * is a copy of the state of the kernel (see
+     * devs::RootCoordinator::checkpoint()) taken between two bags and
+     * written in the value::toBinary format by a second thread: the
+     * simulation only pauses during the copy. The file is replaced
+     * atomically, one write at a time.
+     *
+     * All the atomic models must implement the devs::Dynamics::checkpoint
+     * and restore functions. Checkpoints are not available when the
+     * simulation runs in a subprocess.
+     *
+     * @param file The checkpoint file, an empty string disables the
+     * checkpoints.
+     * @param interval The wall-clock time between two checkpoints. Zero
+     * writes a checkpoint after each bag.
+     */
+    void setCheckpoint(const std::string& file,
+                       std::chrono::seconds interval);
+
+    /**
+     * Distribute the next simulations over the processes of @e channel:
+     * each process simulates some sub-models of the top coupled model
+     * (see devs::Coordinator::setDistributed()). All the processes call
+     * run() with the same vpz::Vpz, only the process 0 returns the
+     * results. Executives, checkpoints and subprocesses are not available
+     * in a distributed simulation.
+     *
+     * @param channel The processes, nullptr to simulate the whole model in
+     * this process.
+     */
+    void setDistributed(std::shared_ptr<devs::DistributedChannel> channel);
+
+    /**
+     * Continue the simulation stored into a checkpoint file written by a
+     * previous run(). The options, the log and the checkpoints of this
+     * Simulation are used.
+     *
+     * @param file The checkpoint file.
+     * @param error An output parameter to store error.
+     * @return The results of the simulation, as run().
+     */
+    std::unique_ptr<value::Map> resume(const std::string& file,
+                                       Error* error);
+
 private:
     class Pimpl;
     std::unique_ptr<Pimpl> mPimpl;
@@ -103,7 +103,9 @@ enum SimulationOptions
     SIMULATION_NONE = 0,               /**< Default option. */
     SIMULATION_SPAWN_PROCESS = 1 << 0, /**< Launch the simulation in a
                                            * subprocess.  */
-    SIMULATION_NO_RETURN = 1 << 1      /**< The simulation result are empty. */
+    SIMULATION_NO_RETURN = 1 << 1,     /**< The simulation result are empty. */
+    SIMULATION_PROFILE = 1 << 2        /**< Record the profile of the kernel
+                                           * (ignored in subprocess). */
 };
 
 inline LogOptions
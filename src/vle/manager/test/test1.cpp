@@ -24,12 +24,18 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "../../devs/test/oov.hpp"
 #include <boost/lexical_cast.hpp>
+#include <chrono>
 #include <iostream>
 #include <stdexcept>
+#include <vle/devs/Dynamics.hpp>
 #include <vle/manager/ExperimentGenerator.hpp>
 #include <vle/manager/Manager.hpp>
+#include <vle/utils/Context.hpp>
+#include <vle/utils/Exception.hpp>
 #include <vle/utils/unit-test.hpp>
+#include <vle/value/Binary.hpp>
 #include <vle/value/Boolean.hpp>
 #include <vle/value/Double.hpp>
 #include <vle/value/Integer.hpp>
@@ -50,6 +56,106 @@
 
 using namespace vle;
 
+/* A ramp of slope step, the step may be changed by updateConditions. */
+class Ramp : public devs::Dynamics
+{
+public:
+    Ramp(const devs::DynamicsInit& init, const devs::InitEventList& events)
+      : devs::Dynamics(init, events)
+      , m_value(0)
+      , m_step(events.getInt("step"))
+    {
+    }
+
+    virtual devs::Time init(devs::Time /* time */) override
+    {
+        m_value = 0;
+        return 1.0;
+    }
+
+    virtual devs::Time timeAdvance() const override
+    {
+        return 1.0;
+    }
+
+    virtual void internalTransition(devs::Time /* time */) override
+    {
+        m_value += m_step;
+    }
+
+    virtual std::unique_ptr<value::Value> observation(
+      const devs::ObservationEvent& /* event */) const override
+    {
+        return value::Integer::create(m_value);
+    }
+
+    virtual void updateConditions(const devs::InitEventList& events,
+                                  devs::Time /* time */) override
+    {
+        m_step = events.getInt("step");
+    }
+
+private:
+    long m_value;
+    long m_step;
+};
+
+/* A ramp which does not implement updateConditions. */
+class FrozenRamp : public Ramp
+{
+public:
+    FrozenRamp(const devs::DynamicsInit& init,
+               const devs::InitEventList& events)
+      : Ramp(init, events)
+    {
+    }
+
+    virtual void updateConditions(const devs::InitEventList& events,
+                                  devs::Time time) override
+    {
+        devs::Dynamics::updateConditions(events, time);
+    }
+};
+
+/* A storage plug-in: the matrix of the values is the simulation result. */
+class Storage : public vletest::OutputPlugin
+{
+public:
+    Storage(const std::string& location)
+      : vletest::OutputPlugin(location)
+    {
+    }
+
+    virtual std::unique_ptr<value::Matrix> finish(
+      const double& /* time */) override
+    {
+        return matrix();
+    }
+};
+
+extern "C" {
+VLE_MODULE vle::devs::Dynamics*
+manager_ramp(const vle::devs::DynamicsInit& init,
+             const vle::devs::InitEventList& events)
+{
+    return new Ramp(init, events);
+}
+
+VLE_MODULE vle::devs::Dynamics*
+manager_frozen_ramp(const vle::devs::DynamicsInit& init,
+                    const vle::devs::InitEventList& events)
+{
+    return new FrozenRamp(init, events);
+}
+
+/* The warm start accepts only the storage plug-in. */
+VLE_MODULE vle::oov::Plugin*
+storage(const std::string& location)
+{
+    return new Storage(location);
+}
+}
+
 const char* xml = "<?xml version=\"1.0\"?>\n"
                   "<vle_project version=\"0.5\" author=\"Gauthier Quesnel\""
                   " date=\"Mon, 12 Feb 2007 23:40:31 +0100\" >\n"
@@ -186,6 +292,20 @@ experimentgenerator_greater_than_exp()
     manager::ExperimentGenerator expgen5(vpz, 4, 5);
     EnsuresEqual(expgen5.min(), expgen5.max());
     EnsuresEqual(expgen5.size(), 3);
+
+    /* the index of the combination is the replicate of the models */
+    vpz::Experiment experiment;
+    for (uint32_t i = 0; i != 3; ++i) {
+        expgen1.get(i, &experiment.conditions());
+        EnsuresEqual(experiment.replicate(), i);
+    }
+
+    project.experiment().setSeed(42);
+    project.experiment().setReplicate(7);
+    manager::ExperimentGenerator expgen6(vpz, 0, 1);
+    expgen6.get(2, &experiment.conditions());
+    EnsuresEqual(experiment.seed(), 42u);
+    EnsuresEqual(experiment.replicate(), 7u);
 }
 
 void
@@ -223,6 +343,133 @@ experimentgenerator_max_1_max_1()
     EnsuresEqual(expgen1.size(), 7);
 }
 
+const char* xml_ramp =
+  "<?xml version=\"1.0\"?>\n"
+  "<vle_project version=\"2.0\" author=\"Gauthier Quesnel\""
+  " date=\"Mon, 12 Feb 2007 23:40:31 +0100\" >\n"
+  " <structures>\n"
+  "  <model name=\"top\" type=\"coupled\" >\n"
+  "   <submodels>\n"
+  "    <model name=\"ramp\" type=\"atomic\" dynamics=\"ramp\""
+  " conditions=\"cond\" observables=\"obs\" />\n"
+  "   </submodels>\n"
+  "   <connections />\n"
+  "  </model>\n"
+  " </structures>\n"
+  " <dynamics>\n"
+  "  <dynamic name=\"ramp\" package=\"\" library=\"manager_ramp\" />\n"
+  " </dynamics>\n"
+  " <experiment name=\"warmstart\" seed=\"123\" >\n"
+  "  <conditions>\n"
+  "   <condition name=\"simulation_engine\" >\n"
+  "    <port name=\"begin\" ><double>0</double></port>\n"
+  "    <port name=\"duration\" ><double>20</double></port>\n"
+  "   </condition>\n"
+  "   <condition name=\"cond\" >\n"
+  "    <port name=\"step\" >\n"
+  "     <integer>1</integer><integer>2</integer><integer>3</integer>\n"
+  "    </port>\n"
+  "   </condition>\n"
+  "  </conditions>\n"
+  "  <views>\n"
+  "   <outputs>\n"
+  "    <output name=\"o\" location=\"\" format=\"local\" package=\"\""
+  " plugin=\"storage\" />\n"
+  "   </outputs>\n"
+  "   <observables>\n"
+  "    <observable name=\"obs\" >\n"
+  "     <port name=\"value\" ><attachedview name=\"view\" /></port>\n"
+  "    </observable>\n"
+  "   </observables>\n"
+  "   <view name=\"view\" output=\"o\" type=\"timed\" timestep=\"1\" />\n"
+  "  </views>\n"
+  " </experiment>\n"
+  "</vle_project>\n";
+
+std::unique_ptr<value::Matrix>
+run_ramp(utils::ContextPtr ctx,
+         const std::string& xml,
+         bool warmstart,
+         double warmup,
+         manager::Error* error)
+{
+    auto vpz = std::make_unique<vpz::Vpz>();
+    vpz->parseMemory(xml);
+
+    manager::Manager man(
+      ctx, manager::LOG_NONE, manager::SIMULATION_NONE, nullptr);
+
+    if (warmstart)
+        man.setWarmStart(warmup);
+
+    return man.run(std::move(vpz), warmstart ? 2 : 1, 0, 1, error);
+}
+
+void
+manager_warm_start()
+{
+    auto ctx = utils::make_context();
+    manager::Error error;
+
+    auto mono = run_ramp(ctx, xml_ramp, false, 0.0, &error);
+    EnsuresEqual(error.code, 0);
+    Ensures(mono);
+    EnsuresEqual(mono->columns(), 3);
+
+    for (std::size_t i = 0; i != 3; ++i)
+        Ensures((*mono)(i, 0));
+
+#ifndef _WIN32
+    /* branched before the first bag: same results as the plain run */
+    auto warm = run_ramp(ctx, xml_ramp, true, 0.0, &error);
+    EnsuresEqual(error.code, 0);
+    Ensures(warm);
+    EnsuresEqual(warm->columns(), 3);
+
+    for (std::size_t i = 0; i != 3; ++i) {
+        Ensures((*warm)(i, 0));
+        if ((*warm)(i, 0) and (*mono)(i, 0))
+            EnsuresEqual(value::toBinary(*(*warm)(i, 0)),
+                         value::toBinary(*(*mono)(i, 0)));
+    }
+
+    /* branched at 5: the first combination is unchanged, the others
+     * share the first five steps of the first combination */
+    warm = run_ramp(ctx, xml_ramp, true, 5.0, &error);
+    EnsuresEqual(error.code, 0);
+    Ensures(warm);
+    EnsuresEqual(value::toBinary(*(*warm)(0, 0)),
+                 value::toBinary(*(*mono)(0, 0)));
+    Ensures(value::toBinary(*(*warm)(2, 0)) !=
+            value::toBinary(*(*mono)(2, 0)));
+
+    /* a model without updateConditions fails each branch */
+    std::string frozen(xml_ramp);
+    auto pos = frozen.find("manager_ramp");
+    frozen.replace(pos, 12, "manager_frozen_ramp");
+
+    run_ramp(ctx, frozen, true, 5.0, &error);
+    EnsuresNotEqual(error.code, 0);
+    Ensures(not error.message.empty());
+
+    /* a timeout needs spawned simulations, refused by the warm start */
+    {
+        auto vpz = std::make_unique<vpz::Vpz>();
+        vpz->parseMemory(xml_ramp);
+
+        manager::Manager man(ctx,
+                             manager::LOG_NONE,
+                             manager::SIMULATION_NONE,
+                             std::chrono::milliseconds(1000),
+                             nullptr);
+        man.setWarmStart(5.0);
+
+        EnsuresThrow(man.run(std::move(vpz), 1, 0, 1, &error),
+                     utils::ArgError);
+    }
+#endif
+}
+
 int
 main()
 {
@@ -231,6 +478,7 @@ main()
     experimentgenerator_lower_than_exp();
     experimentgenerator_greater_than_exp();
     experimentgenerator_max_1_max_1();
+    manager_warm_start();
 
     return unit_test::report_errors();
 }
@@ -25,8 +25,24 @@
  */
 
 #include <vle/oov/Plugin.hpp>
+#include <vle/value/Double.hpp>
 
 namespace vle {
 namespace oov {
+
+void
+Plugin::onDoubles(const double& time,
+                  const std::string& view,
+                  const std::vector<std::size_t>& observables,
+                  const std::vector<double>& values)
+{
+    std::vector<std::unique_ptr<value::Value>> result;
+    result.reserve(values.size());
+
+    for (auto elem : values)
+        result.emplace_back(value::Double::create(elem));
+
+    onValues(time, view, observables, result);
+}
 }
 } // namespace vle oov
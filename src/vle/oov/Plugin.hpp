@@ -29,7 +29,9 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 #include <vle/DllDefines.hpp>
+#include <vle/utils/Memory.hpp>
 #include <vle/utils/Types.hpp>
 #include <vle/value/Matrix.hpp>
 #include <vle/vle.hpp>
@@ -76,6 +78,7 @@ namespace oov {
  * @endcode
  */
 class VLE_API Plugin
+  : public utils::MemoryTagged<utils::MemoryTag::output>
 {
 public:
     /**
@@ -176,6 +179,42 @@ public:
                          const double& time,
                          std::unique_ptr<value::Value> value) = 0;
 
+    /**
+     * By default, a plugin receives the values of the timed views one by
+     * one with onValue().
+     *
+     * @return true to receive the values of a timed view at a date with
+     * one call to onValues() or onDoubles().
+     */
+    virtual bool batch() const
+    {
+        return false;
+    }
+
+    /**
+     * Call, if batch() returns true, with all the values of a timed view
+     * at @e time. The observables are numbered from 0 in the order of the
+     * onNewObservable() calls: @e values[i] is the value of the observable
+     * @e observables[i]. The values can be moved.
+     */
+    virtual void onValues(
+      const double& /*time*/,
+      const std::string& /*view*/,
+      const std::vector<std::size_t>& /*observables*/,
+      std::vector<std::unique_ptr<value::Value>>& /*values*/)
+    {
+    }
+
+    /**
+     * Call, if batch() returns true, instead of onValues() when all the
+     * values are value::Double. The default implementation builds the
+     * value::Double and calls onValues().
+     */
+    virtual void onDoubles(const double& time,
+                           const std::string& view,
+                           const std::vector<std::size_t>& observables,
+                           const std::vector<double>& values);
+
     /**
      * Call when the simulation is finished.
      * Return a pointer to the Matrix built during simulation, or NULL.
@@ -185,6 +224,27 @@ public:
         return {};
     }
 
+    /**
+     * Call when a checkpoint of the simulation is written, after the
+     * onParameter, onNewObservable and onValue of the previous bags.
+     * Return a copy of the data the plug-in needs to continue the
+     * observations (the position in the output file, the values already
+     * stored, etc.) or NULL if the plug-in has no such data.
+     */
+    virtual std::unique_ptr<value::Value> checkpoint()
+    {
+        return {};
+    }
+
+    /**
+     * Call when a simulation restarts from a checkpoint, after the
+     * onParameter and onNewObservable of the restored models, with the
+     * value built by checkpoint().
+     */
+    virtual void restore(const value::Value& /*state*/)
+    {
+    }
+
     ///
     ////
     ///
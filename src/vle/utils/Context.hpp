@@ -274,7 +274,14 @@ public:
      * - "vle_make_new_dynamics" (MODULE_DYNAMICS).
      * - "vle_make_new_dynamics_wrapper" (MODULE_DYNAMICS).
      * - "vle_make_new_executive" (MODULE_DYNAMICS).
-     * - "vle_make_new_oov" (MODULE_OOV). *
+     * - "vle_make_new_oov" (MODULE_OOV).
+     *
+     * The ModuleManager is shared by all the contexts of the process and
+     * protected by a mutex: a shared library is opened and its symbol is
+     * resolved once for all the simulations. The path of the shared
+     * libraries found in the binary packages repositories is cached in the
+     * file `vle-x.y.modules' of the VLE home directory.
+     *
      * @code
      * vle::utils::ModuleManager mng;
      * void* mng.get("foo", "sim", vle::utils::MODULE_DYNAMICS);
@@ -397,8 +404,11 @@ public:
     /**
      * \e Brief Unload of loaded shared libraries.
      *
-     * Unload (via \c ::dlclose or \c ::FreeLibrary) all previously loaded
-     * shared libraries.
+     * Release the shared libraries loaded by this context (and its clones
+     * sharing them). A shared library is unloaded (via \c ::dlclose or \c
+     * ::FreeLibrary) when no other context of the process uses it: no
+     * simulation of this context must be running. The destructor of the
+     * context releases them too.
      */
     void unload_dynamic_libraries() noexcept;
 
@@ -25,11 +25,16 @@
  */
 
 #include <boost/version.hpp>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
 #include <unordered_map>
 #include <vle/utils/Algo.hpp>
 #include <vle/utils/ContextPrivate.hpp>
 #include <vle/utils/Exception.hpp>
 #include <vle/utils/Filesystem.hpp>
+#include <vle/utils/Tools.hpp>
 #include <vle/utils/i18n.hpp>
 #include <vle/vle.hpp>
 
@@ -90,6 +95,9 @@ struct Module
     void* mFunction;
     Context::ModuleType mType;
 
+    /** Number of ModuleReferences which resolved this module. */
+    std::size_t mReferences;
+
     /**
      * @brief A Module store shared library and symbol.
      *
@@ -112,6 +120,7 @@ struct Module
       , mHandle(nullptr)
       , mFunction(nullptr)
       , mType(type)
+      , mReferences(0)
     {
     }
 
@@ -358,6 +367,280 @@ public:
     }
 };
 
+/**
+ * @brief Get the name of the plug-in directory of a type of module.
+ *
+ * @param type The type of the module.
+ * @return "simulator" or "output".
+ */
+static const char*
+getModuleKind(Context::ModuleType type)
+{
+    switch (type) {
+    case Context::ModuleType::MODULE_DYNAMICS:
+    case Context::ModuleType::MODULE_DYNAMICS_EXECUTIVE:
+    case Context::ModuleType::MODULE_DYNAMICS_WRAPPER:
+        return "simulator";
+    case Context::ModuleType::MODULE_OOV:
+        return "output";
+    default:
+        break;
+    }
+
+    throw utils::InternalError(_("Missing type"));
+}
+
+/**
+ * @brief Build the path of the shared library of a module in a binary
+ * package repository.
+ */
+static Path
+getModuleFilename(const Path& repository,
+                  const std::string& package,
+                  const std::string& library,
+                  const char* kind)
+{
+    Path current = repository / package;
+    current /= "plugins";
+    current /= kind;
+
+#if defined(_WIN32)
+    current /= "lib" + library + ".dll";
+#elif defined(__APPLE__)
+    current /= "lib" + library + ".dylib";
+#else
+    current /= "lib" + library + ".so";
+#endif
+
+    return current;
+}
+
+/**
+ * @brief The on-disk cache of the shared libraries found in the binary
+ * package repositories of a VLE home directory. For each kind, package and
+ * library, the manifest stores the path, the modification time and the
+ * size of the shared library so that a new process does not need to probe
+ * the repositories again.
+ *
+ * All entries are dropped if the binary package repositories change (a
+ * package is installed or removed). An entry is dropped if its shared
+ * library is modified or removed. Remove the file to force a new probe.
+ */
+struct ModuleManifest
+{
+    struct Entry
+    {
+        std::string mPath;
+        std::int64_t mTime;
+        std::uint64_t mSize;
+    };
+
+    using Repository = std::pair<std::string, std::int64_t>;
+
+    Path mFile;
+    std::vector<Repository> mRepositories;
+    std::unordered_map<std::string, Entry> mEntries;
+
+    ModuleManifest(Context* ctx)
+    {
+        auto version = vle::version_abi();
+
+        mFile = ctx->getHomeFile(utils::format(
+          "vle-%d.%d.modules", std::get<0>(version), std::get<1>(version)));
+
+        for (const auto& elem : ctx->getBinaryPackagesDir())
+            mRepositories.emplace_back(
+              elem.string(), elem.is_directory() ? elem.last_write_time() : -1);
+
+        if (not read())
+            mEntries.clear();
+    }
+
+    static std::string key(const char* kind,
+                           const std::string& package,
+                           const std::string& library)
+    {
+        std::string ret(kind);
+        ret += ' ';
+        ret += package;
+        ret += ' ';
+        ret += library;
+
+        return ret;
+    }
+
+    /**
+     * @brief Read the manifest file.
+     *
+     * @return false if the file is corrupted or out of date.
+     */
+    bool read()
+    {
+        std::ifstream ifs(mFile.string());
+        if (not ifs.is_open())
+            return true;
+
+        std::string line;
+        if (not std::getline(ifs, line) or line != "vle-modules 1")
+            return false;
+
+        std::size_t repository = 0;
+        while (std::getline(ifs, line)) {
+            std::istringstream iss(line);
+            std::string tag;
+
+            if (not(iss >> tag))
+                return false;
+
+            if (tag == "repository") {
+                Repository current;
+
+                if (not(iss >> current.second) or iss.get() != ' ' or
+                    not std::getline(iss, current.first))
+                    return false;
+
+                if (repository >= mRepositories.size() or
+                    mRepositories[repository] != current)
+                    return false;
+
+                ++repository;
+            } else if (tag == "module") {
+                std::string kind, package, library;
+                Entry entry;
+
+                if (not(iss >> kind >> package >> library >> entry.mTime >>
+                        entry.mSize) or
+                    iss.get() != ' ' or not std::getline(iss, entry.mPath))
+                    return false;
+
+                mEntries.emplace(key(kind.c_str(), package, library),
+                                 std::move(entry));
+            } else {
+                return false;
+            }
+        }
+
+        return repository == mRepositories.size();
+    }
+
+    /**
+     * @brief Write the manifest into a temporary file then rename it, a
+     * concurrent process reads the previous or the new manifest.
+     */
+    void write(Context* ctx) const
+    {
+        Path tmp = Path::unique_path(mFile.string() + "-%%%%-%%%%");
+
+        {
+            std::ofstream ofs(tmp.string());
+            if (not ofs.is_open())
+                return;
+
+            ofs << "vle-modules 1\n";
+            for (const auto& elem : mRepositories)
+                ofs << "repository " << elem.second << ' ' << elem.first
+                    << '\n';
+
+            for (const auto& elem : mEntries)
+                ofs << "module " << elem.first << ' ' << elem.second.mTime
+                    << ' ' << elem.second.mSize << ' ' << elem.second.mPath
+                    << '\n';
+
+            if (not ofs.good()) {
+                ofs.close();
+                tmp.remove();
+                return;
+            }
+        }
+
+#ifdef _WIN32
+        std::remove(mFile.string().c_str());
+#endif
+
+        if (std::rename(tmp.string().c_str(), mFile.string().c_str())) {
+            vDbg(ctx,
+                 _("ModuleManager: fail to write manifest %s\n"),
+                 mFile.string().c_str());
+            tmp.remove();
+        }
+    }
+
+    /**
+     * @brief Get the path of a shared library from the manifest.
+     *
+     * @return An empty path if the manifest does not know the library, if
+     * the shared library was modified or if a repository searched before
+     * the one of the entry now provides the library.
+     */
+    Path find(const char* kind,
+              const std::string& package,
+              const std::string& library)
+    {
+        auto it = mEntries.find(key(kind, package, library));
+        if (it == mEntries.end())
+            return {};
+
+        Path path(it->second.mPath);
+
+        try {
+            if (path.last_write_time() == it->second.mTime and
+                path.file_size() == it->second.mSize) {
+                for (const auto& elem : mRepositories) {
+                    Path current =
+                      getModuleFilename(elem.first, package, library, kind);
+
+                    if (current == path)
+                        return path;
+
+                    if (current.is_file())
+                        break;
+                }
+            }
+        } catch (const FileError&) {
+        }
+
+        mEntries.erase(it);
+        return {};
+    }
+
+    void add(const char* kind,
+             const std::string& package,
+             const std::string& library,
+             const Path& path)
+    {
+        try {
+            mEntries[key(kind, package, library)] = {
+                path.string(), path.last_write_time(), path.file_size()
+            };
+        } catch (const FileError&) {
+        }
+    }
+};
+
+/**
+ * @brief The modules resolved by a context and its clones. Each module
+ * counts the ModuleReferences which resolved it and its shared library is
+ * unloaded when the last of them is destroyed.
+ */
+struct ModuleReferences
+{
+    /** Modules already resolved from (home, prefix, kind, package,
+     * library). */
+    std::unordered_map<std::string, Module*> mResolved;
+
+    ModuleReferences() = default;
+    ModuleReferences(const ModuleReferences&) = delete;
+    ModuleReferences& operator=(const ModuleReferences&) = delete;
+
+    ~ModuleReferences() noexcept;
+};
+
+/**
+ * @brief The process-wide registry of modules. Each shared library is
+ * opened once and its symbol is resolved once, then all contexts (and so
+ * all simulations) of the process share them. All functions lock the
+ * registry and can be called from several threads.
+ */
 struct ModuleManager
 {
     using ModuleTable =
@@ -366,49 +649,25 @@ struct ModuleManager
     using const_iterator = ModuleTable::const_iterator;
     using iterator = ModuleTable::iterator;
 
-    Context* mContext;
     ModuleTable mTableSimulator;
     ModuleTable mTableOov;
     SymbolTable mTableSymbols;
 
-    ModuleManager(Context* ctx)
-      : mContext(ctx)
-    {
-        assert(ctx);
-    }
+    /** Manifests of the (home, prefix) directories. */
+    std::unordered_map<std::string, std::unique_ptr<ModuleManifest>>
+      mManifests;
+
+    std::mutex mMutex;
 
-    ~ModuleManager() noexcept
+    ModuleManager() = default;
+    ModuleManager(const ModuleManager&) = delete;
+    ModuleManager& operator=(const ModuleManager&) = delete;
+
+    static ModuleManager& instance()
     {
-        if (mContext)
-            return;
-
-        for (const auto& elem : mTableSimulator)
-            if (elem.second) {
-                vDbg(mContext,
-                     _("ModuleManager: simulator unload %s (%s %s %s)\n"),
-                     elem.first.c_str(),
-                     elem.second->mPath.string().c_str(),
-                     elem.second->mPackage.c_str(),
-                     elem.second->mLibrary.c_str());
-            } else {
-                vDbg(mContext,
-                     _("ModuleManager: simulator unload %s (not loaded)\n"),
-                     elem.first.c_str());
-            }
+        static ModuleManager manager;
 
-        for (const auto& elem : mTableOov)
-            if (elem.second) {
-                vDbg(mContext,
-                     _("ModuleManager: output unload %s (%s %s %s)\n"),
-                     elem.first.c_str(),
-                     elem.second->mPath.string().c_str(),
-                     elem.second->mPackage.c_str(),
-                     elem.second->mLibrary.c_str());
-            } else {
-                vDbg(mContext,
-                     _("ModuleManager: output unload %s (not loaded)\n"),
-                     elem.first.c_str());
-            }
+        return manager;
     }
 
     /**
@@ -443,52 +702,81 @@ struct ModuleManager
         }
     };
 
-    bool exists(const std::string& filepath) const
+    /**
+     * @brief Get the symbol of a module and its type. The caller must lock
+     * the registry.
+     */
+    void* getSymbol(Context* ctx,
+                    ModuleReferences& references,
+                    const std::string& package,
+                    const std::string& library,
+                    Context::ModuleType type,
+                    Context::ModuleType* newtype)
     {
-        auto it = mTableSimulator.find(filepath);
-        if (it != mTableSimulator.cend())
-            return true;
+        auto& module = getModule(ctx, references, package, library, type);
+        auto* result = module.get();
 
-        return mTableOov.find(filepath) != mTableOov.cend();
+        if (newtype)
+            *newtype = module.mType;
+
+        return result;
     }
 
-    const std::unique_ptr<Module>& getModule(const std::string& package,
-                                             const std::string& library,
-                                             Context::ModuleType type)
+    Module& getModule(Context* ctx,
+                      ModuleReferences& references,
+                      const std::string& package,
+                      const std::string& library,
+                      Context::ModuleType type)
     {
-        Path path = buildModuleFilename(package, library, type);
-        std::string strpath = path.string();
+        const char* kind = getModuleKind(type);
 
-        iterator it;
+        std::string key = ctx->getHomeDir().string();
+        key += '\n';
+        key += ctx->getPrefixDir().string();
+        key += '\n';
+        key += ModuleManifest::key(kind, package, library);
 
-        switch (type) {
-        case Context::ModuleType::MODULE_DYNAMICS:
-        case Context::ModuleType::MODULE_DYNAMICS_WRAPPER:
-        case Context::ModuleType::MODULE_DYNAMICS_EXECUTIVE:
-            it = mTableSimulator.find(strpath);
-            if (it != mTableSimulator.end())
-                return it->second;
-
-            return mTableSimulator
-              .emplace(strpath,
-                       std::make_unique<Module>(path, package, library, type))
-              .first->second;
-            break;
-        case Context::ModuleType::MODULE_OOV:
-            it = mTableOov.find(strpath);
-            if (it != mTableOov.end())
-                return it->second;
-
-            return mTableOov
-              .emplace(strpath,
-                       std::make_unique<Module>(path, package, library, type))
-              .first->second;
-            break;
-        default:
-            break;
+        auto found = references.mResolved.find(key);
+        if (found != references.mResolved.end())
+            return *found->second;
+
+        auto& manifest = getManifest(ctx);
+        Path path = manifest.find(kind, package, library);
+
+        if (path.empty()) {
+            path = buildModuleFilename(ctx, package, library, type);
+            manifest.add(kind, package, library, path);
+            manifest.write(ctx);
         }
 
-        throw utils::InternalError(_("Missing type"));
+        auto& table = type == Context::ModuleType::MODULE_OOV
+                        ? mTableOov
+                        : mTableSimulator;
+
+        std::string strpath = path.string();
+        auto it = table.find(strpath);
+        if (it == table.end())
+            it = table
+                   .emplace(strpath,
+                            std::make_unique<Module>(
+                              path, package, library, type))
+                   .first;
+
+        ++it->second->mReferences;
+        references.mResolved.emplace(std::move(key), it->second.get());
+
+        return *it->second;
+    }
+
+    ModuleManifest& getManifest(Context* ctx)
+    {
+        auto& manifest = mManifests[ctx->getHomeDir().string() + '\n' +
+                                    ctx->getPrefixDir().string()];
+
+        if (not manifest)
+            manifest = std::make_unique<ModuleManifest>(ctx);
+
+        return *manifest;
     }
 
     void* getSymbol(const std::string& symbol)
@@ -497,69 +785,43 @@ struct ModuleManager
     }
 
     /**
-     * @brief Browse a directory of a package.
-     *
-     * @param package
-     * @param package
-     * @param type
+     * @brief Release the modules of a ModuleReferences. The shared
+     * libraries no longer referenced are unloaded. The caller must lock
+     * the registry.
      */
-    void browse(const Path& path,
-                const std::string& package,
-                Context::ModuleType type)
+    void release(ModuleReferences& references) noexcept
     {
-        if (not path.is_directory())
-            return;
+        for (const auto& elem : references.mResolved) {
+            auto* module = elem.second;
 
-        DirectoryIterator it(path), end;
-        for (; it != end; ++it) {
-            if (it->is_file()) {
-                std::string library = getLibraryName(*it);
+            if (--module->mReferences == 0) {
+                auto& table = module->mType == Context::ModuleType::MODULE_OOV
+                                ? mTableOov
+                                : mTableSimulator;
 
-                if (not library.empty()) {
-                    getModule(package, library, type);
-                }
+                table.erase(module->mPath.string());
             }
         }
+
+        references.mResolved.clear();
     }
 
-    Path buildModuleFilename(const std::string& package,
+    Path buildModuleFilename(Context* ctx,
+                             const std::string& package,
                              const std::string& library,
                              Context::ModuleType type)
     {
-        const auto& paths = mContext->getBinaryPackagesDir();
+        const auto& paths = ctx->getBinaryPackagesDir();
         for (const auto& elem : paths) {
-            Path current = elem / package;
-
-            if (not current.is_directory()) // if package does not exists
-                continue;                   // in repository test the next.
-
-            switch (type) {
-            case Context::ModuleType::MODULE_DYNAMICS:
-            case Context::ModuleType::MODULE_DYNAMICS_EXECUTIVE:
-            case Context::ModuleType::MODULE_DYNAMICS_WRAPPER:
-                current /= "plugins";
-                current /= "simulator";
-                break;
-            case Context::ModuleType::MODULE_OOV:
-                current /= "plugins";
-                current /= "output";
-                break;
-            default:
-                throw utils::InternalError(_("Missing type"));
-            }
-
-#if defined(_WIN32)
-            std::string filename = "lib" + library + ".dll";
-#elif defined(__APPLE__)
-            std::string filename = "lib" + library + ".dylib";
-#else
-            std::string filename = "lib" + library + ".so";
-#endif
+            // if package does not exists in repository test the next.
+            if (not(elem / package).is_directory())
+                continue;
 
-            current /= filename;
+            Path current =
+              getModuleFilename(elem, package, library, getModuleKind(type));
 
             if (not current.is_file()) {
-                vDbg(mContext,
+                vDbg(ctx,
                      _("ModuleManager: library %s is missing"
                        " in binary package %s in %s\n"),
                      library.c_str(),
@@ -578,63 +840,6 @@ struct ModuleManager
             .str());
     }
 
-    /*
-     * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-     * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-     * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-     */
-
-    void browse()
-    {
-        const auto& paths = mContext->getBinaryPackagesDir();
-
-        for (const auto& elem : paths) {
-            Path packages = elem;
-            Path pathsim = "plugins/simulator";
-            Path pathoov = "plugins/output";
-
-            if (not packages.is_directory()) {
-                vErr(mContext,
-                     _("ModuleManager: %s is not a packages "
-                       "directory\n"),
-                     elem.string().c_str());
-                continue;
-            }
-
-            DirectoryIterator it(elem), end;
-            for (; it != end; ++it) {
-                if (not it->is_directory())
-                    continue;
-
-                std::string package = it->path().filename();
-                if (exists(it->path().string())) {
-                    vInfo(mContext,
-                          _("ModuleManager: package `%s' already"
-                            " exists. Forget this path: `%s'\n"),
-                          package.c_str(),
-                          it->path().string().c_str());
-                    continue;
-                }
-
-                {
-                    Path tmp = (*it) / "plugins" / "simulator";
-                    browse(tmp, package, Context::ModuleType::MODULE_DYNAMICS);
-                }
-
-                {
-                    Path tmp = (*it) / "plugins" / "output";
-                    browse(tmp, package, Context::ModuleType::MODULE_OOV);
-                }
-            }
-        }
-    }
-
-    /*
-     * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-     * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-     * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-     */
-
     /**
      * @brief Retrieve the list of all modules.
      *
@@ -738,6 +943,14 @@ struct ModuleManager
     }
 };
 
+ModuleReferences::~ModuleReferences() noexcept
+{
+    auto& modules = ModuleManager::instance();
+    std::lock_guard<std::mutex> lock(modules.mMutex);
+
+    modules.release(*this);
+}
+
 void*
 Context::get_symbol(const std::string& package,
                     const std::string& library,
@@ -745,31 +958,28 @@ Context::get_symbol(const std::string& package,
                     Context::ModuleType* newtype)
 {
     if (not m_pimpl->modules)
-        m_pimpl->modules = std::make_shared<ModuleManager>(this);
+        m_pimpl->modules = std::make_shared<ModuleReferences>();
 
-    if (not newtype)
-        return m_pimpl->modules->getModule(package, library, type)->get();
+    auto& modules = ModuleManager::instance();
+    std::lock_guard<std::mutex> lock(modules.mMutex);
 
-    const auto& module = m_pimpl->modules->getModule(package, library, type);
-    auto* result = module->get();
-    *newtype = module->mType;
-
-    return result;
+    return modules.getSymbol(
+      this, *m_pimpl->modules, package, library, type, newtype);
 }
 
 void*
 Context::get_symbol(const std::string& pluginname)
 {
-    if (not m_pimpl->modules)
-        m_pimpl->modules = std::make_shared<ModuleManager>(this);
+    auto& modules = ModuleManager::instance();
+    std::lock_guard<std::mutex> lock(modules.mMutex);
 
-    return m_pimpl->modules->getSymbol(pluginname);
+    return modules.getSymbol(pluginname);
 }
 
 void
 Context::unload_dynamic_libraries() noexcept
 {
-    m_pimpl.reset(nullptr);
+    m_pimpl->modules.reset();
 }
 
 std::vector<Context::Module>
@@ -94,7 +94,7 @@ namespace utils {
 using PreferenceType = boost::variant<bool, std::string, long, double>;
 using PreferenceMap = std::map<std::string, PreferenceType>;
 
-struct ModuleManager;
+struct ModuleReferences;
 
 struct PrivateContextImpl
 {
@@ -103,7 +103,7 @@ struct PrivateContextImpl
 
     PreferenceMap settings; ///< global settings
 
-    std::shared_ptr<ModuleManager> modules;
+    std::shared_ptr<ModuleReferences> modules;
 
     std::unique_ptr<Context::LogFunctor> log_fn;
     int log_priority;
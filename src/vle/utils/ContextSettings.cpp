@@ -104,6 +104,8 @@ Context::reset_settings() noexcept
         { "gvle.graphics.line-width", 3.0 },
         { "vle.simulation.thread", 0l },
         { "vle.simulation.block-size", 8l },
+        { "vle.simulation.partition", false },
+        { "vle.simulation.optimistic", false },
         { "vle.packages.configure",
           std::string(VLE_PACKAGE_COMMAND_CONFIGURE) },
         { "vle.packages.test", std::string(VLE_PACKAGE_COMMAND_TEST) },
@@ -15,6 +15,7 @@
 #ifndef VLE_UTILS_FILESYSTEM_HPP
 #define VLE_UTILS_FILESYSTEM_HPP
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -112,6 +113,13 @@ public:
 
     size_t file_size() const;
 
+    /**
+     * Return the time of the last modification of the file in seconds
+     * since the epoch.
+     * @throw FileError if the file can not be stat.
+     */
+    std::int64_t last_write_time() const;
+
     bool is_directory() const;
 
     bool is_file() const;
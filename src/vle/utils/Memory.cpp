@@ -0,0 +1,161 @@
+/*
+ * This file is part of VLE, a framework for multi-modeling, simulation
+ * and analysis of complex dynamical systems.
+ * http://www.vle-project.org
+ *
+ * Copyright (c) 2003-2017 Gauthier Quesnel <gauthier.quesnel@inra.fr>
+ * Copyright (c) 2003-2017 ULCO http://www.univ-littoral.fr
+ * Copyright (c) 2007-2017 INRA http://www.inra.fr
+ *
+ * See the AUTHORS or Authors.txt file for copyright owners and
+ * contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <atomic>
+#include <vle/utils/Memory.hpp>
+
+namespace vle {
+namespace utils {
+
+namespace {
+
+struct GlobalCounter
+{
+    std::atomic<std::uint64_t> allocations{ 0 };
+    std::atomic<std::uint64_t> deallocations{ 0 };
+    std::atomic<std::uint64_t> bytes{ 0 };
+    std::atomic<std::int64_t> live{ 0 };
+    std::atomic<std::int64_t> peak{ 0 };
+};
+
+std::atomic<bool> memory_enabled{ false };
+std::array<GlobalCounter, Memory::tags> memory_counters;
+
+thread_local MemoryCounter memory_thread;
+
+} // anonymous namespace
+
+constexpr int Memory::tags;
+
+const char*
+Memory::name(MemoryTag tag) noexcept
+{
+    static const char* const names[] = {
+        "value", "event", "model", "vpz", "output"
+    };
+
+    return names[static_cast<int>(tag)];
+}
+
+void
+Memory::enable() noexcept
+{
+    memory_enabled.store(true, std::memory_order_relaxed);
+}
+
+void
+Memory::disable() noexcept
+{
+    memory_enabled.store(false, std::memory_order_relaxed);
+}
+
+bool
+Memory::enabled() noexcept
+{
+    return memory_enabled.load(std::memory_order_relaxed);
+}
+
+void
+Memory::reset() noexcept
+{
+    for (auto& elem : memory_counters) {
+        elem.allocations = 0;
+        elem.deallocations = 0;
+        elem.bytes = 0;
+        elem.live = 0;
+        elem.peak = 0;
+    }
+}
+
+void*
+Memory::allocate(std::size_t size, MemoryTag tag)
+{
+    void* ptr = ::operator new(size);
+
+    if (memory_enabled.load(std::memory_order_relaxed)) {
+        auto& counter = memory_counters[static_cast<int>(tag)];
+        auto length = static_cast<std::int64_t>(size);
+
+        counter.allocations.fetch_add(1, std::memory_order_relaxed);
+        counter.bytes.fetch_add(size, std::memory_order_relaxed);
+
+        auto live =
+          counter.live.fetch_add(length, std::memory_order_relaxed) + length;
+        auto peak = counter.peak.load(std::memory_order_relaxed);
+        while (live > peak and
+               not counter.peak.compare_exchange_weak(
+                 peak, live, std::memory_order_relaxed))
+            ;
+
+        ++memory_thread.allocations;
+        memory_thread.bytes += size;
+        memory_thread.live += length;
+    }
+
+    return ptr;
+}
+
+void
+Memory::deallocate(void* ptr, std::size_t size, MemoryTag tag) noexcept
+{
+    if (memory_enabled.load(std::memory_order_relaxed)) {
+        auto& counter = memory_counters[static_cast<int>(tag)];
+        auto length = static_cast<std::int64_t>(size);
+
+        counter.deallocations.fetch_add(1, std::memory_order_relaxed);
+        counter.live.fetch_sub(length, std::memory_order_relaxed);
+
+        ++memory_thread.deallocations;
+        memory_thread.live -= length;
+    }
+
+    ::operator delete(ptr);
+}
+
+MemoryCounter
+Memory::counter(MemoryTag tag) noexcept
+{
+    const auto& counter = memory_counters[static_cast<int>(tag)];
+    MemoryCounter result;
+
+    result.allocations = counter.allocations.load(std::memory_order_relaxed);
+    result.deallocations =
+      counter.deallocations.load(std::memory_order_relaxed);
+    result.bytes = counter.bytes.load(std::memory_order_relaxed);
+    result.live = counter.live.load(std::memory_order_relaxed);
+    result.peak = counter.peak.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+MemoryCounter
+Memory::thread() noexcept
+{
+    return memory_thread;
+}
+}
+} // namespace vle utils
@@ -0,0 +1,217 @@
+/*
+ * This file is part of VLE, a framework for multi-modeling, simulation
+ * and analysis of complex dynamical systems.
+ * http://www.vle-project.org
+ *
+ * Copyright (c) 2003-2017 Gauthier Quesnel <gauthier.quesnel@inra.fr>
+ * Copyright (c) 2003-2017 ULCO http://www.univ-littoral.fr
+ * Copyright (c) 2007-2017 INRA http://www.inra.fr
+ *
+ * See the AUTHORS or Authors.txt file for copyright owners and
+ * contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VLE_UTILS_MEMORY_HPP
+#define VLE_UTILS_MEMORY_HPP 1
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vle/DllDefines.hpp>
+
+namespace vle {
+namespace utils {
+
+/**
+ * @brief The subsystems of the memory accounting.
+ */
+enum class MemoryTag
+{
+    value,  ///< value::Value.
+    event,  ///< ExternalEventList and the attributes of the ExternalEvent.
+    model,  ///< devs::Dynamics and devs::Simulator.
+    vpz,    ///< The vpz::BaseModel graph.
+    output, ///< The oov::Plugin.
+};
+
+/**
+ * @brief Counters of a MemoryTag. The live and peak sizes are signed: a
+ * memory allocated before Memory::enable() and freed after is subtracted
+ * without being added.
+ */
+struct MemoryCounter
+{
+    std::uint64_t allocations = 0;   ///< Number of allocations.
+    std::uint64_t deallocations = 0; ///< Number of deallocations.
+    std::uint64_t bytes = 0;         ///< Bytes allocated.
+    std::int64_t live = 0;           ///< Bytes allocated and not freed.
+    std::int64_t peak = 0;           ///< Maximum of live.
+};
+
+/**
+ * @brief Count the allocations and the bytes of the subsystems of VLE.
+ *
+ * The classes of the subsystems inherit MemoryTagged, which provides a
+ * class operator new and delete, and the containers use MemoryAllocator.
+ * Both forward to Memory::allocate() and Memory::deallocate(), which
+ * only test an atomic flag while the accounting is disabled.
+ *
+ * Counters are process wide (atomic) and per thread. The per thread
+ * counters let the profiler of the Coordinator attribute the allocations
+ * to the phases of a simulation while other simulations run in other
+ * threads.
+ *
+ * @code
+ * vle::utils::Memory::enable();
+ * ...
+ * auto values = vle::utils::Memory::counter(vle::utils::MemoryTag::value);
+ * std::cout << values.allocations << ' ' << values.peak << '\n';
+ * @endcode
+ */
+class VLE_API Memory
+{
+public:
+    /** Number of MemoryTag. */
+    static constexpr int tags = 5;
+
+    /**
+     * @brief Get the name of the tag ("value", "event", "model", "vpz" or
+     * "output").
+     */
+    static const char* name(MemoryTag tag) noexcept;
+
+    /**
+     * @brief Start the accounting. The counters are not reset.
+     */
+    static void enable() noexcept;
+
+    /**
+     * @brief Stop the accounting.
+     */
+    static void disable() noexcept;
+
+    static bool enabled() noexcept;
+
+    /**
+     * @brief Reset all the process wide counters. The per thread counters
+     * are only read through differences and are never reset.
+     */
+    static void reset() noexcept;
+
+    /**
+     * @brief Allocate @e size bytes with the global operator new.
+     * @throw std::bad_alloc.
+     */
+    static void* allocate(std::size_t size, MemoryTag tag);
+
+    /**
+     * @brief Free the memory allocated by allocate() with the same size.
+     */
+    static void deallocate(void* ptr, std::size_t size, MemoryTag tag) noexcept;
+
+    /**
+     * @brief Get the process wide counters of the tag.
+     */
+    static MemoryCounter counter(MemoryTag tag) noexcept;
+
+    /**
+     * @brief Get the sum of the counters of all tags for the calling
+     * thread. Only allocations, deallocations, bytes and live are filled.
+     */
+    static MemoryCounter thread() noexcept;
+};
+
+/**
+ * @brief Base class which accounts the instances of the derived classes
+ * allocated with new into @e Tag. The derived classes must have a
+ * virtual destructor if they are deleted from a pointer to a base class.
+ */
+template <MemoryTag Tag>
+class MemoryTagged
+{
+public:
+    static void* operator new(std::size_t size)
+    {
+        return Memory::allocate(size, Tag);
+    }
+
+    static void operator delete(void* ptr, std::size_t size) noexcept
+    {
+        Memory::deallocate(ptr, size, Tag);
+    }
+
+    static void* operator new(std::size_t /*size*/, void* ptr) noexcept
+    {
+        return ptr;
+    }
+
+    static void operator delete(void* /*ptr*/, void* /*place*/) noexcept
+    {
+    }
+
+protected:
+    ~MemoryTagged() = default;
+};
+
+/**
+ * @brief A standard allocator which accounts its memory into @e Tag. Use
+ * it with standard containers or std::allocate_shared.
+ */
+template <typename T, MemoryTag Tag>
+class MemoryAllocator
+{
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = MemoryAllocator<U, Tag>;
+    };
+
+    MemoryAllocator() noexcept = default;
+
+    template <typename U>
+    MemoryAllocator(const MemoryAllocator<U, Tag>& /*other*/) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(Memory::allocate(n * sizeof(T), Tag));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        Memory::deallocate(ptr, n * sizeof(T), Tag);
+    }
+
+    template <typename U>
+    bool operator==(const MemoryAllocator<U, Tag>& /*other*/) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const MemoryAllocator<U, Tag>& /*other*/) const noexcept
+    {
+        return false;
+    }
+};
+}
+} // namespace vle utils
+
+#endif
@@ -26,7 +26,12 @@
 
 #include <boost/math/distributions/gamma.hpp>
 #include <boost/math/distributions/normal.hpp>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <vle/utils/Exception.hpp>
 #include <vle/utils/Rand.hpp>
+#include <vle/utils/i18n.hpp>
 
 #define _USE_MATH_DEFINES
 #include <cmath>
@@ -39,17 +44,97 @@
 namespace vle {
 namespace utils {
 
+void
+Philox::generate(std::uint64_t counter,
+                 std::array<result_type, 4>& block) const noexcept
+{
+    const std::uint32_t m0 = 0xD2511F53, m1 = 0xCD9E8D57;
+    const std::uint32_t w0 = 0x9E3779B9, w1 = 0xBB67AE85;
+
+    std::uint32_t c0 = static_cast<std::uint32_t>(counter);
+    std::uint32_t c1 = static_cast<std::uint32_t>(counter >> 32);
+    std::uint32_t c2 = static_cast<std::uint32_t>(m_stream);
+    std::uint32_t c3 = static_cast<std::uint32_t>(m_stream >> 32);
+    std::uint32_t k0 = m_seed, k1 = m_replicate;
+
+    for (int i = 0; i != 10; ++i) {
+        const std::uint64_t p0 = static_cast<std::uint64_t>(m0) * c0;
+        const std::uint64_t p1 = static_cast<std::uint64_t>(m1) * c2;
+
+        c0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+        c1 = static_cast<std::uint32_t>(p1);
+        c2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+        c3 = static_cast<std::uint32_t>(p0);
+
+        k0 += w0;
+        k1 += w1;
+    }
+
+    block = { { c0, c1, c2, c3 } };
+}
+
+std::ostream&
+operator<<(std::ostream& out, const Philox& philox)
+{
+    return out << philox.m_seed << ' ' << philox.m_replicate << ' '
+               << philox.m_stream << ' ' << philox.m_position;
+}
+
+std::istream&
+operator>>(std::istream& in, Philox& philox)
+{
+    Philox::result_type seed, replicate;
+    std::uint64_t stream, position;
+
+    if (in >> seed >> replicate >> stream >> position) {
+        philox.seed(seed, stream, replicate);
+        philox.discard(position);
+    }
+
+    return in;
+}
+
 Rand::Rand(result_type seed)
   : m_rand(seed)
 {
 }
 
+Rand::Rand(result_type seed, std::uint64_t stream, result_type replicate)
+  : m_rand(seed, stream, replicate)
+{
+}
+
 void
 Rand::seed(result_type seed)
 {
     m_rand.seed(seed);
 }
 
+void
+Rand::seed(result_type seed, std::uint64_t stream, result_type replicate)
+{
+    m_rand.seed(seed, stream, replicate);
+}
+
+Rand
+Rand::split(std::uint64_t stream) const
+{
+    return Rand(m_rand.getSeed(), stream, m_rand.getReplicate());
+}
+
+std::uint64_t
+Rand::stream(const std::string& name) noexcept
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+
+    for (auto c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
 bool
 Rand::getBool()
 {
@@ -70,18 +155,52 @@ Rand::getInt(int begin, int end)
     return distrib(m_rand);
 }
 
+/* Build a double [0, 1) from the 53 upper bits of two numbers. */
+static inline double
+to_double(Philox& gen) noexcept
+{
+    std::uint64_t hi = gen();
+    std::uint64_t lo = gen();
+
+    return static_cast<double>(((hi << 32) | lo) >> 11) *
+           (1.0 / 9007199254740992.0);
+}
+
 double
 Rand::getDouble()
 {
-    std::uniform_real_distribution<double> distrib(0.0, 1.0);
-    return distrib(m_rand);
+    return to_double(m_rand);
+}
+
+void
+Rand::fillDouble(double* out, std::size_t size)
+{
+    for (std::size_t i = 0; i != size; ++i)
+        out[i] = to_double(m_rand);
+}
+
+void
+Rand::fillDouble(double* out, std::size_t size, double begin, double end)
+{
+    const double range = end - begin;
+
+    for (std::size_t i = 0; i != size; ++i)
+        out[i] = begin + to_double(m_rand) * range;
+}
+
+void
+Rand::fillNormal(double* out, std::size_t size, double mean, double sigma)
+{
+    std::normal_distribution<double> distrib(mean, sigma);
+
+    for (std::size_t i = 0; i != size; ++i)
+        out[i] = distrib(m_rand);
 }
 
 double
 Rand::getDouble(double begin, double end)
 {
-    std::uniform_real_distribution<double> distrib(begin, end);
-    return distrib(m_rand);
+    return begin + to_double(m_rand) * (end - begin);
 }
 
 double
@@ -220,5 +339,24 @@ Rand::weibull3(const double a, const double b, const double c)
 
     return c + b * x;
 }
+
+std::string
+Rand::state() const
+{
+    std::ostringstream out;
+    out << m_rand;
+
+    return out.str();
+}
+
+void
+Rand::setState(const std::string& state)
+{
+    std::istringstream in(state);
+    in >> m_rand;
+
+    if (in.fail())
+        throw ArgError(_("Rand: bad state of the generator"));
+}
 }
 } // namespace vle utils
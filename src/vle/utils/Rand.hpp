@@ -27,20 +27,157 @@
 #ifndef VLE_UTILS_RAND_HPP
 #define VLE_UTILS_RAND_HPP
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
 #include <random>
+#include <string>
 #include <vle/DllDefines.hpp>
 
 namespace vle {
 namespace utils {
 
 /**
- * @brief vle::utils::Rand is a pseudo-random number generator based on
- * boost random packages. vle::utils::Rand uses the mersene_twister PRNG.
+ * @brief vle::utils::Philox is the counter-based Philox4x32-10 PRNG: the
+ * n-th number of a stream is computed from n, the key and the stream
+ * without the previous numbers. The key is built from a seed and a
+ * replicate index, the stream is a 64 bits identifier (for instance the
+ * identifier of an atomic model, see Rand::stream()). Two generators with
+ * different streams or keys are independent, the state is 24 bytes and
+ * discard() is O(1).
+ *
+ * Philox satisfies the UniformRandomBitGenerator concept and can be used
+ * with the std distributions.
  *
- * @note "Mersenne Twister: A 623-dimensionally equidistributed uniform
- * pseudo-random number generator", Makoto Matsumoto and Takuji Nishimura,
- * ACM Transactions on Modeling and Computer Simulation: Special Issue on
- * Uniform Random Number Generation, Vol. 8, No. 1, January 1998, pp. 3-30.
+ * @note "Parallel random numbers: as easy as 1, 2, 3", John K. Salmon,
+ * Mark A. Moraes, Ron O. Dror and David E. Shaw, Proceedings of the
+ * International Conference for High Performance Computing, Networking,
+ * Storage and Analysis (SC11), 2011.
+ */
+class VLE_API Philox
+{
+public:
+    using result_type = std::uint32_t;
+
+    static constexpr result_type min() noexcept
+    {
+        return 0;
+    }
+
+    static constexpr result_type max() noexcept
+    {
+        return 0xffffffff;
+    }
+
+    Philox() noexcept
+    {
+        seed(5489u);
+    }
+
+    /**
+     * @brief Build the first number of the @e stream of the key (@e seed,
+     * @e replicate).
+     */
+    explicit Philox(result_type seed,
+                    std::uint64_t stream = 0,
+                    result_type replicate = 0) noexcept
+    {
+        this->seed(seed, stream, replicate);
+    }
+
+    void seed(result_type seed,
+              std::uint64_t stream = 0,
+              result_type replicate = 0) noexcept
+    {
+        m_seed = seed;
+        m_replicate = replicate;
+        m_stream = stream;
+        m_position = 0;
+    }
+
+    result_type operator()() noexcept
+    {
+        if ((m_position & 3u) == 0)
+            generate(m_position >> 2, m_block);
+
+        return m_block[m_position++ & 3u];
+    }
+
+    /**
+     * @brief Skip the @e n next numbers of the stream.
+     */
+    void discard(unsigned long long n) noexcept
+    {
+        m_position += n;
+
+        if (m_position & 3u)
+            generate(m_position >> 2, m_block);
+    }
+
+    /**
+     * @brief Get a generator of the same key at the beginning of @e stream.
+     */
+    Philox split(std::uint64_t stream) const noexcept
+    {
+        return Philox(m_seed, stream, m_replicate);
+    }
+
+    result_type getSeed() const noexcept
+    {
+        return m_seed;
+    }
+
+    result_type getReplicate() const noexcept
+    {
+        return m_replicate;
+    }
+
+    std::uint64_t getStream() const noexcept
+    {
+        return m_stream;
+    }
+
+    /**
+     * @brief Compute the block @e counter of four numbers of this key and
+     * stream.
+     */
+    void generate(std::uint64_t counter,
+                  std::array<result_type, 4>& block) const noexcept;
+
+    friend bool operator==(const Philox& lhs, const Philox& rhs) noexcept
+    {
+        return lhs.m_seed == rhs.m_seed and
+               lhs.m_replicate == rhs.m_replicate and
+               lhs.m_stream == rhs.m_stream and
+               lhs.m_position == rhs.m_position;
+    }
+
+    friend bool operator!=(const Philox& lhs, const Philox& rhs) noexcept
+    {
+        return not(lhs == rhs);
+    }
+
+    friend VLE_API std::ostream& operator<<(std::ostream& out,
+                                            const Philox& philox);
+
+    friend VLE_API std::istream& operator>>(std::istream& in,
+                                            Philox& philox);
+
+private:
+    result_type m_seed;
+    result_type m_replicate;
+    std::uint64_t m_stream;
+    std::uint64_t m_position;
+    std::array<result_type, 4> m_block = {};
+};
+
+/**
+ * @brief vle::utils::Rand is a pseudo-random number generator based on
+ * the std random distributions. vle::utils::Rand uses the Philox PRNG: a
+ * model which builds its Rand with its own stream (see stream()) gets the
+ * same numbers whatever the number of threads or processes of the
+ * simulation and the order of the transitions.
  *
  * @code
  * vle::utils::Rand r;
@@ -65,27 +202,62 @@ namespace utils {
 class VLE_API Rand
 {
 public:
-    using result_type = std::mt19937::result_type;
+    using result_type = Philox::result_type;
 
     /**
-     * @brief Create a new PRNG mersene twister initializecd with a seed
-     * equal to 5489.
+     * @brief Create a new PRNG initialized with a seed equal to 5489.
      */
     Rand() = default;
 
     /**
-     * @brief Create a new PRNG mersene twister initialized with a seed
-     * provide by parameters.
+     * @brief Create a new PRNG initialized with a seed provide by
+     * parameters.
      * @param seed The seed to assign to the PRNG.
      */
     explicit Rand(result_type seed);
 
+    /**
+     * @brief Create a new PRNG on the @e stream of the key (@e seed, @e
+     * replicate).
+     * @code
+     * // In the constructor of a Dynamics, with a seed shared by all the
+     * // models and the index of the replicate of the experiment.
+     * m_rand.seed(seed, vle::utils::Rand::stream(
+     *     getModel().getCompleteName()), replicate);
+     * @endcode
+     * @param seed The seed to assign to the PRNG.
+     * @param stream The identifier of the stream.
+     * @param replicate The index of the replicate.
+     */
+    Rand(result_type seed, std::uint64_t stream, result_type replicate = 0);
+
     /**
      * @brief Set the seed for the random number generator.
      * @param seed a value to reinitialize the random number generator.
      */
     void seed(result_type seed);
 
+    /**
+     * @brief Set the seed, the stream and the replicate of the random
+     * number generator.
+     */
+    void seed(result_type seed,
+              std::uint64_t stream,
+              result_type replicate = 0);
+
+    /**
+     * @brief Get a new PRNG with the same seed and replicate on another
+     * stream. The PRNG are independent and the call is O(1).
+     */
+    Rand split(std::uint64_t stream) const;
+
+    /**
+     * @brief Compute a stream identifier from a name, for instance the
+     * complete name of an atomic model (FNV-1a hash). The result does not
+     * depend on the platform.
+     */
+    static std::uint64_t stream(const std::string& name) noexcept;
+
     /**
      * @brief Generate a boolean value [true, false] using the Bernoulli
      * distribition where p = 0.5. (P(true) = p, P(false) = 1 - p).
@@ -113,6 +285,23 @@ public:
      */
     double getDouble();
 
+    /**
+     * @brief Fill @e size reals [0, 1) into @e out, the same values as @e
+     * size calls to getDouble().
+     */
+    void fillDouble(double* out, std::size_t size);
+
+    /**
+     * @brief Fill @e size reals [begin..end) into @e out.
+     */
+    void fillDouble(double* out, std::size_t size, double begin, double end);
+
+    /**
+     * @brief Fill @e size reals of the normal law into @e out. The
+     * distribution is built once for all the values.
+     */
+    void fillNormal(double* out, std::size_t size, double mean, double sigma);
+
     /**
      * @brief Generate a real from begin to end [begin..end).
      * @param begin The minimum value.
@@ -262,26 +451,36 @@ public:
     double weibull3(const double a, const double b, const double c);
 
     /**
-     * @brief Get a reference to the Mersenne Twister PRNG.
+     * @brief Get a reference to the Philox PRNG.
      * @code
      * vle::utils::Rand r(123456789);
-     * std::uniform_real < > d(0., 100.); // [0., 100.)
-     * std::variate_generator < std::mt19937&,
-     *                            std::uniform_real < > > gen(r, d);
-     * std::cout << gen() << "\n";
-     *
-     * std::vector < uint32_t > vec(1000);
-     * vle::utils::generate(vec.begin(), vec.end(), gen);
+     * std::uniform_real_distribution<> d(0., 100.); // [0., 100.)
+     * std::cout << d(r.gen()) << "\n";
      * @endcode
      * @return A reference to the PRNG.
      */
-    std::mt19937& gen()
+    Philox& gen()
     {
         return m_rand;
     }
 
+    /**
+     * @brief Get the internal state of the PRNG to store it in a
+     * checkpoint of the simulation.
+     * @return The textual representation of the Philox PRNG.
+     */
+    std::string state() const;
+
+    /**
+     * @brief Assign the internal state returned by state(). The next
+     * numbers are those generated after the call to state().
+     * @param state The textual representation of the Philox PRNG.
+     * @throw utils::ArgError if the state is not valid.
+     */
+    void setState(const std::string& state);
+
 private:
-    std::mt19937 m_rand;
+    Philox m_rand;
 };
 }
 } // namespace vle utils
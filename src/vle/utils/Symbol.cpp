@@ -0,0 +1,100 @@
+/*
+ * This file is part of VLE, a framework for multi-modeling, simulation
+ * and analysis of complex dynamical systems.
+ * http://www.vle-project.org
+ *
+ * Copyright (c) 2003-2017 Gauthier Quesnel <gauthier.quesnel@inra.fr>
+ * Copyright (c) 2003-2017 ULCO http://www.univ-littoral.fr
+ * Copyright (c) 2007-2017 INRA http://www.inra.fr
+ *
+ * See the AUTHORS or Authors.txt file for copyright owners and
+ * contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vle/utils/Symbol.hpp>
+
+namespace vle {
+namespace utils {
+
+namespace {
+
+struct SymbolTable
+{
+    std::unordered_map<std::string, Symbol::id_type> strings;
+    std::shared_timed_mutex mutex;
+
+    /// The entry of the empty string, the identifier 0.
+    const std::pair<const std::string, Symbol::id_type>* empty;
+
+    SymbolTable()
+      : empty(&*strings.emplace(std::string(), 0).first)
+    {
+    }
+
+    const std::pair<const std::string, Symbol::id_type>* intern(
+      const std::string& str)
+    {
+        {
+            std::shared_lock<std::shared_timed_mutex> lock(mutex);
+            auto it = strings.find(str);
+            if (it != strings.end())
+                return &*it;
+        }
+
+        std::unique_lock<std::shared_timed_mutex> lock(mutex);
+        auto id = static_cast<Symbol::id_type>(strings.size());
+        return &*strings.emplace(str, id).first;
+    }
+};
+
+SymbolTable&
+symbol_table()
+{
+    static SymbolTable table;
+
+    return table;
+}
+
+} // anonymous namespace
+
+Symbol::Symbol()
+  : m_entry(symbol_table().empty)
+{
+}
+
+Symbol::Symbol(const std::string& str)
+  : m_entry(symbol_table().intern(str))
+{
+}
+
+Symbol::Symbol(const char* str)
+  : m_entry(symbol_table().intern(std::string(str)))
+{
+}
+
+std::size_t
+Symbol::size()
+{
+    auto& table = symbol_table();
+    std::shared_lock<std::shared_timed_mutex> lock(table.mutex);
+
+    return table.strings.size();
+}
+}
+} // namespace vle utils
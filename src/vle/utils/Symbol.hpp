@@ -0,0 +1,181 @@
+/*
+ * This file is part of VLE, a framework for multi-modeling, simulation
+ * and analysis of complex dynamical systems.
+ * http://www.vle-project.org
+ *
+ * Copyright (c) 2003-2017 Gauthier Quesnel <gauthier.quesnel@inra.fr>
+ * Copyright (c) 2003-2017 ULCO http://www.univ-littoral.fr
+ * Copyright (c) 2007-2017 INRA http://www.inra.fr
+ *
+ * See the AUTHORS or Authors.txt file for copyright owners and
+ * contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VLE_UTILS_SYMBOL_HPP
+#define VLE_UTILS_SYMBOL_HPP 1
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vle/DllDefines.hpp>
+
+namespace vle {
+namespace utils {
+
+/**
+ * @brief An interned string: the names of the models, ports and views.
+ *
+ * All the Symbol built from the same string share the same entry of a
+ * global symbol table and the same integer identifier. Copying,
+ * comparing or hashing a Symbol does not touch the characters of the
+ * string. The entries are never removed from the table so the references
+ * returned by str() stay valid until the end of the program.
+ *
+ * Building a Symbol from a string takes a shared lock on the table (an
+ * exclusive lock if the string is new), all the other operations are
+ * lock free.
+ *
+ * @code
+ * vle::utils::Symbol a("out"), b(std::string("out"));
+ * assert(a == b and a.id() == b.id() and a.str() == "out");
+ * @endcode
+ */
+class VLE_API Symbol
+{
+public:
+    using id_type = std::uint32_t;
+
+    /**
+     * @brief Build the Symbol of the empty string, the identifier 0. Does
+     * not lock the table.
+     */
+    Symbol();
+
+    Symbol(const std::string& str);
+
+    Symbol(const char* str);
+
+    /**
+     * @brief Get the unique identifier of the Symbol, the identifiers are
+     * allocated in the order of the first interning, 0 is the empty string.
+     */
+    id_type id() const noexcept
+    {
+        return m_entry->second;
+    }
+
+    const std::string& str() const noexcept
+    {
+        return m_entry->first;
+    }
+
+    const char* c_str() const noexcept
+    {
+        return m_entry->first.c_str();
+    }
+
+    operator const std::string&() const noexcept
+    {
+        return m_entry->first;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_entry->first.empty();
+    }
+
+    /**
+     * @brief Get the number of strings in the symbol table.
+     */
+    static std::size_t size();
+
+    friend bool operator==(const Symbol& lhs, const Symbol& rhs) noexcept
+    {
+        return lhs.m_entry == rhs.m_entry;
+    }
+
+    friend bool operator!=(const Symbol& lhs, const Symbol& rhs) noexcept
+    {
+        return lhs.m_entry != rhs.m_entry;
+    }
+
+    /**
+     * @brief Order the Symbol by identifier, not by the lexicographical
+     * order of the strings.
+     */
+    friend bool operator<(const Symbol& lhs, const Symbol& rhs) noexcept
+    {
+        return lhs.id() < rhs.id();
+    }
+
+    friend bool operator==(const Symbol& lhs, const std::string& rhs)
+    {
+        return lhs.str() == rhs;
+    }
+
+    friend bool operator==(const std::string& lhs, const Symbol& rhs)
+    {
+        return lhs == rhs.str();
+    }
+
+    friend bool operator!=(const Symbol& lhs, const std::string& rhs)
+    {
+        return lhs.str() != rhs;
+    }
+
+    friend bool operator!=(const std::string& lhs, const Symbol& rhs)
+    {
+        return lhs != rhs.str();
+    }
+
+    friend bool operator==(const Symbol& lhs, const char* rhs)
+    {
+        return lhs.str() == rhs;
+    }
+
+    friend bool operator!=(const Symbol& lhs, const char* rhs)
+    {
+        return lhs.str() != rhs;
+    }
+
+private:
+    using entry_type = std::pair<const std::string, id_type>;
+
+    const entry_type* m_entry;
+};
+
+inline std::ostream&
+operator<<(std::ostream& out, const Symbol& symbol)
+{
+    return out << symbol.str();
+}
+}
+} // namespace vle utils
+
+namespace std {
+
+template <>
+struct hash<vle::utils::Symbol>
+{
+    std::size_t operator()(const vle::utils::Symbol& symbol) const noexcept
+    {
+        return symbol.id();
+    }
+};
+}
+
+#endif
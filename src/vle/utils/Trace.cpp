@@ -0,0 +1,265 @@
+/*
+ * This file is part of VLE, a framework for multi-modeling, simulation
+ * and analysis of complex dynamical systems.
+ * http://www.vle-project.org
+ *
+ * Copyright (c) 2003-2017 Gauthier Quesnel <gauthier.quesnel@inra.fr>
+ * Copyright (c) 2003-2017 ULCO http://www.univ-littoral.fr
+ * Copyright (c) 2007-2017 INRA http://www.inra.fr
+ *
+ * See the AUTHORS or Authors.txt file for copyright owners and
+ * contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vle/utils/Trace.hpp>
+
+namespace {
+
+using TraceClock = std::chrono::steady_clock;
+
+struct TraceEvent
+{
+    const char* category;
+    const char* name;
+    std::int64_t begin;
+    std::int64_t end;
+};
+
+/**
+ * The ring buffer of a thread. Only its thread writes into it, write()
+ * reads it when the threads do not record.
+ */
+struct TraceBuffer
+{
+    TraceBuffer(std::uint32_t tid_, std::size_t capacity_)
+      : tid(tid_)
+      , capacity(capacity_)
+    {
+        events.reserve(std::min(capacity, std::size_t{ 1024 }));
+    }
+
+    void push(const TraceEvent& event)
+    {
+        if (events.size() < capacity) {
+            events.emplace_back(event);
+        } else {
+            events[next] = event;
+            next = (next + 1) % capacity;
+            ++dropped;
+        }
+    }
+
+    std::vector<TraceEvent> events;
+    std::string name;
+    std::uint64_t dropped = 0;
+    std::size_t next = 0;
+    std::uint32_t tid;
+    std::size_t capacity;
+};
+
+struct TraceRegistry
+{
+    static TraceRegistry& instance()
+    {
+        static TraceRegistry registry;
+        return registry;
+    }
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    std::atomic<bool> enabled{ false };
+    std::atomic<std::uint64_t> generation{ 0 };
+    std::atomic<std::int64_t> epoch{ 0 };
+    std::size_t capacity = 0;
+};
+
+/*
+ * The buffer of a thread is registered the first time the thread records
+ * an event after a call to start(). The registry keeps it alive after the
+ * end of the thread.
+ */
+thread_local std::shared_ptr<TraceBuffer> local_buffer;
+thread_local std::uint64_t local_generation = 0;
+thread_local std::string local_name;
+
+TraceBuffer*
+get_buffer()
+{
+    auto& registry = TraceRegistry::instance();
+    auto generation = registry.generation.load(std::memory_order_acquire);
+
+    if (not local_buffer or local_generation != generation) {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        local_buffer = std::make_shared<TraceBuffer>(
+          static_cast<std::uint32_t>(registry.buffers.size() + 1),
+          registry.capacity);
+        local_buffer->name = local_name;
+        local_generation = generation;
+        registry.buffers.emplace_back(local_buffer);
+    }
+
+    return local_buffer.get();
+}
+
+std::int64_t
+clock_now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             TraceClock::now().time_since_epoch())
+      .count();
+}
+
+void
+write_string(std::ostream& os, const char* str)
+{
+    os << '"';
+    for (; *str; ++str) {
+        if (*str == '"' or *str == '\\')
+            os << '\\' << *str;
+        else if (static_cast<unsigned char>(*str) >= 0x20)
+            os << *str;
+    }
+    os << '"';
+}
+
+/* Chrome trace-event timestamps are in microseconds. */
+void
+write_microseconds(std::ostream& os, std::int64_t ns)
+{
+    auto fill = os.fill('0');
+    os << ns / 1000 << '.';
+    os.width(3);
+    os << ns % 1000;
+    os.fill(fill);
+}
+
+} // anonymous namespace
+
+namespace vle {
+namespace utils {
+
+void
+Trace::start(std::size_t capacity)
+{
+    auto& registry = TraceRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    registry.buffers.clear();
+    registry.capacity = std::max(capacity, std::size_t{ 1 });
+    registry.epoch.store(clock_now(), std::memory_order_relaxed);
+    registry.generation.fetch_add(1, std::memory_order_release);
+    registry.enabled.store(true, std::memory_order_release);
+}
+
+void
+Trace::stop() noexcept
+{
+    TraceRegistry::instance().enabled.store(false, std::memory_order_release);
+}
+
+bool
+Trace::enabled() noexcept
+{
+    return TraceRegistry::instance().enabled.load(std::memory_order_relaxed);
+}
+
+std::int64_t
+Trace::now() noexcept
+{
+    return clock_now() -
+           TraceRegistry::instance().epoch.load(std::memory_order_relaxed);
+}
+
+void
+Trace::complete(const char* category,
+                const char* name,
+                std::int64_t begin,
+                std::int64_t end) noexcept
+{
+    if (not enabled())
+        return;
+
+    try {
+        get_buffer()->push(TraceEvent{ category, name, begin, end });
+    } catch (...) {
+    }
+}
+
+void
+Trace::thread(const std::string& name)
+{
+    local_name = name;
+
+    if (local_buffer and
+        local_generation ==
+          TraceRegistry::instance().generation.load(std::memory_order_acquire))
+        local_buffer->name = name;
+}
+
+void
+Trace::write(std::ostream& os)
+{
+    auto& registry = TraceRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::uint64_t dropped = 0;
+    bool first = true;
+
+    os << "{\"traceEvents\":[";
+
+    for (const auto& buffer : registry.buffers) {
+        dropped += buffer->dropped;
+
+        if (not buffer->name.empty()) {
+            os << (first ? "\n" : ",\n")
+               << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+               << buffer->tid << ",\"args\":{\"name\":";
+            write_string(os, buffer->name.c_str());
+            os << "}}";
+            first = false;
+        }
+
+        //
+        // The oldest event of a full ring buffer is at the @e next index.
+        //
+        const auto size = buffer->events.size();
+        for (std::size_t i = 0; i != size; ++i) {
+            const auto& event = buffer->events[(buffer->next + i) % size];
+
+            os << (first ? "\n" : ",\n") << "{\"name\":";
+            write_string(os, event.name);
+            os << ",\"cat\":";
+            write_string(os, event.category);
+            os << ",\"ph\":\"X\",\"ts\":";
+            write_microseconds(os, event.begin);
+            os << ",\"dur\":";
+            write_microseconds(os, event.end - event.begin);
+            os << ",\"pid\":1,\"tid\":" << buffer->tid << '}';
+            first = false;
+        }
+    }
+
+    os << "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped-events\":"
+       << dropped << "}}\n";
+}
+}
+} // namespace vle utils
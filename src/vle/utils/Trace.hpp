@@ -0,0 +1,164 @@
+/*
+ * This file is part of VLE, a framework for multi-modeling, simulation
+ * and analysis of complex dynamical systems.
+ * http://www.vle-project.org
+ *
+ * Copyright (c) 2003-2017 Gauthier Quesnel <gauthier.quesnel@inra.fr>
+ * Copyright (c) 2003-2017 ULCO http://www.univ-littoral.fr
+ * Copyright (c) 2007-2017 INRA http://www.inra.fr
+ *
+ * See the AUTHORS or Authors.txt file for copyright owners and
+ * contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VLE_UTILS_TRACE_HPP
+#define VLE_UTILS_TRACE_HPP 1
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vle/DllDefines.hpp>
+
+namespace vle {
+namespace utils {
+
+/**
+ * @brief Record a timeline of the simulation (parse, load, phases of the
+ * Coordinator, worker threads, manager runs and output plug-ins) and
+ * write it in the Chrome trace-event JSON format (chrome://tracing,
+ * https://ui.perfetto.dev).
+ *
+ * Each thread records its events into its own ring buffer: the oldest
+ * events of a thread are overwritten when its buffer is full and the only
+ * lock is taken the first time a thread records an event.
+ *
+ * Trace points are declared with the vle_trace_scope() and
+ * vle_trace_thread() macros. They are compiled only if the VLE_TRACE
+ * macro is defined (cmake -DWITH_TRACE=ON), otherwise they produce no
+ * code at all.
+ *
+ * @code
+ * vle::utils::Trace::start();
+ * {
+ *     vle_trace_scope("kernel", "run");
+ *     ...
+ * }
+ * vle::utils::Trace::stop();
+ *
+ * std::ofstream ofs("trace.json");
+ * vle::utils::Trace::write(ofs);
+ * @endcode
+ */
+class VLE_API Trace
+{
+public:
+    /**
+     * @brief Clear the previous events and start the recording.
+     * @param capacity The number of events of the ring buffer of each
+     * thread.
+     */
+    static void start(std::size_t capacity = 1 << 16);
+
+    /**
+     * @brief Stop the recording. The recorded events are kept until the
+     * next call to start().
+     */
+    static void stop() noexcept;
+
+    /**
+     * @brief Check if the recording is started.
+     */
+    static bool enabled() noexcept;
+
+    /**
+     * @brief Get the time in nanoseconds since the call to start().
+     */
+    static std::int64_t now() noexcept;
+
+    /**
+     * @brief Record a complete event into the buffer of the current
+     * thread. Does nothing if the recording is stopped.
+     * @param category The category of the event, a string literal.
+     * @param name The name of the event, a string literal.
+     * @param begin The result of now() at the beginning of the event.
+     * @param end The result of now() at the end of the event.
+     */
+    static void complete(const char* category,
+                         const char* name,
+                         std::int64_t begin,
+                         std::int64_t end) noexcept;
+
+    /**
+     * @brief Assign a name to the current thread in the timeline.
+     */
+    static void thread(const std::string& name);
+
+    /**
+     * @brief Write the recorded events of all threads as a Chrome
+     * trace-event JSON document. Call it when the threads do not record.
+     */
+    static void write(std::ostream& os);
+};
+
+/**
+ * @brief Record a complete event from its construction to its
+ * destruction. Prefer the vle_trace_scope() macro.
+ */
+class TraceScope
+{
+public:
+    TraceScope(const char* category, const char* name) noexcept
+      : m_category(Trace::enabled() ? category : nullptr)
+      , m_name(name)
+      , m_begin(m_category ? Trace::now() : 0)
+    {
+    }
+
+    ~TraceScope() noexcept
+    {
+        if (m_category)
+            Trace::complete(m_category, m_name, m_begin, Trace::now());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_category;
+    const char* m_name;
+    std::int64_t m_begin;
+};
+}
+} // namespace vle utils
+
+#define vle_trace_concat_(x, y) x##y
+#define vle_trace_concat(x, y) vle_trace_concat_(x, y)
+
+#ifdef VLE_TRACE
+#define vle_trace_scope(category, name)                                       \
+    ::vle::utils::TraceScope vle_trace_concat(vle_trace_scope_, __LINE__)(    \
+      category, name)
+#define vle_trace_thread(name) ::vle::utils::Trace::thread(name)
+#else
+#define vle_trace_scope(category, name)                                       \
+    do {                                                                      \
+    } while (0)
+#define vle_trace_thread(name)                                                \
+    do {                                                                      \
+    } while (0)
+#endif
+
+#endif
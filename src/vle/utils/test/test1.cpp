@@ -35,14 +35,18 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 #include <vle/utils/Algo.hpp>
 #include <vle/utils/Array.hpp>
 #include <vle/utils/Context.hpp>
 #include <vle/utils/DateTime.hpp>
+#include <vle/utils/Memory.hpp>
 #include <vle/utils/Package.hpp>
 #include <vle/utils/Rand.hpp>
+#include <vle/utils/Symbol.hpp>
 #include <vle/utils/Tools.hpp>
+#include <vle/utils/Trace.hpp>
 #include <vle/utils/unit-test.hpp>
 #include <vle/vle.hpp>
 
@@ -201,6 +205,50 @@ test_generator()
     r.getInt(-100, 100);
     r.getDouble();
     r.getDouble(-1.0, 1.0);
+
+    /* known answers of the Philox4x32-10 reference implementation */
+    vle::utils::Philox zero(0, 0, 0);
+    EnsuresEqual(zero(), 0x6627e8d5u);
+    EnsuresEqual(zero(), 0xe169c58du);
+    EnsuresEqual(zero(), 0xbc57ac4cu);
+    EnsuresEqual(zero(), 0x9b00dbd8u);
+
+    /* the numbers of a stream do not depend on the other streams */
+    vle::utils::Rand a(42, vle::utils::Rand::stream("top:a"), 3);
+    vle::utils::Rand b = a.split(vle::utils::Rand::stream("top:b"));
+    vle::utils::Rand c(42, vle::utils::Rand::stream("top:b"), 3);
+
+    a.getDouble();
+    for (int i = 0; i != 100; ++i)
+        EnsuresEqual(b.getInt(), c.getInt());
+    Ensures(a.getInt() != b.getInt());
+
+    /* the state restores the position in the stream */
+    auto state = b.state();
+    auto expected = b.getDouble();
+    c.setState(state);
+    EnsuresEqual(c.getDouble(), expected);
+    c.gen().discard(5);
+    b.getInt();
+    b.getInt();
+    b.getInt();
+    b.getInt();
+    b.getInt();
+    EnsuresEqual(c.getInt(), b.getInt());
+
+    /* the bulk functions give the same values as the single calls */
+    std::vector<double> values(17);
+    vle::utils::Rand d(7, 1);
+    vle::utils::Rand e(7, 1);
+    d.fillDouble(values.data(), values.size());
+    for (auto elem : values) {
+        Ensures(elem >= 0.0 and elem < 1.0);
+        EnsuresEqual(elem, e.getDouble());
+    }
+
+    d.fillNormal(values.data(), values.size(), 10.0, 0.0);
+    for (auto elem : values)
+        EnsuresApproximatelyEqual(elem, 10.0, 1e-12);
 }
 
 void
@@ -503,6 +551,150 @@ test_tokenize()
     }
 }
 
+static std::size_t
+count_substring(const std::string& str, const std::string& sub)
+{
+    std::size_t result = 0;
+
+    for (auto pos = str.find(sub); pos != std::string::npos;
+         pos = str.find(sub, pos + sub.size()))
+        ++result;
+
+    return result;
+}
+
+void
+test_trace()
+{
+    vle::utils::Trace::start(4);
+    Ensures(vle::utils::Trace::enabled());
+
+    for (int i = 0; i != 6; ++i)
+        vle::utils::TraceScope scope("test", "main");
+
+    std::thread worker([]() {
+        vle::utils::Trace::thread("worker \"1\"");
+        vle::utils::TraceScope scope("test", "worker");
+    });
+    worker.join();
+
+    vle::utils::Trace::stop();
+    Ensures(not vle::utils::Trace::enabled());
+
+    {
+        vle::utils::TraceScope scope("test", "stopped");
+    }
+
+    std::ostringstream os;
+    vle::utils::Trace::write(os);
+    auto str = os.str();
+
+    EnsuresEqual(count_substring(str, "\"ph\":\"X\""), 5);
+    EnsuresEqual(count_substring(str, "\"name\":\"main\""), 4);
+    EnsuresEqual(count_substring(str, "\"name\":\"worker\""), 1);
+    EnsuresEqual(count_substring(str, "\"name\":\"stopped\""), 0);
+    EnsuresEqual(count_substring(str, "\"worker \\\"1\\\"\""), 1);
+    EnsuresEqual(count_substring(str, "\"dropped-events\":2"), 1);
+
+    vle::utils::Trace::start();
+    std::ostringstream empty;
+    vle::utils::Trace::write(empty);
+    vle::utils::Trace::stop();
+    EnsuresEqual(count_substring(empty.str(), "\"ph\""), 0);
+}
+
+struct TaggedObject : vle::utils::MemoryTagged<vle::utils::MemoryTag::vpz>
+{
+    double data[4];
+};
+
+void
+test_memory()
+{
+    using vle::utils::Memory;
+    using vle::utils::MemoryTag;
+
+    Memory::disable();
+    Memory::reset();
+
+    delete new TaggedObject;
+    EnsuresEqual(Memory::counter(MemoryTag::vpz).allocations, 0u);
+
+    Memory::enable();
+    Ensures(Memory::enabled());
+    auto thread = Memory::thread();
+
+    auto* object = new TaggedObject;
+    EnsuresEqual(Memory::counter(MemoryTag::vpz).allocations, 1u);
+    EnsuresEqual(Memory::counter(MemoryTag::vpz).live,
+                 static_cast<std::int64_t>(sizeof(TaggedObject)));
+    delete object;
+
+    auto vpz = Memory::counter(MemoryTag::vpz);
+    EnsuresEqual(vpz.deallocations, 1u);
+    EnsuresEqual(vpz.live, 0);
+    EnsuresEqual(vpz.peak, static_cast<std::int64_t>(sizeof(TaggedObject)));
+
+    {
+        std::vector<int,
+                    vle::utils::MemoryAllocator<int, MemoryTag::event>>
+          vec(100);
+        EnsuresEqual(Memory::counter(MemoryTag::event).bytes,
+                     100 * sizeof(int));
+    }
+    EnsuresEqual(Memory::counter(MemoryTag::event).live, 0);
+
+    std::thread worker([]() { delete new TaggedObject; });
+    worker.join();
+
+    EnsuresEqual(Memory::counter(MemoryTag::vpz).allocations, 2u);
+    EnsuresEqual(Memory::thread().allocations - thread.allocations, 2u);
+    EnsuresEqual(Memory::counter(MemoryTag::value).allocations, 0u);
+    EnsuresEqual(std::string(Memory::name(MemoryTag::output)), "output");
+
+    Memory::disable();
+    Memory::reset();
+}
+
+void
+test_symbol()
+{
+    using vle::utils::Symbol;
+
+    Symbol empty;
+    Ensures(empty.empty());
+    EnsuresEqual(empty.id(), 0u);
+    EnsuresEqual(empty, Symbol(""));
+
+    Symbol a("out"), b(std::string("out")), c("in");
+    Ensures(a == b);
+    Ensures(a != c);
+    EnsuresEqual(a.id(), b.id());
+    EnsuresEqual(a.str(), "out");
+    Ensures(a == std::string("out"));
+    Ensures(std::string("in") == c);
+
+    auto size = Symbol::size();
+    Symbol d("out");
+    EnsuresEqual(Symbol::size(), size);
+    Symbol e("symbol-test-new");
+    EnsuresEqual(Symbol::size(), size + 1);
+    EnsuresEqual(e.id() + 1, Symbol::size());
+
+    std::vector<Symbol> symbols(100);
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i != 4; ++i)
+        workers.emplace_back([i, &symbols]() {
+            for (std::size_t j = i; j < 100; j += 4)
+                symbols[j] = Symbol("port-" + std::to_string(j % 10));
+        });
+    for (auto& worker : workers)
+        worker.join();
+
+    for (std::size_t j = 0; j != 100; ++j)
+        EnsuresEqual(symbols[j], Symbol("port-" + std::to_string(j % 10)));
+}
+
 int
 main()
 {
@@ -523,6 +715,9 @@ main()
     test_format_copy();
     test_array();
     test_tokenize();
+    test_trace();
+    test_memory();
+    test_symbol();
 
     return unit_test::report_errors();
 }
@@ -54,6 +54,10 @@
 #include <vle/utils/unit-test.hpp>
 #include <vle/vle.hpp>
 
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
 using namespace vle;
 
 struct F
@@ -147,6 +151,63 @@ show_package(vle::utils::ContextPtr ctx)
       "show_package", vle::utils::Context::ModuleType::MODULE_DYNAMICS);
 
     Ensures(modules.size() == 1);
+
+    // The module registry is shared by all the contexts and threads of the
+    // process: each thread gets the same symbol.
+    {
+        std::vector<void*> symbols(4, nullptr);
+        std::vector<std::thread> threads;
+
+        for (std::size_t i = 0, e = symbols.size(); i != e; ++i)
+            threads.emplace_back([&ctx, &modules, &symbols, i]() {
+                auto clone = ctx->clone();
+                symbols[i] = clone->get_symbol(
+                  "show_package",
+                  modules[0].library,
+                  vle::utils::Context::ModuleType::MODULE_DYNAMICS);
+            });
+
+        for (auto& thread : threads)
+            thread.join();
+
+        Ensures(symbols[0] != nullptr);
+        for (const auto& symbol : symbols)
+            Ensures(symbol == symbols[0]);
+
+        auto version = vle::version_abi();
+        Ensures(ctx
+                  ->getHomeFile(utils::format("vle-%d.%d.modules",
+                                              std::get<0>(version),
+                                              std::get<1>(version)))
+                  .is_file());
+    }
+
+    // A context releases only its own references: the shared library stays
+    // loaded while another context uses it.
+    {
+        auto other = ctx->clone();
+
+        Ensures(ctx->get_symbol(
+                  "show_package",
+                  modules[0].library,
+                  vle::utils::Context::ModuleType::MODULE_DYNAMICS) != nullptr);
+        Ensures(other->get_symbol(
+                  "show_package",
+                  modules[0].library,
+                  vle::utils::Context::ModuleType::MODULE_DYNAMICS) != nullptr);
+
+        other->unload_dynamic_libraries();
+
+#ifndef _WIN32
+        void* handle =
+          ::dlopen(modules[0].path.string().c_str(), RTLD_LAZY | RTLD_NOLOAD);
+        Ensures(handle != nullptr);
+        if (handle)
+            ::dlclose(handle);
+#endif
+
+        ctx->unload_dynamic_libraries();
+    }
 }
 
 void
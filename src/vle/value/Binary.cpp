@@ -0,0 +1,575 @@
+/*
+ * This file is part of VLE, a framework for multi-modeling, simulation
+ * and analysis of complex dynamical systems.
+ * http://www.vle-project.org
+ *
+ * Copyright (c) 2003-2017 Gauthier Quesnel <gauthier.quesnel@inra.fr>
+ * Copyright (c) 2003-2017 ULCO http://www.univ-littoral.fr
+ * Copyright (c) 2007-2017 INRA http://www.inra.fr
+ *
+ * See the AUTHORS or Authors.txt file for copyright owners and
+ * contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include <vle/utils/Exception.hpp>
+#include <vle/utils/i18n.hpp>
+#include <vle/value/Binary.hpp>
+#include <vle/value/Boolean.hpp>
+#include <vle/value/Double.hpp>
+#include <vle/value/Integer.hpp>
+#include <vle/value/Map.hpp>
+#include <vle/value/Matrix.hpp>
+#include <vle/value/Null.hpp>
+#include <vle/value/Set.hpp>
+#include <vle/value/String.hpp>
+#include <vle/value/Table.hpp>
+#include <vle/value/Tuple.hpp>
+#include <vle/value/XML.hpp>
+
+namespace {
+
+enum binary_tag : std::uint8_t
+{
+    TAG_NIL = 0,
+    TAG_BOOLEAN,
+    TAG_INTEGER,
+    TAG_DOUBLE,
+    TAG_STRING,
+    TAG_SET,
+    TAG_MAP,
+    TAG_TUPLE,
+    TAG_TABLE,
+    TAG_XML,
+    TAG_MATRIX,
+    TAG_MATRIX_DOUBLE,
+    TAG_EMPTY
+};
+
+inline bool
+pp_is_little_endian() noexcept
+{
+    const std::uint16_t x = 1;
+    return *reinterpret_cast<const unsigned char*>(&x) == 1;
+}
+
+template <typename T>
+inline void
+pp_swap_if_big_endian(T& value) noexcept
+{
+    if (not pp_is_little_endian()) {
+        auto* bytes = reinterpret_cast<unsigned char*>(&value);
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+}
+
+struct stream_writer
+{
+    std::ostream& os;
+
+    void write(const void* data, std::size_t size)
+    {
+        os.write(static_cast<const char*>(data), size);
+    }
+};
+
+struct string_writer
+{
+    std::string& str;
+
+    void write(const void* data, std::size_t size)
+    {
+        str.append(static_cast<const char*>(data), size);
+    }
+};
+
+struct stream_reader
+{
+    std::istream& is;
+
+    void read(void* data, std::size_t size)
+    {
+        is.read(static_cast<char*>(data), size);
+
+        if (static_cast<std::size_t>(is.gcount()) != size)
+            throw vle::utils::ArgError(_("Binary: unexpected end of stream"));
+    }
+
+    void check(std::size_t /*size*/) const noexcept
+    {
+    }
+
+    /* The size of a stream is unknown. */
+    std::size_t remaining() const noexcept
+    {
+        return 0;
+    }
+};
+
+struct memory_reader
+{
+    const char* buffer;
+    std::size_t size;
+    std::size_t offset;
+
+    void read(void* data, std::size_t length)
+    {
+        check(length);
+        std::memcpy(data, buffer + offset, length);
+        offset += length;
+    }
+
+    /* Avoids allocating the huge containers announced by a truncated or
+     * corrupted buffer. */
+    void check(std::size_t length) const
+    {
+        if (length > size - offset)
+            throw vle::utils::ArgError(_("Binary: unexpected end of buffer"));
+    }
+
+    std::size_t remaining() const noexcept
+    {
+        return size - offset;
+    }
+};
+
+/* The cells reserved by a matrix read from a buffer are limited to the
+ * largest of this number and the remaining bytes of the buffer. */
+constexpr std::size_t pp_matrix_capacity = 1024 * 1024;
+
+/* Multiplies two sizes read from a buffer: only a corrupted buffer
+ * announces a product that overflows. */
+inline std::size_t
+pp_multiply(std::size_t lhs, std::size_t rhs)
+{
+    if (rhs != 0 and lhs > std::numeric_limits<std::size_t>::max() / rhs)
+        throw vle::utils::ArgError(_("Binary: size overflow"));
+
+    return lhs * rhs;
+}
+
+template <typename Writer>
+inline void
+pp_put_tag(Writer& w, binary_tag tag)
+{
+    w.write(&tag, 1);
+}
+
+template <typename Writer>
+inline void
+pp_put_size(Writer& w, std::size_t size)
+{
+    std::uint64_t value = size;
+    pp_swap_if_big_endian(value);
+    w.write(&value, sizeof(value));
+}
+
+template <typename Writer>
+inline void
+pp_put_double(Writer& w, double value)
+{
+    pp_swap_if_big_endian(value);
+    w.write(&value, sizeof(value));
+}
+
+template <typename Writer>
+inline void
+pp_put_doubles(Writer& w, const double* values, std::size_t size)
+{
+    if (pp_is_little_endian())
+        w.write(values, size * sizeof(double));
+    else
+        for (std::size_t i = 0; i != size; ++i)
+            pp_put_double(w, values[i]);
+}
+
+template <typename Writer>
+inline void
+pp_put_string(Writer& w, const std::string& str)
+{
+    pp_put_size(w, str.size());
+    w.write(str.data(), str.size());
+}
+
+template <typename Reader>
+inline binary_tag
+pp_get_tag(Reader& r)
+{
+    std::uint8_t tag;
+    r.read(&tag, 1);
+
+    if (tag > TAG_EMPTY)
+        throw vle::utils::ArgError(
+          (vle::fmt(_("Binary: unknown tag %1%")) % static_cast<int>(tag))
+            .str());
+
+    return static_cast<binary_tag>(tag);
+}
+
+template <typename Reader>
+inline std::size_t
+pp_get_size(Reader& r)
+{
+    std::uint64_t value;
+    r.read(&value, sizeof(value));
+    pp_swap_if_big_endian(value);
+    return static_cast<std::size_t>(value);
+}
+
+template <typename Reader>
+inline double
+pp_get_double(Reader& r)
+{
+    double value;
+    r.read(&value, sizeof(value));
+    pp_swap_if_big_endian(value);
+    return value;
+}
+
+template <typename Reader>
+inline void
+pp_get_doubles(Reader& r, double* values, std::size_t size)
+{
+    if (pp_is_little_endian())
+        r.read(values, size * sizeof(double));
+    else
+        for (std::size_t i = 0; i != size; ++i)
+            values[i] = pp_get_double(r);
+}
+
+template <typename Reader>
+inline void
+pp_get_string(Reader& r, std::string& str)
+{
+    auto size = pp_get_size(r);
+    r.check(size);
+    str.resize(size);
+
+    if (size)
+        r.read(&str[0], size);
+}
+
+bool
+pp_is_double_matrix(const vle::value::Matrix& matrix)
+{
+    for (std::size_t row = 0; row != matrix.rows(); ++row)
+        for (std::size_t col = 0; col != matrix.columns(); ++col) {
+            const auto& cell = matrix.get(col, row);
+            if (not cell or not cell->isDouble())
+                return false;
+        }
+
+    return true;
+}
+
+template <typename Writer>
+void
+pp_write(Writer& w, const vle::value::Value* value)
+{
+    using vle::value::Value;
+
+    if (not value) {
+        pp_put_tag(w, TAG_EMPTY);
+        return;
+    }
+
+    switch (value->getType()) {
+    case Value::NIL:
+        pp_put_tag(w, TAG_NIL);
+        break;
+    case Value::BOOLEAN: {
+        pp_put_tag(w, TAG_BOOLEAN);
+        std::uint8_t b = value->toBoolean().value() ? 1 : 0;
+        w.write(&b, 1);
+    } break;
+    case Value::INTEGER: {
+        pp_put_tag(w, TAG_INTEGER);
+        std::int32_t i = value->toInteger().value();
+        pp_swap_if_big_endian(i);
+        w.write(&i, sizeof(i));
+    } break;
+    case Value::DOUBLE:
+        pp_put_tag(w, TAG_DOUBLE);
+        pp_put_double(w, value->toDouble().value());
+        break;
+    case Value::STRING:
+        pp_put_tag(w, TAG_STRING);
+        pp_put_string(w, value->toString().value());
+        break;
+    case Value::XMLTYPE:
+        pp_put_tag(w, TAG_XML);
+        pp_put_string(w, value->toXml().value());
+        break;
+    case Value::SET: {
+        const auto& set = value->toSet();
+        pp_put_tag(w, TAG_SET);
+        pp_put_size(w, set.size());
+        for (const auto& elem : set)
+            pp_write(w, elem.get());
+    } break;
+    case Value::MAP: {
+        const auto& map = value->toMap();
+        pp_put_tag(w, TAG_MAP);
+        pp_put_size(w, map.size());
+        for (const auto& elem : map) {
+            pp_put_string(w, elem.first);
+            pp_write(w, elem.second.get());
+        }
+    } break;
+    case Value::TUPLE: {
+        const auto& tuple = value->toTuple().value();
+        pp_put_tag(w, TAG_TUPLE);
+        pp_put_size(w, tuple.size());
+        pp_put_doubles(w, tuple.data(), tuple.size());
+    } break;
+    case Value::TABLE: {
+        const auto& table = value->toTable();
+        pp_put_tag(w, TAG_TABLE);
+        pp_put_size(w, table.width());
+        pp_put_size(w, table.height());
+        pp_put_doubles(w, table.value().data(), table.value().size());
+    } break;
+    case Value::MATRIX: {
+        const auto& matrix = value->toMatrix();
+        const bool only_double = pp_is_double_matrix(matrix);
+
+        pp_put_tag(w, only_double ? TAG_MATRIX_DOUBLE : TAG_MATRIX);
+        pp_put_size(w, matrix.columns());
+        pp_put_size(w, matrix.rows());
+        pp_put_size(w, matrix.columns_max());
+        pp_put_size(w, matrix.rows_max());
+        pp_put_size(w, matrix.resizeColumn());
+        pp_put_size(w, matrix.resizeRow());
+
+        if (only_double) {
+            std::vector<double> cells;
+            cells.reserve(matrix.columns() * matrix.rows());
+
+            for (std::size_t row = 0; row != matrix.rows(); ++row)
+                for (std::size_t col = 0; col != matrix.columns(); ++col)
+                    cells.push_back(matrix.get(col, row)->toDouble().value());
+
+            pp_put_doubles(w, cells.data(), cells.size());
+        } else {
+            for (std::size_t row = 0; row != matrix.rows(); ++row)
+                for (std::size_t col = 0; col != matrix.columns(); ++col)
+                    pp_write(w, matrix.get(col, row).get());
+        }
+    } break;
+    case Value::USER:
+        throw vle::utils::ArgError(_("Binary: can not write a user value"));
+    }
+}
+
+template <typename Reader>
+std::unique_ptr<vle::value::Value>
+pp_read_matrix(Reader& r, bool only_double);
+
+template <typename Reader>
+std::unique_ptr<vle::value::Value>
+pp_read(Reader& r)
+{
+    namespace vv = vle::value;
+
+    switch (pp_get_tag(r)) {
+    case TAG_EMPTY:
+        return {};
+    case TAG_NIL:
+        return std::unique_ptr<vv::Value>(new vv::Null());
+    case TAG_BOOLEAN: {
+        std::uint8_t b;
+        r.read(&b, 1);
+        return std::unique_ptr<vv::Value>(new vv::Boolean(b != 0));
+    }
+    case TAG_INTEGER: {
+        std::int32_t i;
+        r.read(&i, sizeof(i));
+        pp_swap_if_big_endian(i);
+        return std::unique_ptr<vv::Value>(new vv::Integer(i));
+    }
+    case TAG_DOUBLE:
+        return std::unique_ptr<vv::Value>(new vv::Double(pp_get_double(r)));
+    case TAG_STRING: {
+        auto ret = std::unique_ptr<vv::String>(new vv::String());
+        pp_get_string(r, ret->value());
+        return ret;
+    }
+    case TAG_XML: {
+        auto ret = std::unique_ptr<vv::Xml>(new vv::Xml());
+        pp_get_string(r, ret->value());
+        return ret;
+    }
+    case TAG_SET: {
+        auto size = pp_get_size(r);
+        r.check(size);
+        auto ret = std::unique_ptr<vv::Set>(new vv::Set());
+        ret->value().reserve(size);
+        for (std::size_t i = 0; i != size; ++i)
+            ret->add(pp_read(r));
+        return ret;
+    }
+    case TAG_MAP: {
+        auto size = pp_get_size(r);
+        r.check(size);
+        auto ret = std::unique_ptr<vv::Map>(new vv::Map());
+        ret->reserve(size);
+        std::string key;
+        for (std::size_t i = 0; i != size; ++i) {
+            pp_get_string(r, key);
+            ret->add(key, pp_read(r));
+        }
+        return ret;
+    }
+    case TAG_TUPLE: {
+        auto size = pp_get_size(r);
+        r.check(pp_multiply(size, sizeof(double)));
+        auto ret = std::unique_ptr<vv::Tuple>(new vv::Tuple(size));
+        pp_get_doubles(r, ret->value().data(), size);
+        return ret;
+    }
+    case TAG_TABLE: {
+        auto width = pp_get_size(r);
+        auto height = pp_get_size(r);
+        auto size = pp_multiply(width, height);
+        r.check(pp_multiply(size, sizeof(double)));
+        auto ret = std::unique_ptr<vv::Table>(new vv::Table());
+        ret->resize(width, height);
+        pp_get_doubles(r, ret->value().data(), size);
+        return ret;
+    }
+    case TAG_MATRIX:
+        return pp_read_matrix(r, false);
+    case TAG_MATRIX_DOUBLE:
+        return pp_read_matrix(r, true);
+    }
+
+    return {};
+}
+
+template <typename Reader>
+std::unique_ptr<vle::value::Value>
+pp_read_matrix(Reader& r, bool only_double)
+{
+    namespace vv = vle::value;
+
+    auto columns = pp_get_size(r);
+    auto rows = pp_get_size(r);
+    auto columnmax = pp_get_size(r);
+    auto rowmax = pp_get_size(r);
+    auto stepcol = pp_get_size(r);
+    auto steprow = pp_get_size(r);
+
+    /* A cell uses at least one byte (a tag) or a double. */
+    auto size = pp_multiply(columns, rows);
+    r.check(only_double ? pp_multiply(size, sizeof(double)) : size);
+
+    /* The reserved capacity is checked before the matrix allocates it. A
+     * too large capacity is dropped, the matrix grows by its steps. */
+    auto capacity = pp_multiply(columnmax, rowmax);
+    if (capacity != 0 and (columnmax < columns or rowmax < rows))
+        throw vle::utils::ArgError(_("Binary: bad matrix capacity"));
+
+    std::unique_ptr<vv::Matrix> ret;
+    if (capacity == 0 or
+        capacity > std::max(r.remaining(), pp_matrix_capacity))
+        ret.reset(new vv::Matrix(columns, rows, stepcol, steprow));
+    else
+        ret.reset(
+          new vv::Matrix(columns, rows, columnmax, rowmax, stepcol, steprow));
+
+    if (only_double) {
+        std::vector<double> cells(size);
+        pp_get_doubles(r, cells.data(), size);
+
+        /* The matrix stores one value per cell. */
+        auto& values = ret->value();
+        const auto stride = ret->columns_max();
+        for (std::size_t row = 0; row != rows; ++row)
+            for (std::size_t col = 0; col != columns; ++col)
+                values[row * stride + col].reset(
+                  new vv::Double(cells[row * columns + col]));
+    } else {
+        for (std::size_t row = 0; row != rows; ++row)
+            for (std::size_t col = 0; col != columns; ++col)
+                ret->set(col, row, pp_read(r));
+    }
+
+    return ret;
+}
+} // anonymous namespace
+
+namespace vle {
+namespace value {
+
+void
+writeBinary(std::ostream& out, const Value& value)
+{
+    stream_writer w{ out };
+    pp_write(w, &value);
+}
+
+void
+writeBinary(std::string& out, const Value& value)
+{
+    string_writer w{ out };
+    pp_write(w, &value);
+}
+
+std::string
+toBinary(const Value& value)
+{
+    std::string ret;
+    writeBinary(ret, value);
+    return ret;
+}
+
+std::unique_ptr<Value>
+readBinary(std::istream& in)
+{
+    stream_reader r{ in };
+    return pp_read(r);
+}
+
+std::unique_ptr<Value>
+readBinary(const char* buffer, std::size_t size, std::size_t& offset)
+{
+    if (offset > size)
+        throw utils::ArgError(_("Binary: offset out of buffer"));
+
+    memory_reader r{ buffer, size, offset };
+    auto ret = pp_read(r);
+    offset = r.offset;
+
+    return ret;
+}
+
+std::unique_ptr<Value>
+fromBinary(const std::string& buffer)
+{
+    std::size_t offset = 0;
+    auto ret = readBinary(buffer.data(), buffer.size(), offset);
+
+    if (offset != buffer.size())
+        throw utils::ArgError(_("Binary: bytes remain after the value"));
+
+    return ret;
+}
+}
+} // namespace vle value
@@ -0,0 +1,128 @@
+/*
+ * This file is part of VLE, a framework for multi-modeling, simulation
+ * and analysis of complex dynamical systems.
+ * http://www.vle-project.org
+ *
+ * Copyright (c) 2003-2017 Gauthier Quesnel <gauthier.quesnel@inra.fr>
+ * Copyright (c) 2003-2017 ULCO http://www.univ-littoral.fr
+ * Copyright (c) 2007-2017 INRA http://www.inra.fr
+ *
+ * See the AUTHORS or Authors.txt file for copyright owners and
+ * contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VLE_VALUE_BINARY_HPP
+#define VLE_VALUE_BINARY_HPP 1
+
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vle/DllDefines.hpp>
+#include <vle/value/Value.hpp>
+
+namespace vle {
+namespace value {
+
+/**
+ * @brief Compact binary representation of the value::Value trees. It is
+ * an alternative to the writeXml/vpz::Vpz::parseValue round trip for
+ * the values exchanged between processes or stored on disk.
+ *
+ * Each value starts with a one byte tag followed by its data. Integers
+ * and sizes are little-endian (int32 for Integer, uint64 for sizes),
+ * doubles are little-endian IEEE 754:
+ * - Null: tag only.
+ * - Boolean: one byte.
+ * - Integer, Double: the number.
+ * - String, Xml: size and bytes.
+ * - Set: size and the values.
+ * - Map: size and pairs of (size and bytes of the key, value).
+ * - Tuple: size and the doubles in one block.
+ * - Table: width, height and the doubles in one block.
+ * - Matrix: columns, rows, columns max, rows max, resize columns, resize
+ *   rows and the columns x rows cells, row by row. When all the cells are
+ *   Double, a dedicated tag stores the doubles in one block.
+ * - an empty cell (nullptr) of Set or Matrix: tag only.
+ *
+ * User values can not be encoded.
+ */
+
+/**
+ * @brief Append the binary representation of the value to the stream.
+ * Several values can be written one after the other in the same stream.
+ * @param out The output stream (opened in binary mode).
+ * @param value The value to write.
+ * @throw utils::ArgError if the value or a sub-value is a User.
+ */
+VLE_API void
+writeBinary(std::ostream& out, const Value& value);
+
+/**
+ * @brief Append the binary representation of the value to the buffer.
+ * @param out The buffer.
+ * @param value The value to write.
+ * @throw utils::ArgError if the value or a sub-value is a User.
+ */
+VLE_API void
+writeBinary(std::string& out, const Value& value);
+
+/**
+ * @brief Build the binary representation of the value.
+ * @param value The value to write.
+ * @throw utils::ArgError if the value or a sub-value is a User.
+ * @return A buffer of bytes.
+ */
+VLE_API std::string
+toBinary(const Value& value);
+
+/**
+ * @brief Read the next value from the stream. Doubles of Tuple, Table and
+ * Matrix are read directly into the storage of the new value.
+ * @param in The input stream (opened in binary mode).
+ * @throw utils::ArgError if the stream does not contain a value.
+ * @return The new value.
+ */
+VLE_API std::unique_ptr<Value>
+readBinary(std::istream& in);
+
+/**
+ * @brief Read the value stored at @e offset in the buffer and move @e
+ * offset after it. Doubles of Tuple, Table and Matrix are copied directly
+ * from the buffer into the storage of the new value.
+ * @param buffer The buffer.
+ * @param size The size in bytes of the buffer.
+ * @param offset The position of the value in the buffer.
+ * @throw utils::ArgError if the buffer does not contain a value at @e
+ * offset.
+ * @return The new value.
+ */
+VLE_API std::unique_ptr<Value>
+readBinary(const char* buffer, std::size_t size, std::size_t& offset);
+
+/**
+ * @brief Read the value stored in the buffer.
+ * @param buffer The buffer filled by writeBinary or toBinary.
+ * @throw utils::ArgError if the buffer does not contain a value or if
+ * bytes remain after the value.
+ * @return The new value.
+ */
+VLE_API std::unique_ptr<Value>
+fromBinary(const std::string& buffer);
+}
+} // namespace vle value
+
+#endif
@@ -24,6 +24,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <stdexcept>
 #include <vle/utils/Exception.hpp>
 #include <vle/utils/i18n.hpp>
 #include <vle/value/Boolean.hpp>
@@ -107,12 +109,148 @@ pp_add(vle::value::MapValue& m, const std::string& name, Args&&... args)
 namespace vle {
 namespace value {
 
+constexpr MapValue::size_type MapValue::small_size;
+constexpr MapValue::size_type MapValue::small_reserve;
+
+MapValue::mapped_type&
+MapValue::at(const std::string& key)
+{
+    auto position = find_position(key);
+
+    if (position == m_values.size())
+        throw std::out_of_range(key);
+
+    return m_values[position].second;
+}
+
+const MapValue::mapped_type&
+MapValue::at(const std::string& key) const
+{
+    auto position = find_position(key);
+
+    if (position == m_values.size())
+        throw std::out_of_range(key);
+
+    return m_values[position].second;
+}
+
+MapValue::mapped_type& MapValue::operator[](const std::string& key)
+{
+    return emplace(key, mapped_type()).first->second;
+}
+
+std::pair<MapValue::iterator, bool>
+MapValue::emplace(const std::string& key, mapped_type value)
+{
+    if (m_index) {
+        auto it = m_index->find(key);
+        if (it != m_index->end())
+            return { m_values.begin() + it->second, false };
+
+        m_index->emplace(key, m_values.size());
+        m_values.emplace_back(key, std::move(value));
+        return { m_values.end() - 1, true };
+    }
+
+    size_type position = 0;
+    for (size_type e = m_values.size(); position != e; ++position) {
+        int cmp = m_values[position].first.compare(key);
+        if (cmp == 0)
+            return { m_values.begin() + position, false };
+        if (cmp > 0)
+            break;
+    }
+
+    if (m_values.capacity() == 0)
+        m_values.reserve(small_reserve);
+
+    m_values.emplace(m_values.begin() + position, key, std::move(value));
+
+    if (m_values.size() > small_size)
+        build_index();
+
+    return { m_values.begin() + position, true };
+}
+
+std::pair<MapValue::iterator, bool>
+MapValue::insert(value_type pair)
+{
+    return emplace(pair.first, std::move(pair.second));
+}
+
+MapValue::size_type
+MapValue::erase(const std::string& key)
+{
+    auto position = find_position(key);
+
+    if (position == m_values.size())
+        return 0;
+
+    erase_position(position);
+
+    if (m_index and m_values.size() <= small_size) {
+        m_index.reset();
+        std::sort(m_values.begin(),
+                  m_values.end(),
+                  [](const value_type& lhs, const value_type& rhs) {
+                      return lhs.first < rhs.first;
+                  });
+    }
+
+    return 1;
+}
+
+MapValue::iterator
+MapValue::erase(const_iterator it)
+{
+    auto position =
+      static_cast<size_type>(std::distance(m_values.cbegin(), it));
+
+    erase_position(position);
+
+    return m_values.begin() + position;
+}
+
+void
+MapValue::erase_position(size_type position)
+{
+    if (not m_index) {
+        m_values.erase(m_values.begin() + position);
+        return;
+    }
+
+    m_index->erase(m_values[position].first);
+
+    if (position + 1 != m_values.size()) {
+        m_values[position] = std::move(m_values.back());
+        m_index->find(m_values[position].first)->second = position;
+    }
+
+    m_values.pop_back();
+}
+
+void
+MapValue::build_index()
+{
+    if (not m_index)
+        m_index.reset(new std::unordered_map<std::string, size_type>());
+
+    m_index->clear();
+    m_index->reserve(m_values.size());
+
+    for (size_type i = 0, e = m_values.size(); i != e; ++i)
+        m_index->emplace(m_values[i].first, i);
+}
+
 Map::Map(const Map& orig)
   : Value(orig)
 {
+    m_value.reserve(orig.size());
+
     for (const auto& elem : orig.m_value)
-        m_value[elem.first] =
-          std::unique_ptr<Value>(elem.second ? elem.second->clone() : nullptr);
+        m_value.emplace(
+          elem.first,
+          std::unique_ptr<Value>(elem.second ? elem.second->clone() : nullptr));
 }
 
 std::unique_ptr<Value>
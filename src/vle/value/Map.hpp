@@ -28,6 +28,8 @@
 #define VLE_VALUE_MAP_HPP 1
 
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include <vle/DllDefines.hpp>
 #include <vle/value/Value.hpp>
 
@@ -36,8 +38,180 @@ namespace value {
 
 /**
  * @brief Define a list of Value in a dictionnary.
+ *
+ * The pairs (key, value) are stored in a single array. Up to @e
+ * small_size keys, the common size of the maps sent in events, the array
+ * is sorted by keys and lookups scan it without hashing nor per-key
+ * allocation. Beyond, new keys are appended and a hash index from keys
+ * to positions is built.
+ *
+ * The interface follows std::unordered_map but inserting or erasing a key
+ * invalidates iterators and references to the pairs (not to the values).
  */
-using MapValue = std::unordered_map<std::string, std::unique_ptr<Value>>;
+class VLE_API MapValue
+{
+public:
+    using key_type = std::string;
+    using mapped_type = std::unique_ptr<Value>;
+    using value_type = std::pair<std::string, std::unique_ptr<Value>>;
+    using container_type = std::vector<value_type>;
+    using size_type = container_type::size_type;
+    using iterator = container_type::iterator;
+    using const_iterator = container_type::const_iterator;
+
+    /** Maximum number of keys stored without hash index. */
+    static constexpr size_type small_size = 8;
+
+    /** Capacity allocated by the first insertion. */
+    static constexpr size_type small_reserve = 4;
+
+    MapValue() = default;
+    MapValue(MapValue&& other) = default;
+    MapValue& operator=(MapValue&& other) = default;
+    MapValue(const MapValue& other) = delete;
+    MapValue& operator=(const MapValue& other) = delete;
+    ~MapValue() = default;
+
+    iterator begin() noexcept
+    {
+        return m_values.begin();
+    }
+
+    iterator end() noexcept
+    {
+        return m_values.end();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return m_values.begin();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return m_values.end();
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return m_values.cbegin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return m_values.cend();
+    }
+
+    bool empty() const noexcept
+    {
+        return m_values.empty();
+    }
+
+    size_type size() const noexcept
+    {
+        return m_values.size();
+    }
+
+    /**
+     * @brief Allocates the array for @e size keys at once, useful to
+     * build a map whose size is known.
+     */
+    void reserve(size_type size)
+    {
+        m_values.reserve(size);
+    }
+
+    void clear() noexcept
+    {
+        m_values.clear();
+        m_index.reset();
+    }
+
+    iterator find(const std::string& key)
+    {
+        return m_values.begin() + find_position(key);
+    }
+
+    const_iterator find(const std::string& key) const
+    {
+        return m_values.begin() + find_position(key);
+    }
+
+    size_type count(const std::string& key) const
+    {
+        return find_position(key) != m_values.size() ? 1 : 0;
+    }
+
+    /**
+     * @brief Get the value of the key.
+     * @throw std::out_of_range if the key does not exist.
+     */
+    mapped_type& at(const std::string& key);
+
+    const mapped_type& at(const std::string& key) const;
+
+    /**
+     * @brief Get the value of the key, insert an empty value if the key
+     * does not exist.
+     */
+    mapped_type& operator[](const std::string& key);
+
+    /**
+     * @brief Insert the pair if the key does not exist.
+     * @return An iterator to the pair of the key and true if the pair was
+     * inserted.
+     */
+    std::pair<iterator, bool> emplace(const std::string& key,
+                                      mapped_type value);
+
+    std::pair<iterator, bool> insert(value_type pair);
+
+    /**
+     * @brief Erase the pair of the key. Below @e small_size keys, the hash
+     * index is dropped and the array is sorted again.
+     * @return 1 if the key was erased, 0 otherwise.
+     */
+    size_type erase(const std::string& key);
+
+    /**
+     * @brief Erase the pair. With a hash index, the last pair is moved into
+     * its place so the index is updated for two keys only. The pairs not
+     * yet visited by an iteration are at or after the returned iterator,
+     * the index is kept until the next erase by key or clear().
+     * @return An iterator to the pair that follows the erased one.
+     */
+    iterator erase(const_iterator it);
+
+private:
+    container_type m_values;
+    std::unique_ptr<std::unordered_map<std::string, size_type>> m_index;
+
+    /**
+     * @brief Returns the position of the key or size() if the key does not
+     * exist.
+     */
+    size_type find_position(const std::string& key) const noexcept
+    {
+        if (m_index) {
+            auto it = m_index->find(key);
+            return it == m_index->end() ? m_values.size() : it->second;
+        }
+
+        for (size_type i = 0, e = m_values.size(); i != e; ++i) {
+            int cmp = m_values[i].first.compare(key);
+            if (cmp == 0)
+                return i;
+            if (cmp > 0)
+                break;
+        }
+
+        return m_values.size();
+    }
+
+    void build_index();
+
+    void erase_position(size_type position);
+};
 
 /**
  * @brief Map Value a container to a pair of std::string, Value pointer. The
@@ -219,6 +393,15 @@ public:
         m_value.clear();
     }
 
+    /**
+     * @brief Allocates the storage for @e size keys at once.
+     * @param size The number of keys.
+     */
+    void reserve(size_type size)
+    {
+        m_value.reserve(size);
+    }
+
     /**
      * @brief Return true if the value::Map does not contain any element.
      * @return True if empty, false otherwise.
@@ -0,0 +1,53 @@
+/*
+ * This file is part of VLE, a framework for multi-modeling, simulation
+ * and analysis of complex dynamical systems.
+ * http://www.vle-project.org
+ *
+ * Copyright (c) 2003-2017 Gauthier Quesnel <gauthier.quesnel@inra.fr>
+ * Copyright (c) 2003-2017 ULCO http://www.univ-littoral.fr
+ * Copyright (c) 2007-2017 INRA http://www.inra.fr
+ *
+ * See the AUTHORS or Authors.txt file for copyright owners and
+ * contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vle/utils/Exception.hpp>
+#include <vle/value/Binary.hpp>
+#include <vle/value/Pool.hpp>
+
+namespace vle {
+namespace value {
+
+std::shared_ptr<Value>
+Pool::share(std::shared_ptr<Value> value)
+{
+    if (not value or value->isUser())
+        return value;
+
+    std::string key;
+
+    try {
+        writeBinary(key, *value);
+    } catch (const utils::ArgError&) {
+        return value; // A sub-value is a User.
+    }
+
+    auto it = m_values.emplace(std::move(key), value);
+
+    return it.first->second;
+}
+}
+} // namespace vle value
@@ -0,0 +1,97 @@
+/*
+ * This file is part of VLE, a framework for multi-modeling, simulation
+ * and analysis of complex dynamical systems.
+ * http://www.vle-project.org
+ *
+ * Copyright (c) 2003-2017 Gauthier Quesnel <gauthier.quesnel@inra.fr>
+ * Copyright (c) 2003-2017 ULCO http://www.univ-littoral.fr
+ * Copyright (c) 2007-2017 INRA http://www.inra.fr
+ *
+ * See the AUTHORS or Authors.txt file for copyright owners and
+ * contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VLE_VALUE_POOL_HPP
+#define VLE_VALUE_POOL_HPP 1
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vle/DllDefines.hpp>
+#include <vle/value/Value.hpp>
+
+namespace vle {
+namespace value {
+
+/**
+ * @brief A Pool hash-conses value::Value: equal values given to share()
+ * are replaced by a single instance. Two values are equal if their binary
+ * representations (see value::toBinary) are equal. A shared value must be
+ * considered immutable, vpz::Condition::valueForWrite copies it before
+ * any modification.
+ *
+ * User values and values that contain a User value are never shared.
+ *
+ * @code
+ * value::Pool pool;
+ * auto a = pool.share(std::make_shared<value::Double>(1.0));
+ * auto b = pool.share(std::make_shared<value::Double>(1.0));
+ * assert(a == b);
+ * @endcode
+ */
+class VLE_API Pool
+{
+public:
+    using size_type = std::size_t;
+
+    Pool() = default;
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+    ~Pool() = default;
+
+    /**
+     * @brief Get the instance of the pool equal to @e value. If the pool
+     * does not contain such a value, @e value is added to the pool.
+     * @param value The value to share.
+     * @return The shared instance or @e value if it can not be shared.
+     */
+    std::shared_ptr<Value> share(std::shared_ptr<Value> value);
+
+    /**
+     * @brief Get the number of distinct values in the pool.
+     * @return The size of the pool.
+     */
+    size_type size() const noexcept
+    {
+        return m_values.size();
+    }
+
+    /**
+     * @brief Remove all values from the pool. Shared values remain shared
+     * by their owners.
+     */
+    void clear() noexcept
+    {
+        m_values.clear();
+    }
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<Value>> m_values;
+};
+}
+} // namespace vle value
+
+#endif
@@ -31,6 +31,7 @@
 #include <ostream>
 #include <string>
 #include <vle/DllDefines.hpp>
+#include <vle/utils/Memory.hpp>
 
 namespace vle {
 namespace value {
@@ -52,7 +53,7 @@ class User;
 /**
  * @brief Virtual class to assign Value into Event object.
  */
-class VLE_API Value
+class VLE_API Value : public utils::MemoryTagged<utils::MemoryTag::value>
 {
 public:
     enum type
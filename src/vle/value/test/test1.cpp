@@ -26,13 +26,16 @@
 
 #include <boost/lexical_cast.hpp>
 #include <boost/utility.hpp>
+#include <cstdint>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <limits>
+#include <sstream>
 #include <stdexcept>
 #include <vle/utils/Exception.hpp>
 #include <vle/utils/unit-test.hpp>
+#include <vle/value/Binary.hpp>
 #include <vle/value/Boolean.hpp>
 #include <vle/value/Double.hpp>
 #include <vle/value/Integer.hpp>
@@ -116,6 +119,78 @@ check_map_value()
     EnsuresThrow(mp->getInt("xml"), utils::CastError);
 }
 
+void
+check_map_layout()
+{
+    value::Map mp;
+
+    for (int i = 0; i != 5; ++i)
+        mp.addInt(std::to_string(4 - i), i);
+
+    {
+        std::string previous;
+        for (const auto& elem : mp) {
+            Ensures(previous < elem.first);
+            previous = elem.first;
+        }
+    }
+
+    for (int i = 5; i != 100; ++i)
+        mp.addInt(std::to_string(i), i);
+
+    EnsuresEqual(mp.size(), 100u);
+    for (int i = 0; i != 100; ++i)
+        EnsuresEqual(mp.getInt(std::to_string(i)), i < 5 ? 4 - i : i);
+
+    mp.addInt("50", -50);
+    EnsuresEqual(mp.size(), 100u);
+    EnsuresEqual(mp.getInt("50"), -50);
+
+    for (int i = 10; i != 100; ++i)
+        EnsuresEqual(mp.value().erase(std::to_string(i)), 1u);
+
+    EnsuresEqual(mp.size(), 10u);
+    EnsuresEqual(mp.value().erase("10"), 0u);
+    EnsuresEqual(mp.getInt("9"), 9);
+    EnsuresThrow(mp.getInt("10"), utils::ArgError);
+    EnsuresThrow(mp.value().at("10"), std::out_of_range);
+
+    for (int i = 2; i != 10; ++i)
+        mp.value().erase(std::to_string(i));
+
+    EnsuresEqual(mp.size(), 2u);
+    EnsuresEqual(mp.begin()->first, "0");
+    EnsuresEqual(mp.getInt("1"), 3);
+
+    value::Map cpy(mp);
+    EnsuresEqual(cpy.size(), 2u);
+    EnsuresEqual(cpy.getInt("0"), 4);
+
+    mp.clear();
+    Ensures(mp.empty());
+    mp.addDouble("d_val", 1.0);
+    EnsuresEqual(mp.getDouble("d_val"), 1.0);
+
+    /* erasing while iterating visits each pair once, even below
+     * small_size keys */
+    mp.clear();
+    for (int i = 0; i != 20; ++i)
+        mp.addInt(std::to_string(i), i);
+
+    int visited = 0;
+    for (auto it = mp.value().begin(); it != mp.value().end(); ++visited) {
+        if (it->second->toInteger().value() != 7)
+            it = mp.value().erase(it);
+        else
+            ++it;
+    }
+
+    EnsuresEqual(visited, 20);
+    EnsuresEqual(mp.size(), 1u);
+    EnsuresEqual(mp.getInt("7"), 7);
+    EnsuresThrow(mp.getInt("8"), utils::ArgError);
+}
+
 void
 check_set_value()
 {
@@ -410,6 +485,202 @@ test_table()
     Ensures(t(0, 2) == 4.);
 }
 
+bool
+equal_values(const value::Value* lhs, const value::Value* rhs)
+{
+    if (not lhs or not rhs)
+        return lhs == rhs;
+
+    if (lhs->getType() != rhs->getType())
+        return false;
+
+    switch (lhs->getType()) {
+    case value::Value::BOOLEAN:
+        return lhs->toBoolean().value() == rhs->toBoolean().value();
+    case value::Value::INTEGER:
+        return lhs->toInteger().value() == rhs->toInteger().value();
+    case value::Value::DOUBLE:
+        return lhs->toDouble().value() == rhs->toDouble().value();
+    case value::Value::STRING:
+        return lhs->toString().value() == rhs->toString().value();
+    case value::Value::XMLTYPE:
+        return lhs->toXml().value() == rhs->toXml().value();
+    case value::Value::SET: {
+        const auto& a = lhs->toSet();
+        const auto& b = rhs->toSet();
+        if (a.size() != b.size())
+            return false;
+        for (std::size_t i = 0; i != a.size(); ++i)
+            if (not equal_values(a.get(i).get(), b.get(i).get()))
+                return false;
+        return true;
+    }
+    case value::Value::MAP: {
+        const auto& a = lhs->toMap();
+        const auto& b = rhs->toMap();
+        if (a.size() != b.size())
+            return false;
+        for (const auto& elem : a) {
+            auto it = b.find(elem.first);
+            if (it == b.end() or
+                not equal_values(elem.second.get(), it->second.get()))
+                return false;
+        }
+        return true;
+    }
+    case value::Value::TUPLE:
+        return lhs->toTuple().value() == rhs->toTuple().value();
+    case value::Value::TABLE:
+        return lhs->toTable().width() == rhs->toTable().width() and
+               lhs->toTable().height() == rhs->toTable().height() and
+               lhs->toTable().value() == rhs->toTable().value();
+    case value::Value::MATRIX: {
+        const auto& a = lhs->toMatrix();
+        const auto& b = rhs->toMatrix();
+        if (a.columns() != b.columns() or a.rows() != b.rows() or
+            a.columns_max() != b.columns_max() or
+            a.rows_max() != b.rows_max())
+            return false;
+        for (std::size_t r = 0; r != a.rows(); ++r)
+            for (std::size_t c = 0; c != a.columns(); ++c)
+                if (not equal_values(a.get(c, r).get(), b.get(c, r).get()))
+                    return false;
+        return true;
+    }
+    case value::Value::NIL:
+        return true;
+    case value::Value::USER:
+        return false;
+    }
+
+    return false;
+}
+
+std::unique_ptr<value::Map>
+build_binary_value()
+{
+    auto mp = std::unique_ptr<value::Map>(new value::Map());
+
+    mp->addBoolean("boolean", true);
+    mp->addInt("integer", -1234);
+    mp->addDouble("double", 0.1);
+    mp->addDouble("max", std::numeric_limits<double>::max());
+    mp->addString("string", std::string("te\0st", 5));
+    mp->addString("empty", "");
+    mp->addXml("xml", "<xml>test</xml>");
+    mp->addNull("null");
+
+    auto& set = mp->addSet("set");
+    set.addInt(1);
+    set.addDouble(-12.34);
+    set.add(std::unique_ptr<value::Value>());
+    set.addMap().addTuple("tuple", 3, 0.25);
+
+    auto& table = mp->addTable("table", 2, 3);
+    for (std::size_t i = 0; i != table.value().size(); ++i)
+        table.value()[i] = i / 3.0;
+
+    mp->add("matrix", value::Matrix::create(2, 2, 4, 4, 1, 1));
+    auto& matrix = mp->getMatrix("matrix");
+    matrix.addInt(0, 0, 1);
+    matrix.addString(1, 1, "cell");
+
+    mp->add("double matrix", value::Matrix::create(3, 2, 3, 2, 1, 1));
+    auto& dmatrix = mp->getMatrix("double matrix");
+    for (std::size_t r = 0; r != 2; ++r)
+        for (std::size_t c = 0; c != 3; ++c)
+            dmatrix.addDouble(c, r, r * 3.0 + c + 0.5);
+
+    mp->add("wide matrix", value::Matrix::create(2, 3, 4, 5, 1, 1));
+    auto& wmatrix = mp->getMatrix("wide matrix");
+    for (std::size_t r = 0; r != 3; ++r)
+        for (std::size_t c = 0; c != 2; ++c)
+            wmatrix.addDouble(c, r, r * 2.0 + c);
+
+    return mp;
+}
+
+void
+test_binary()
+{
+    auto mp = build_binary_value();
+    auto buffer = value::toBinary(*mp);
+    auto read = value::fromBinary(buffer);
+
+    Ensures(read->isMap());
+    Ensures(equal_values(mp.get(), read.get()));
+    EnsuresEqual(read->toMap().getString("string").size(), 5u);
+    EnsuresEqual(read->toMap().getDouble("double"), 0.1);
+
+    std::stringstream ss;
+    value::writeBinary(ss, *mp);
+    value::writeBinary(ss, value::Double(1.5));
+    EnsuresEqual(ss.str().size(), buffer.size() + 9u);
+
+    auto first = value::readBinary(ss);
+    auto second = value::readBinary(ss);
+    Ensures(equal_values(mp.get(), first.get()));
+    EnsuresEqual(second->toDouble().value(), 1.5);
+
+    std::size_t offset = 0;
+    auto all = ss.str();
+    first = value::readBinary(all.data(), all.size(), offset);
+    EnsuresEqual(offset, buffer.size());
+    second = value::readBinary(all.data(), all.size(), offset);
+    EnsuresEqual(offset, all.size());
+    EnsuresEqual(second->toDouble().value(), 1.5);
+
+    EnsuresThrow(value::fromBinary(buffer.substr(0, buffer.size() - 1)),
+                 utils::ArgError);
+    EnsuresThrow(value::fromBinary(buffer + '\0'), utils::ArgError);
+    EnsuresThrow(value::fromBinary(std::string(1, '\xff')), utils::ArgError);
+    EnsuresThrow(value::toBinary(test::MyData(1., 2., 3., "test")),
+                 utils::ArgError);
+
+    /* the sizes of a corrupted buffer whose product overflows */
+    auto put_size = [](std::string& str, std::uint64_t size) {
+        for (int i = 0; i != 8; ++i)
+            str += static_cast<char>((size >> (8 * i)) & 0xff);
+    };
+
+    std::string table(1, '\x08');
+    put_size(table, std::uint64_t(1) << 33);
+    put_size(table, std::uint64_t(1) << 33);
+    EnsuresThrow(value::fromBinary(table), utils::ArgError);
+
+    std::string matrix(1, '\x0b');
+    put_size(matrix, std::uint64_t(1) << 31);
+    put_size(matrix, std::uint64_t(1) << 31);
+    for (int i = 0; i != 4; ++i)
+        put_size(matrix, 1);
+    EnsuresThrow(value::fromBinary(matrix), utils::ArgError);
+
+    /* a capacity smaller than the matrix */
+    const double cell = 1.5;
+    std::string small(1, '\x0b');
+    put_size(small, 2);
+    put_size(small, 1);
+    for (int i = 0; i != 4; ++i)
+        put_size(small, 1);
+    small.append(reinterpret_cast<const char*>(&cell), sizeof(cell));
+    small.append(reinterpret_cast<const char*>(&cell), sizeof(cell));
+    EnsuresThrow(value::fromBinary(small), utils::ArgError);
+
+    /* a huge capacity is not allocated, the matrix is read at its size */
+    std::string huge(1, '\x0b');
+    put_size(huge, 1);
+    put_size(huge, 1);
+    put_size(huge, std::uint64_t(1) << 31);
+    put_size(huge, std::uint64_t(1) << 31);
+    put_size(huge, 1);
+    put_size(huge, 1);
+    huge.append(reinterpret_cast<const char*>(&cell), sizeof(cell));
+    auto bounded = value::fromBinary(huge);
+    EnsuresEqual(bounded->toMatrix().columns_max(), 1u);
+    EnsuresEqual(bounded->toMatrix().rows_max(), 1u);
+    EnsuresEqual(bounded->toMatrix().getDouble(0, 0), 1.5);
+}
+
 int
 main()
 {
@@ -417,6 +688,7 @@ main()
 
     check_simple_value();
     check_map_value();
+    check_map_layout();
     check_set_value();
     check_clone();
     check_null();
@@ -424,6 +696,7 @@ main()
     test_user_value();
     test_tuple();
     test_table();
+    test_binary();
 
     return unit_test::report_errors();
 }
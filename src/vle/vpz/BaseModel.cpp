@@ -43,6 +43,7 @@ BaseModel::BaseModel(const std::string& name, CoupledModel* parent)
   , m_width(-1)
   , m_height(-1)
   , m_name(name)
+  , m_depth(0)
 {
     if (parent) {
         parent->addModel(this);
@@ -58,6 +59,7 @@ BaseModel::BaseModel(const BaseModel& mdl)
   , m_width(mdl.m_width)
   , m_height(mdl.m_height)
   , m_name(mdl.m_name)
+  , m_depth(0)
 {
     std::for_each(mdl.m_inPortList.begin(),
                   mdl.m_inPortList.end(),
@@ -79,6 +81,8 @@ BaseModel::swap(BaseModel& mdl)
     std::swap(m_width, mdl.m_width);
     std::swap(m_height, mdl.m_height);
     std::swap(m_name, mdl.m_name);
+    std::swap(m_parent_name, mdl.m_parent_name);
+    std::swap(m_depth, mdl.m_depth);
 }
 
 void
@@ -96,7 +100,7 @@ BaseModel::getAtomicModelsSource(const std::string& portname,
 
         ModelPortList::iterator it, jt;
         for (it = top->begin(); it != top->end(); ++it) {
-            const std::string& port(it->second);
+            const utils::Symbol& port(it->second);
             BaseModel* mdl(it->first);
 
             if (mdl->isAtomic()) {
@@ -129,7 +133,7 @@ BaseModel::getAtomicModelsTarget(const std::string& portname,
 
         ModelPortList::iterator it, jt;
         for (it = top->begin(); it != top->end(); ++it) {
-            const std::string& port(it->second);
+            const utils::Symbol& port(it->second);
             BaseModel* mdl(it->first);
 
             if (mdl->isAtomic()) {
@@ -177,52 +181,40 @@ BaseModel::rename(BaseModel* mdl, const std::string& newname)
         }
     } else {
         mdl->m_name.assign(newname);
+        mdl->updateHierarchy();
     }
 }
 
-std::string
-BaseModel::getParentName() const
+void
+BaseModel::setParent(CoupledModel* cp)
 {
-    std::list<std::string> lst;
-    CoupledModel* parent = m_parent;
-
-    while (parent) {
-        lst.push_front(parent->getName());
-        parent = parent->getParent();
-    }
+    m_parent = cp;
+    updateHierarchy();
+}
 
-    std::string result;
-    while (not lst.empty()) {
-        result += lst.front();
-        lst.pop_front();
-        if (not lst.empty()) {
-            result += ',';
-        }
+void
+BaseModel::updateHierarchy()
+{
+    if (m_parent) {
+        m_depth = m_parent->getDepth() + 1;
+        m_parent_name = m_parent->getPath();
+    } else {
+        m_depth = 0;
+        m_parent_name = utils::Symbol();
     }
-    return result;
 }
 
 std::string
 BaseModel::getCompleteName() const
 {
-    std::list<const BaseModel*> stack;
-    std::list<const BaseModel *>::iterator it, jt;
-    std::string result;
-
-    stack.push_back(this);
+    if (not m_parent)
+        return m_name;
 
-    while (stack.front()->getParent()) {
-        stack.push_front(stack.front()->getParent());
-    }
-
-    it = stack.begin();
-    while (it != stack.end()) {
-        result += (*it)->getName();
-        jt = it++;
-        if (it != stack.end()) {
-            result += ',';
-        }
-    }
+    std::string result;
+    result.reserve(m_parent_name.str().size() + m_name.size() + 1);
+    result = m_parent_name.str();
+    result += ',';
+    result += m_name;
 
     return result;
 }
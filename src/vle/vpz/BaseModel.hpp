@@ -33,6 +33,7 @@
 #include <set>
 #include <vector>
 #include <vle/DllDefines.hpp>
+#include <vle/utils/Memory.hpp>
 #include <vle/vpz/ModelPortList.hpp>
 
 namespace vle {
@@ -53,6 +54,7 @@ typedef std::map<std::string, BaseModel*> ModelList;
  *
  */
 class VLE_API BaseModel
+  : public utils::MemoryTagged<utils::MemoryTag::vpz>
 {
 public:
     /**
@@ -163,9 +165,26 @@ public:
      * top model,coupled modela
      * @endcode
      *
+     * The string is interned (see utils::Symbol) and shared by all the
+     * models of the same coupled model. It is kept up to date by
+     * setParent() and rename().
+     *
      * @return
      */
-    std::string getParentName() const;
+    const std::string& getParentName() const
+    {
+        return m_parent_name.str();
+    }
+
+    /**
+     * @brief Get the number of coupled model parents, 0 for the top model.
+     * The depth is kept up to date by setParent().
+     * @return The depth of the model in the hierarchy.
+     */
+    int getDepth() const
+    {
+        return m_depth;
+    }
 
     /**
      * @brief Build an std::string from the model's parent names and the
@@ -206,13 +225,11 @@ public:
     }
 
     /**
-     * @brief Set the parent node of this model. Can be null.
+     * @brief Set the parent node of this model. Can be null. The depth and
+     * the parent names of the model and of its sub-models are updated.
      * @param cp The reference to the parent node or null.
      */
-    inline void setParent(CoupledModel* cp)
-    {
-        m_parent = cp;
-    }
+    void setParent(CoupledModel* cp);
 
     /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
      *
@@ -647,6 +664,12 @@ protected:
     void writePort(std::ostream& out) const;
     void writeGraphics(std::ostream& out) const;
 
+    /**
+     * @brief Compute the depth and the parent names from the parent node.
+     * The coupled model updates its sub-models.
+     */
+    virtual void updateHierarchy();
+
 private:
     /**
      * @brief Default constructor, position (0,0) size (0,0) and parent to
@@ -657,6 +680,8 @@ private:
     BaseModel& operator=(const BaseModel& mdl);
 
     std::string m_name;
+    utils::Symbol m_parent_name; ///< Cache of getParentName().
+    int m_depth;                 ///< Cache of getDepth().
 };
 }
 } // namespace vle vpz
@@ -53,33 +53,6 @@ Condition::Condition(const std::string& name)
 {
 }
 
-Condition::Condition(const Condition& cnd)
-  : Base(cnd)
-  , m_name(cnd.m_name)
-  , m_last_port(cnd.m_last_port)
-  , m_ispermanent(cnd.m_ispermanent)
-{
-    for (auto& elem : cnd.m_list) {
-        auto& set = m_list[elem.first];
-
-        for (auto& v : elem.second)
-            set.emplace_back(value::clone(v));
-    }
-}
-
-Condition&
-Condition::operator=(const Condition& cnd)
-{
-    Condition tmp(cnd);
-
-    std::swap(m_list, tmp.m_list);
-    std::swap(m_name, tmp.m_name);
-    std::swap(m_last_port, tmp.m_last_port);
-    std::swap(m_ispermanent, tmp.m_ispermanent);
-
-    return *this;
-}
-
 void
 Condition::write(std::ostream& out) const
 {
@@ -197,10 +170,11 @@ Condition::getSetValues(const std::string& portname)
             .str());
     }
 
+    detach(it->second);
     return it->second;
 }
 
-const std::shared_ptr<value::Value>&
+std::shared_ptr<const value::Value>
 Condition::firstValue(const std::string& portname) const
 {
     const auto& set = getSetValues(portname);
@@ -212,10 +186,10 @@ Condition::firstValue(const std::string& portname) const
     return set[0];
 }
 
-const std::shared_ptr<value::Value>&
+std::shared_ptr<const value::Value>
 Condition::nValue(const std::string& portname, size_t i) const
 {
-    auto& set = getSetValues(portname);
+    const auto& set = getSetValues(portname);
 
     if (set.empty())
         throw utils::ArgError(_("Condition %s have not value"),
@@ -229,6 +203,38 @@ Condition::nValue(const std::string& portname, size_t i) const
     return set[i];
 }
 
+value::Value&
+Condition::valueForWrite(const std::string& portname, size_t i)
+{
+    auto it = m_list.find(portname);
+
+    if (it == m_list.end()) {
+        throw utils::ArgError(
+          (fmt(_("Condition %1% have no port %2%")) % m_name % portname)
+            .str());
+    }
+
+    auto& set = it->second;
+
+    if (set.size() <= i or not set[i])
+        throw utils::ArgError(_("Condition %s have not %lu values"),
+                              portname.c_str(),
+                              utils::numeric_cast<unsigned long>(i + 1));
+
+    if (set[i].use_count() > 1)
+        set[i] = value::clone(set[i]);
+
+    return *set[i];
+}
+
+void
+Condition::shareValues(value::Pool& pool)
+{
+    for (auto& elem : m_list)
+        for (auto& v : elem.second)
+            v = pool.share(std::move(v));
+}
+
 std::vector<std::shared_ptr<value::Value>>&
 Condition::lastAddedPort()
 {
@@ -240,6 +246,7 @@ Condition::lastAddedPort()
             .str());
     }
 
+    detach(it->second);
     return it->second;
 }
 
@@ -249,5 +256,20 @@ Condition::deleteValueSet()
     for (auto& elem : m_list)
         elem.second.clear();
 }
+
+void
+Condition::detach(std::vector<std::shared_ptr<value::Value>>& set)
+{
+    for (auto& v : set)
+        if (v.use_count() > 1)
+            v = value::clone(v);
+}
+
+void
+Condition::detach()
+{
+    for (auto& elem : m_list)
+        detach(elem.second);
+}
 }
 } // namespace vle vpz
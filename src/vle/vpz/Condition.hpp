@@ -32,6 +32,7 @@
 #include <vector>
 #include <vle/DllDefines.hpp>
 #include <vle/value/Map.hpp>
+#include <vle/value/Pool.hpp>
 #include <vle/vpz/Base.hpp>
 
 namespace vle {
@@ -62,15 +63,19 @@ public:
     Condition(const std::string& name);
 
     /**
-     * @brief Copy constructor. All values are cloned.
+     * @brief Copy constructor. Values are not cloned, the copy shares the
+     * values of @e cnd. The const accessors return the shared values, the
+     * non-const accessors first clone the shared values of the returned
+     * ports (copy-on-write) and valueForWrite() clones only one value.
      * @param cnd The Condition to copy.
      */
-    Condition(const Condition& cnd);
+    Condition(const Condition& cnd) = default;
 
     /**
-     * @brief Assignment operator. All values are cloned.
+     * @brief Assignment operator. Values are not cloned, see the copy
+     * constructor.
      */
-    Condition& operator=(const Condition& cnd);
+    Condition& operator=(const Condition& cnd) = default;
 
     /**
      * @brief Delete all the values attached to this Conditon.
@@ -172,7 +177,8 @@ public:
       const std::string& portname) const;
 
     /**
-     * @brief Get the value::Set attached to a port.
+     * @brief Get the value::Set attached to a port. The values of the port
+     * shared with an other Condition are cloned first.
      * @param portname The name of the port.
      * @return A reference to a value::Set.
      * @throw utils::ArgError if portname not exist.
@@ -184,10 +190,10 @@ public:
      * @brief Return a reference to the first value::Value of the specified
      * port.
      * @param portname the name of the port to test.
-     * @return A reference to a value::Value.
+     * @return The shared value::Value, read only.
      * @throw utils::ArgError if portname not exist.
      */
-    const std::shared_ptr<value::Value>& firstValue(
+    std::shared_ptr<const value::Value> firstValue(
       const std::string& portname) const;
 
     /**
@@ -195,16 +201,39 @@ public:
      * port.
      * @param portname the name of the specified port.
      * @param i the value of the port.
-     * @return A reference to a value::Value.
+     * @return The shared value::Value, read only.
      * @throw utils::ArgError if portname not exist or if value list
      * have no nth value.
      */
-    const std::shared_ptr<value::Value>& nValue(const std::string& portname,
-                                                size_t i) const;
+    std::shared_ptr<const value::Value> nValue(const std::string& portname,
+                                               size_t i) const;
+
+    /**
+     * @brief Return a writable reference to the nth value::Value of the
+     * specified port. Values are shared between the copies of a Condition,
+     * the InitEventList of the models and the experimental plans, so the
+     * value is cloned first if it is shared (copy-on-write). Values must
+     * not be modified through the other accessors.
+     * @param portname the name of the specified port.
+     * @param i the index of the value.
+     * @return A reference to a value::Value owned only by this Condition.
+     * @throw utils::ArgError if portname not exist or if value list
+     * have no nth value.
+     */
+    value::Value& valueForWrite(const std::string& portname, size_t i = 0);
+
+    /**
+     * @brief Replace each value of each port by the equal value of the
+     * pool (hash-consing). After this call, the equal values of the
+     * conditions that use the same pool share the same storage.
+     * @param pool the pool of shared values.
+     */
+    void shareValues(value::Pool& pool);
 
     /**
      * @brief Return a reference to the value::Set of the latest added port.
-     * This function is principaly used in Sax parser.
+     * This function is principaly used in Sax parser. The values of the
+     * port shared with an other Condition are cloned first.
      * @return A reference to the value::Set of the port.
      * @throw utils::ArgError if port does not exist.
      */
@@ -232,20 +261,24 @@ public:
     }
 
     /**
-     * @brief Get a reference to the ConditionValues.
-     * @return A constant reference to the ConditionValues.
+     * @brief Get a reference to the ConditionValues. The values shared
+     * with an other Condition are cloned first.
+     * @return A reference to the ConditionValues.
      */
     inline ConditionValues& conditionvalues()
     {
+        detach();
         return m_list;
     }
 
     /**
-     * @brief Get a iterator the begin of the vpz::ConditionValues.
+     * @brief Get a iterator the begin of the vpz::ConditionValues. The
+     * values shared with an other Condition are cloned first.
      * @return Get a iterator the begin of the vpz::ConditionValues.
      */
     iterator begin()
     {
+        detach();
         return m_list.begin();
     }
 
@@ -365,6 +398,17 @@ public:
 private:
     Condition() = delete;
 
+    /**
+     * @brief Clone the values of the port @e set shared with an other
+     * Condition or an InitEventList.
+     */
+    static void detach(std::vector<std::shared_ptr<value::Value>>& set);
+
+    /**
+     * @brief Clone the shared values of all the ports.
+     */
+    void detach();
+
     ConditionValues m_list;  /* list of port, values. */
     std::string m_name;      /* name of the condition. */
     std::string m_last_port; /* latest added port. */
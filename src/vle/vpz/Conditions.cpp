@@ -203,5 +203,14 @@ Conditions::deleteValueSet()
 {
     utils::forEach(m_list.begin(), m_list.end(), Condition::DeleteValueSet());
 }
+
+void
+Conditions::shareValues()
+{
+    value::Pool pool;
+
+    for (auto& elem : m_list)
+        elem.second.shareValues(pool);
+}
 }
 } // namespace vle vpz
@@ -212,6 +212,13 @@ public:
      */
     void deleteValueSet();
 
+    /**
+     * @brief Hash-cons the values of all the conditions: equal values of
+     * any condition and port are replaced by a single shared instance. Use
+     * Condition::valueForWrite to modify a value afterwards.
+     */
+    void shareValues();
+
     /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
      *
      * Get/Set
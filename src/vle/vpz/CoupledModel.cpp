@@ -40,6 +40,7 @@ namespace vpz {
 CoupledModel::CoupledModel(const std::string& name, CoupledModel* parent)
   : BaseModel(name, parent)
 {
+    updatePath();
 }
 
 CoupledModel::CoupledModel(const CoupledModel& mdl)
@@ -50,6 +51,8 @@ CoupledModel::CoupledModel(const CoupledModel& mdl)
 {
     assert(mdl.getModelList().size() == getModelList().size());
 
+    updatePath();
+
     std::for_each(mdl.m_internalInputList.begin(),
                   mdl.m_internalInputList.end(),
                   CopyWithoutConnection(m_internalInputList));
@@ -82,6 +85,7 @@ CoupledModel::operator=(const CoupledModel& mdl)
 {
     CoupledModel m(mdl);
     swap(m);
+    updatePath();
     std::swap(m_internalInputList, m.m_internalInputList);
     std::swap(m_internalOutputList, m.m_internalOutputList);
     return *this;
@@ -299,8 +303,8 @@ CoupledModel::nbInputConnection(const std::string& portsrc,
     return true;
 
     ConnectionList::iterator iter = mdst->getInputPortList().find(portdst);
-    ModelPortList model(iter->second);
-    for (ModelPortList::iterator it = model.begin(); it != model.end(); ++it) {
+    const ModelPortList& model(iter->second);
+    for (auto it = model.begin(); it != model.end(); ++it) {
         if (it->first == this and it->second == portdst) {
             nbConnections++;
         }
@@ -341,8 +345,8 @@ CoupledModel::nbOutputConnection(const std::string& src,
     }
 
     ConnectionList::iterator iter = msrc->getOutputPortList().find(portsrc);
-    ModelPortList model(iter->second);
-    for (ModelPortList::iterator it = model.begin(); it != model.end(); ++it) {
+    const ModelPortList& model(iter->second);
+    for (auto it = model.begin(); it != model.end(); ++it) {
         if (it->first == this and it->second == portdst) {
             nbConnections++;
         }
@@ -385,8 +389,8 @@ CoupledModel::nbInternalConnection(const std::string& src,
     }
 
     ConnectionList::iterator iter = msrc->getOutputPortList().find(portsrc);
-    ModelPortList model(iter->second);
-    for (ModelPortList::iterator it = model.begin(); it != model.end(); ++it) {
+    const ModelPortList& model(iter->second);
+    for (auto it = model.begin(); it != model.end(); ++it) {
         if (it->first == mdst and it->second == portdst) {
             nbConnections++;
         }
@@ -757,6 +761,25 @@ CoupledModel::getModel(const std::string& name) const
     return (it == m_modelList.end()) ? 0 : it->second;
 }
 
+void
+CoupledModel::updateHierarchy()
+{
+    BaseModel::updateHierarchy();
+    updatePath();
+
+    for (auto& elem : m_modelList)
+        elem.second->setParent(this);
+}
+
+void
+CoupledModel::updatePath()
+{
+    if (getParent())
+        m_path = utils::Symbol(getParentName() + ',' + getName());
+    else
+        m_path = utils::Symbol(getName());
+}
+
 void
 CoupledModel::addModel(BaseModel* model)
 {
@@ -834,6 +834,22 @@ public:
     virtual void purgeConditions(
       const std::set<std::string>& conditionlist) override;
 
+    /**
+     * @brief Get the interned complete name of the coupled model, the
+     * parent name of its sub-models.
+     */
+    const utils::Symbol& getPath() const
+    {
+        return m_path;
+    }
+
+protected:
+    /**
+     * @brief Update the depth and the parent names of the coupled model
+     * and of all its sub-models.
+     */
+    void updateHierarchy() override;
+
 private:
     void delConnection(BaseModel* src,
                        const std::string& portSrc,
@@ -883,6 +899,9 @@ private:
     ModelList m_modelList;
     ConnectionList m_internalInputList;
     ConnectionList m_internalOutputList;
+    utils::Symbol m_path; ///< Cache of getPath().
+
+    void updatePath();
 
     /* Connections */
     std::vector<BaseModel*> m_srcConnections;
@@ -27,6 +27,7 @@
 #include <vle/utils/Exception.hpp>
 #include <vle/utils/i18n.hpp>
 #include <vle/value/Double.hpp>
+#include <vle/value/Integer.hpp>
 #include <vle/value/Set.hpp>
 #include <vle/vpz/Experiment.hpp>
 
@@ -151,6 +152,88 @@ Experiment::begin() const
     return dur[0]->toDouble().value();
 }
 
+void
+Experiment::setTick(double tick)
+{
+    if (tick < 0.0)
+        throw utils::ArgError(
+          (fmt(_("Negative tick of the time base (%1%)")) % tick).str());
+
+    if (not conditions().exist(defaultSimulationEngineCondName()))
+        throw utils::ArgError(_("The simulation engine condition"
+                                "does not exist"));
+
+    auto& condSim = conditions().get(defaultSimulationEngineCondName());
+    condSim.setValueToPort("tick", value::Double::create(tick));
+}
+
+double
+Experiment::tick() const
+{
+    if (not conditions().exist(defaultSimulationEngineCondName()))
+        return 0.0;
+
+    const auto& condSim = conditions().get(defaultSimulationEngineCondName());
+    const auto it = condSim.conditionvalues().find("tick");
+
+    if (it == condSim.conditionvalues().end() or it->second.empty())
+        return 0.0;
+
+    return it->second[0]->toDouble().value();
+}
+
+void
+Experiment::setSeed(std::uint32_t seed)
+{
+    if (not conditions().exist(defaultSimulationEngineCondName()))
+        throw utils::ArgError(_("The simulation engine condition"
+                                "does not exist"));
+
+    auto& condSim = conditions().get(defaultSimulationEngineCondName());
+    condSim.setValueToPort("seed", value::Integer::create(seed));
+}
+
+std::uint32_t
+Experiment::seed() const
+{
+    if (not conditions().exist(defaultSimulationEngineCondName()))
+        return 0;
+
+    const auto& condSim = conditions().get(defaultSimulationEngineCondName());
+    const auto it = condSim.conditionvalues().find("seed");
+
+    if (it == condSim.conditionvalues().end() or it->second.empty())
+        return 0;
+
+    return static_cast<std::uint32_t>(it->second[0]->toInteger().value());
+}
+
+void
+Experiment::setReplicate(std::uint32_t replicate)
+{
+    if (not conditions().exist(defaultSimulationEngineCondName()))
+        throw utils::ArgError(_("The simulation engine condition"
+                                "does not exist"));
+
+    auto& condSim = conditions().get(defaultSimulationEngineCondName());
+    condSim.setValueToPort("replicate", value::Integer::create(replicate));
+}
+
+std::uint32_t
+Experiment::replicate() const
+{
+    if (not conditions().exist(defaultSimulationEngineCondName()))
+        return 0;
+
+    const auto& condSim = conditions().get(defaultSimulationEngineCondName());
+    const auto it = condSim.conditionvalues().find("replicate");
+
+    if (it == condSim.conditionvalues().end() or it->second.empty())
+        return 0;
+
+    return static_cast<std::uint32_t>(it->second[0]->toInteger().value());
+}
+
 void
 Experiment::cleanNoPermanent()
 {
@@ -27,6 +27,7 @@
 #ifndef VLE_VPZ_EXPERIMENT_HPP
 #define VLE_VPZ_EXPERIMENT_HPP
 
+#include <cstdint>
 #include <vle/DllDefines.hpp>
 #include <vle/vpz/Base.hpp>
 #include <vle/vpz/Conditions.hpp>
@@ -191,6 +192,51 @@ public:
      */
     double begin() const;
 
+    /**
+     * @brief Use an integer time base for the simulation: the dates of the
+     * scheduler are rounded to the nearest multiple of @e tick (the @e tick
+     * port of the simulation engine condition).
+     * @param tick The resolution of the time base, 0 to use the floating
+     * point dates.
+     * @throw utils::ArgError if tick is < 0.
+     */
+    void setTick(double tick);
+
+    /**
+     * @brief Get the resolution of the integer time base of the simulation.
+     * @return 0 if the simulation uses the floating point dates.
+     */
+    double tick() const;
+
+    /**
+     * @brief Set the seed of the random number generators of the models
+     * (the @e seed port of the simulation engine condition, see
+     * devs::Dynamics::buildRand()).
+     * @param seed The seed shared by all the models.
+     */
+    void setSeed(std::uint32_t seed);
+
+    /**
+     * @brief Get the seed of the random number generators of the models.
+     * @return 0 if the simulation engine condition has no seed.
+     */
+    std::uint32_t seed() const;
+
+    /**
+     * @brief Set the index of the replicate of the simulation (the @e
+     * replicate port of the simulation engine condition). The manager
+     * assigns the index of the combination of the experimental frame to
+     * the simulations without replicate.
+     * @param replicate The index of the replicate.
+     */
+    void setReplicate(std::uint32_t replicate);
+
+    /**
+     * @brief Get the index of the replicate of the simulation.
+     * @return 0 if the simulation engine condition has no replicate.
+     */
+    std::uint32_t replicate() const;
+
     /**
      * @brief Set the experimental design combination.
      * @param name The new name of experimental design combination.
@@ -24,6 +24,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <vle/utils/Exception.hpp>
 #include <vle/utils/i18n.hpp>
 #include <vle/vpz/BaseModel.hpp>
@@ -36,8 +37,39 @@ ModelPortList::~ModelPortList()
 {
 }
 
+namespace {
+
+struct ModelCompare
+{
+    bool operator()(const ModelPortList::value_type& lhs,
+                    const BaseModel* rhs) const
+    {
+        return lhs.first < rhs;
+    }
+
+    bool operator()(const BaseModel* lhs,
+                    const ModelPortList::value_type& rhs) const
+    {
+        return lhs < rhs.first;
+    }
+};
+
+} // anonymous namespace
+
+std::pair<ModelPortList::iterator, ModelPortList::iterator>
+ModelPortList::equal_range(const BaseModel* model)
+{
+    return std::equal_range(m_lst.begin(), m_lst.end(), model, ModelCompare());
+}
+
+std::pair<ModelPortList::const_iterator, ModelPortList::const_iterator>
+ModelPortList::equal_range(const BaseModel* model) const
+{
+    return std::equal_range(m_lst.begin(), m_lst.end(), model, ModelCompare());
+}
+
 void
-ModelPortList::add(BaseModel* model, const std::string& portname)
+ModelPortList::add(BaseModel* model, const utils::Symbol& portname)
 {
     if (not model) {
         throw utils::DevsGraphError(
@@ -45,7 +77,17 @@ ModelPortList::add(BaseModel* model, const std::string& portname)
             .str());
     }
 
-    m_lst.insert(value_type(model, portname));
+    //
+    // The models are often connected in the order of their allocation, so
+    // the connection is appended to the vector in most cases.
+    //
+    if (m_lst.empty() or not(model < m_lst.back().first))
+        m_lst.emplace_back(model, portname);
+    else
+        m_lst.emplace(
+          std::upper_bound(m_lst.begin(), m_lst.end(), model, ModelCompare()),
+          model,
+          portname);
 }
 
 void
@@ -57,52 +99,40 @@ ModelPortList::remove(BaseModel* model, const std::string& portname)
             .str());
     }
 
-    std::pair<iterator, iterator> its = m_lst.equal_range(model);
-    auto it = its.first;
-    auto previous = its.first;
+    auto its = equal_range(model);
+    m_lst.erase(std::remove_if(its.first,
+                               its.second,
+                               [&portname](const value_type& elem) {
+                                   return elem.second == portname;
+                               }),
+                its.second);
+}
 
-    while (it != its.second) {
-        if (it->second == portname) {
-            if (it == previous) {
-                it++;
-                m_lst.erase(previous);
-                previous = it;
-            } else {
-                m_lst.erase(it);
-                it = previous;
-            }
-        } else {
-            previous = it;
-            it++;
-        }
-    }
+void
+ModelPortList::erase(BaseModel* model)
+{
+    auto its = equal_range(model);
+    m_lst.erase(its.first, its.second);
 }
 
 void
 ModelPortList::merge(ModelPortList& lst)
 {
     for (auto& elem : lst) {
-        m_lst.insert(value_type(elem.first, elem.second));
+        add(elem.first, elem.second);
     }
 }
 
 bool
 ModelPortList::exist(BaseModel* model, const std::string& portname) const
 {
-    std::pair<const_iterator, const_iterator> its(m_lst.equal_range(model));
-    for (auto it = its.first; it != its.second; ++it) {
-        if (it->second == portname) {
-            return true;
-        }
-    }
-    return false;
+    return exist(static_cast<const BaseModel*>(model), portname);
 }
 
 bool
 ModelPortList::exist(const BaseModel* model, const std::string& portname) const
 {
-    std::pair<const_iterator, const_iterator> its;
-    its = m_lst.equal_range(const_cast<BaseModel*>(model));
+    auto its = equal_range(model);
     for (auto it = its.first; it != its.second; ++it) {
         if (it->second == portname) {
             return true;
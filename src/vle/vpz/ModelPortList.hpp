@@ -27,19 +27,29 @@
 #ifndef VLE_GRAPH_MODELPORTLIST_HPP
 #define VLE_GRAPH_MODELPORTLIST_HPP
 
-#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 #include <vle/DllDefines.hpp>
+#include <vle/utils/Symbol.hpp>
 
 namespace vle {
 namespace vpz {
 
 class BaseModel;
 
+/**
+ * @brief The (model, port) at the other end of the connections of a port.
+ *
+ * The connections are stored in a flat std::vector sorted by model, the
+ * connections to the same model are kept in the order of insertion (the
+ * order of the std::multimap used before). A connection costs two
+ * pointers and the connections of a port are contiguous in memory.
+ */
 class VLE_API ModelPortList
 {
 public:
-    typedef std::multimap<BaseModel*, std::string> Values;
+    typedef std::vector<std::pair<BaseModel*, utils::Symbol>> Values;
     typedef Values::iterator iterator;
     typedef Values::const_iterator const_iterator;
     typedef Values::size_type size_type;
@@ -58,7 +68,7 @@ public:
      * @param model The model to add.
      * @param portname The port of the model to add.
      */
-    void add(BaseModel* model, const std::string& portname);
+    void add(BaseModel* model, const utils::Symbol& portname);
 
     /**
      * @brief Remove a ModelPort from the vector. Linear complexity.
@@ -73,10 +83,7 @@ public:
      *
      * @param model Model to be removed.
      */
-    void erase(BaseModel* model)
-    {
-        m_lst.erase(model);
-    }
+    void erase(BaseModel* model);
 
     /**
      * @brief Remove all ModelPort from the vector. Linear
@@ -97,7 +104,7 @@ public:
 
     /**
      * @brief Check if a ModelPort already exist in the vector.
-     * Linear complexity.
+     * Logarithmic complexity.
      *
      * @param model The model to check.
      * @param portname The port of the model to check.
@@ -109,7 +116,7 @@ public:
 
     /**
      * @brief Check if a ModelPort already exist in the vector.
-     * Linear complexity.
+     * Logarithmic complexity.
      *
      * @param model The model to check.
      * @param portname The port of the model to check.
@@ -140,8 +147,21 @@ public:
         return m_lst.size();
     }
 
+    /**
+     * @brief Get the connections to the model @e model.
+     *
+     * @param model The model to search.
+     *
+     * @return Two iterators, the range of the connections to @e model.
+     * Logarithmic complexity.
+     */
+    std::pair<const_iterator, const_iterator> equal_range(
+      const BaseModel* model) const;
+
 private:
     Values m_lst;
+
+    std::pair<iterator, iterator> equal_range(const BaseModel* model);
 };
 
 std::ostream& operator<<(std::ostream& out, const ModelPortList& lst);
@@ -35,6 +35,8 @@
 #include <libxml/parser.h>
 #include <libxml/xpath.h>
 #include <sstream>
+#include <string>
+#include <vector>
 #include <vle/utils/Exception.hpp>
 #include <vle/utils/Tools.hpp>
 #include <vle/utils/i18n.hpp>
@@ -196,8 +198,8 @@ SaxParser::parse(std::istream& is, std::size_t size)
     sax.initialized = XML_SAX2_MAGIC;
     sax.startDocument = &SaxParser::onStartDocument;
     sax.endDocument = &SaxParser::onEndDocument;
-    sax.startElement = &SaxParser::onStartElement;
-    sax.endElement = &SaxParser::onEndElement;
+    sax.startElementNs = &SaxParser::onStartElementNs;
+    sax.endElementNs = &SaxParser::onEndElementNs;
     sax.characters = &SaxParser::onCharacters;
     sax.cdataBlock = &SaxParser::onCDataBlock;
     sax.warning = &SaxParser::onWarning;
@@ -213,6 +215,10 @@ SaxParser::parse(std::istream& is, std::size_t size)
       xmlCreatePushParserCtxt(&sax, this, buffer.data(), is.gcount(), nullptr);
     m_ctxt = static_cast<void*>(ctx);
 
+    // Without entity substitution, libxml2 writes each '&' of an attribute
+    // value as "&#38;" in the SAX2 callbacks.
+    xmlCtxtUseOptions(ctx, XML_PARSE_NOENT | XML_PARSE_NONET);
+
     scope_exit se([this, ctx]() {
         xmlFreeParserCtxt(ctx);
         m_ctxt = nullptr;
@@ -342,6 +348,46 @@ SaxParser::onEndElement(void* ctx, const xmlChar* name)
     }
 }
 
+void
+SaxParser::onStartElementNs(void* ctx,
+                            const xmlChar* localname,
+                            const xmlChar* /*prefix*/,
+                            const xmlChar* /*URI*/,
+                            int /*nb_namespaces*/,
+                            const xmlChar** /*namespaces*/,
+                            int nb_attributes,
+                            int /*nb_defaulted*/,
+                            const xmlChar** attributes)
+{
+    //
+    // The SAX2 attributes are (localname, prefix, URI, value, end) where
+    // the value is not null-terminated. They are copied into the
+    // null-terminated (name, value) array of the SAX1 handler.
+    //
+    std::vector<std::string> values(nb_attributes);
+    std::vector<const xmlChar*> atts(nb_attributes * 2 + 1, nullptr);
+
+    for (int i = 0; i != nb_attributes; ++i) {
+        const xmlChar** attribute = attributes + i * 5;
+
+        values[i].assign((const char*)attribute[3],
+                         (const char*)attribute[4]);
+        atts[i * 2] = attribute[0];
+        atts[i * 2 + 1] = (const xmlChar*)values[i].c_str();
+    }
+
+    onStartElement(ctx, localname, atts.data());
+}
+
+void
+SaxParser::onEndElementNs(void* ctx,
+                          const xmlChar* localname,
+                          const xmlChar* /*prefix*/,
+                          const xmlChar* /*URI*/)
+{
+    onEndElement(ctx, localname);
+}
+
 void
 SaxParser::onCharacters(void* ctx, const xmlChar* ch, int len)
 {
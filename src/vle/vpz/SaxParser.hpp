@@ -149,6 +149,21 @@ public:
 
     static void onEndElement(void* ctx, const xmlChar* att);
 
+    static void onStartElementNs(void* ctx,
+                                 const xmlChar* localname,
+                                 const xmlChar* prefix,
+                                 const xmlChar* URI,
+                                 int nb_namespaces,
+                                 const xmlChar** namespaces,
+                                 int nb_attributes,
+                                 int nb_defaulted,
+                                 const xmlChar** attributes);
+
+    static void onEndElementNs(void* ctx,
+                               const xmlChar* localname,
+                               const xmlChar* prefix,
+                               const xmlChar* URI);
+
     static void onCharacters(void* ctx, const xmlChar* ch, int len);
 
     static void onCDataBlock(void* ctx, const xmlChar* value, int len);
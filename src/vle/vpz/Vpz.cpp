@@ -29,6 +29,7 @@
 #include <limits>
 #include <sstream>
 #include <vle/utils/Exception.hpp>
+#include <vle/utils/Trace.hpp>
 #include <vle/utils/i18n.hpp>
 #include <vle/value/Double.hpp>
 #include <vle/vle.hpp>
@@ -68,6 +69,8 @@ Vpz::write(std::ostream& out) const
 void
 Vpz::parseFile(const std::string& filename)
 {
+    vle_trace_scope("vpz", "parse");
+
     clear();
     project().experiment().conditions().deleteValueSet();
     m_filename.assign(filename);
@@ -87,6 +90,8 @@ Vpz::parseFile(const std::string& filename)
 void
 Vpz::parseMemory(const std::string& buffer)
 {
+    vle_trace_scope("vpz", "parse");
+
     clear();
     project().experiment().conditions().deleteValueSet();
     m_filename.clear();
@@ -606,6 +606,24 @@ value_matrix_of_matrix_io()
     EnsuresEqual(value::toInteger(m3(2, 0)), 9);
 }
 
+void
+value_map_attributes()
+{
+    const char* t1 = "<?xml version=\"1.0\"?>\n"
+                     "<map>"
+                     "<key name=\"a&amp;b\"><integer>1</integer></key>"
+                     "<key name='c&lt;d' ><integer>2</integer></key>"
+                     "<key name=\"\"><integer>3</integer></key>"
+                     "</map>";
+
+    auto v = vpz::Vpz::parseValue(t1);
+    const auto& map = v->toMap();
+    EnsuresEqual(map.size(), 3u);
+    EnsuresEqual(map.getInt("a&b"), 1);
+    EnsuresEqual(map.getInt("c<d"), 2);
+    EnsuresEqual(map.getInt(""), 3);
+}
+
 int
 main()
 {
@@ -617,6 +635,7 @@ main()
     value_string();
     value_set();
     value_map();
+    value_map_attributes();
     value_tuple();
     value_table();
     value_table_map();
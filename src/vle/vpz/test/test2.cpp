@@ -29,6 +29,7 @@
 #include <iostream>
 #include <limits>
 #include <stdexcept>
+#include <vle/utils/Exception.hpp>
 #include <vle/utils/unit-test.hpp>
 #include <vle/value/Double.hpp>
 #include <vle/value/Integer.hpp>
@@ -306,6 +307,74 @@ experiment_vpz()
     }
 }
 
+void
+experiment_shared_values()
+{
+    vpz::Conditions cnds;
+    vpz::Condition cnd1("cond1");
+    vpz::Condition cnd2("cond2");
+
+    cnd1.addValueToPort("x", value::Double::create(1.0));
+    cnd1.addValueToPort("y", value::String::create("a"));
+    cnd2.addValueToPort("x", value::Double::create(1.0));
+    cnd2.addValueToPort("z", value::Double::create(2.0));
+    cnds.add(cnd1);
+    cnds.add(cnd2);
+
+    {
+        vpz::Conditions copy(cnds);
+        Ensures(copy.get("cond1").firstValue("x") ==
+                cnds.get("cond1").firstValue("x"));
+
+        value::Value& x = copy.get("cond1").valueForWrite("x");
+        x.toDouble().set(3.0);
+        EnsuresEqual(copy.get("cond1").firstValue("x")->toDouble().value(),
+                     3.0);
+        EnsuresEqual(cnds.get("cond1").firstValue("x")->toDouble().value(),
+                     1.0);
+    }
+
+    Ensures(cnds.get("cond1").firstValue("x") !=
+            cnds.get("cond2").firstValue("x"));
+
+    cnds.shareValues();
+
+    Ensures(cnds.get("cond1").firstValue("x") ==
+            cnds.get("cond2").firstValue("x"));
+    Ensures(cnds.get("cond1").firstValue("x") !=
+            cnds.get("cond2").firstValue("z"));
+    EnsuresEqual(cnds.get("cond1").firstValue("y")->toString().value(), "a");
+
+    {
+        auto shared = cnds.get("cond2").firstValue("x");
+        cnds.get("cond1").valueForWrite("x").toDouble().set(4.0);
+        EnsuresEqual(shared->toDouble().value(), 1.0);
+        EnsuresEqual(cnds.get("cond1").firstValue("x")->toDouble().value(),
+                     4.0);
+    }
+
+    EnsuresThrow(cnds.get("cond1").valueForWrite("x", 1), utils::ArgError);
+
+    /* the non-const accessors of a copy do not modify the shared values */
+    {
+        vpz::Conditions copy(cnds);
+        auto& set = copy.get("cond2").getSetValues("x");
+        Ensures(set[0] != cnds.get("cond2").firstValue("x"));
+        set[0]->toDouble().set(5.0);
+
+        for (auto& port : copy.get("cond2"))
+            for (auto& value : port.second)
+                value->toDouble().set(6.0);
+
+        EnsuresEqual(cnds.get("cond2").firstValue("x")->toDouble().value(),
+                     1.0);
+        EnsuresEqual(cnds.get("cond2").firstValue("z")->toDouble().value(),
+                     2.0);
+        EnsuresEqual(copy.get("cond2").firstValue("z")->toDouble().value(),
+                     6.0);
+    }
+}
+
 void
 experiment_measures_vpz()
 {
@@ -436,6 +505,7 @@ main()
     coupledmodel_vpz();
     dynamic_vpz();
     experiment_vpz();
+    experiment_shared_values();
     experiment_measures_vpz();
 
     return unit_test::report_errors();
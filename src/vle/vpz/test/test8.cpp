@@ -24,10 +24,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
 #include <fstream>
 #include <limits>
 #include <stdexcept>
+#include <string>
+#include <vector>
 #include <vle/utils/Context.hpp>
 #include <vle/utils/Exception.hpp>
 #include <vle/utils/unit-test.hpp>
@@ -129,6 +132,49 @@ test_del_all_connection()
     delete top;
 }
 
+void
+test_model_port_list()
+{
+    CoupledModel* top = new CoupledModel("top", nullptr);
+    AtomicModel* a(top->addAtomicModel("a"));
+    AtomicModel* b(top->addAtomicModel("b"));
+    BaseModel* first = std::min<BaseModel*>(a, b);
+    BaseModel* second = std::max<BaseModel*>(a, b);
+
+    ModelPortList lst;
+    lst.add(second, "in1");
+    lst.add(first, "in1");
+    lst.add(second, "in2");
+    lst.add(first, "in2");
+    lst.add(second, "in1");
+    EnsuresEqual(lst.size(), 5u);
+
+    std::vector<std::string> ports;
+    for (const auto& elem : lst)
+        ports.emplace_back(elem.second.str() +
+                           (elem.first == first ? "-first" : "-second"));
+    EnsuresEqual(ports[0], "in1-first");
+    EnsuresEqual(ports[1], "in2-first");
+    EnsuresEqual(ports[2], "in1-second");
+    EnsuresEqual(ports[3], "in2-second");
+    EnsuresEqual(ports[4], "in1-second");
+
+    Ensures(lst.exist(second, "in2"));
+    Ensures(not lst.exist(second, "in3"));
+
+    lst.remove(second, "in1");
+    EnsuresEqual(lst.size(), 3u);
+    Ensures(not lst.exist(second, "in1"));
+    Ensures(lst.exist(second, "in2"));
+
+    lst.erase(first);
+    EnsuresEqual(lst.size(), 1u);
+    Ensures(not lst.exist(first, "in1"));
+    Ensures(lst.exist(second, "in2"));
+
+    delete top;
+}
+
 void
 test_have_connection()
 {
@@ -849,6 +895,50 @@ test_name()
 
     EnsuresEqual(a->getCompleteName(), "top,top2,g");
     EnsuresEqual(b->getCompleteName(), "top,top1,x");
+    EnsuresEqual(a->getParentName(), "top,top2");
+    EnsuresEqual(a->getDepth(), 2);
+}
+
+void
+test_hierarchy()
+{
+    CoupledModel* top = new CoupledModel("top", nullptr);
+    CoupledModel* c1(top->addCoupledModel("c1"));
+    AtomicModel* a(c1->addAtomicModel("a"));
+
+    EnsuresEqual(top->getDepth(), 0);
+    EnsuresEqual(top->getParentName(), "");
+    EnsuresEqual(a->getDepth(), 2);
+    EnsuresEqual(a->getParentName(), "top,c1");
+    EnsuresEqual(a->getCompleteName(), "top,c1,a");
+
+    AtomicModel* b(c1->addAtomicModel("b"));
+    Ensures(&a->getParentName() == &b->getParentName());
+    Ensures(c1->getPath() == utils::Symbol("top,c1"));
+
+    BaseModel::rename(c1, "d1");
+    EnsuresEqual(a->getParentName(), "top,d1");
+
+    BaseModel::rename(top, "root");
+    EnsuresEqual(a->getCompleteName(), "root,d1,a");
+
+    CoupledModel* newtop = new CoupledModel("newtop", nullptr);
+    ModelList lst;
+    lst["a"] = a;
+    c1->displace(lst, newtop);
+    EnsuresEqual(a->getDepth(), 1);
+    EnsuresEqual(a->getParentName(), "newtop");
+
+    newtop->detachModel(a);
+    EnsuresEqual(a->getDepth(), 0);
+    EnsuresEqual(a->getCompleteName(), "a");
+
+    c1->attachModel(a);
+    EnsuresEqual(a->getDepth(), 2);
+    EnsuresEqual(a->getCompleteName(), "root,d1,a");
+
+    delete top;
+    delete newtop;
 }
 
 int
@@ -859,6 +949,7 @@ main()
     test_rename_model();
     test_findModelFromPath();
     test_del_all_connection();
+    test_model_port_list();
     test_have_connection();
     test_displace();
     test_complex_displace();
@@ -875,6 +966,7 @@ main()
     test_atomic_model_source_2();
     test_atomic_model_source_3();
     test_name();
+    test_hierarchy();
 
     return unit_test::report_errors();
 }
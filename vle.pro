@@ -35,7 +35,7 @@ SUBDIRS += pkg_vle_generic_builder
 pkg_vle_generic_builder.file = src/pkgs/vle.generic.builder/vle_generic_builder.pro
 pkg_vle_generic_builder.depends = libvle
 
-SUBDIRS += pkg_vle_adapative_qss_adder pkg_vle_adapative_qss_constant pkg_vle_adapative_qss_generator pkg_vle_adapative_qss_adaptative-quantifier pkg_vle_adapative_qss_integrator pkg_vle_adapative_qss_mult pkg_vle_adapative_qss_plot
+SUBDIRS += pkg_vle_adapative_qss_adder pkg_vle_adapative_qss_constant pkg_vle_adapative_qss_generator pkg_vle_adapative_qss_adaptative-quantifier pkg_vle_adapative_qss_integrator pkg_vle_adapative_qss_mult pkg_vle_adapative_qss_plot pkg_vle_adapative_qss_qss-system
 
 pkg_vle_adapative_qss_adder.file = src/pkgs/vle.adaptative-qss/vle_adaptative_qss_adder.pro
 pkg_vle_adapative_qss_constant.file = src/pkgs/vle.adaptative-qss/vle_adaptative_qss_constant.pro
@@ -44,6 +44,7 @@ pkg_vle_adapative_qss_adaptative-quantifier.file = src/pkgs/vle.adaptative-qss/v
 pkg_vle_adapative_qss_integrator.file = src/pkgs/vle.adaptative-qss/vle_adaptative_qss_integrator.pro
 pkg_vle_adapative_qss_mult.file = src/pkgs/vle.adaptative-qss/vle_adaptative_qss_mult.pro
 pkg_vle_adapative_qss_plot.file = src/pkgs/vle.adaptative-qss/vle_adaptative_qss_plot.pro
+pkg_vle_adapative_qss_qss-system.file = src/pkgs/vle.adaptative-qss/vle_adaptative_qss_qss-system.pro
 
 pkg_vle_adapative_qss_adder.depends = libvle
 pkg_vle_adapative_qss_constant.depends = libvle
@@ -52,6 +53,7 @@ pkg_vle_adapative_qss_adaptative-quantifier.depends = libvle
 pkg_vle_adapative_qss_integrator.depends = libvle
 pkg_vle_adapative_qss_mult.depends = libvle
 pkg_vle_adapative_qss_plot.depends = libvle
+pkg_vle_adapative_qss_qss-system.depends = libvle
 
 SUBDIRS += pkg_gvle_datecondition pkg_gvle_default_cpp_panel pkg_gvle_default_data_panel pkg_gvle_default_out_panel pkg_gvle_default_simsub_panel pkg_gvle_default_vpz_panel
 